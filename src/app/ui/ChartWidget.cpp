@@ -5,6 +5,7 @@
 #include <QWheelEvent>
 #include <QKeyEvent>
 #include <QMouseEvent>
+#include <QTimer>
 #include <algorithm>
 #include <cmath>
 
@@ -139,7 +140,9 @@ void ChartWidget::setupChart() {
   chart_ = new QChart();
   chart_->legend()->setVisible(true);
   chart_->legend()->setAlignment(Qt::AlignBottom);
-  chart_->setAnimationOptions(QChart::SeriesAnimations);
+  // No series animations: the series are replace()d with a fresh level of
+  // detail on every refresh, which would otherwise re-animate each frame.
+  chart_->setAnimationOptions(QChart::NoAnimation);
   
   // Modern styling
   chart_->setBackgroundBrush(QBrush(QColor(250, 250, 250)));
@@ -160,6 +163,12 @@ void ChartWidget::setupChart() {
   
   chart_->addAxis(axisX_, Qt::AlignBottom);
   chart_->addAxis(axisY_, Qt::AlignLeft);
+
+  // Any change of the visible x-range or plot width needs a new level of
+  // detail: zoom (wheel, rubber band, buttons), panning and live scrolling
+  // all end up here.
+  connect(axisX_, &QValueAxis::rangeChanged, this, [this]() { scheduleRefresh(); });
+  connect(chart_, &QChart::plotAreaChanged, this, [this]() { scheduleRefresh(); });
 }
 
 void ChartWidget::setupSeries() {
@@ -277,7 +286,6 @@ QLineSeries *copyAsBaseline(QLineSeries *src, const QString &suffix) {
   auto *copy = new QLineSeries();
   copy->setName(src->name() + suffix);
   copy->setPen(baselinePen(src->pen().color()));
-  copy->replace(src->points());
   return copy;
 }
 }  // namespace
@@ -285,8 +293,9 @@ QLineSeries *copyAsBaseline(QLineSeries *src, const QString &suffix) {
 void ChartWidget::captureBaseline() {
   clearBaseline();
 
-  auto attach = [&](QLineSeries *s, QValueAxis *yAx) {
-    if (!s || s->count() == 0) return static_cast<QLineSeries*>(nullptr);
+  // The full history is copied; the drawn points come from refreshVisible().
+  auto attach = [&](QLineSeries *s, const hx::DecimatedSeries &data, QValueAxis *yAx) {
+    if (!s || data.empty()) return static_cast<QLineSeries*>(nullptr);
     auto *b = copyAsBaseline(s, " (baseline)");
     chart_->addSeries(b);
     b->attachAxis(axisX_);
@@ -294,11 +303,13 @@ void ChartWidget::captureBaseline() {
     return b;
   };
 
-  baseline1_ = attach(series1_, axisY_);
-  baseline2_ = attach(series2_, axisY_);
-  baseline3_ = attach(series3_, type_ == PID_CONTROL && axisY2_ ? axisY2_ : axisY_);
+  baseline1_ = attach(series1_, data_[0], axisY_);
+  baseline2_ = attach(series2_, data_[1], axisY_);
+  baseline3_ = attach(series3_, data_[2], type_ == PID_CONTROL && axisY2_ ? axisY2_ : axisY_);
+  for (size_t k = 0; k < 3; ++k) baselineData_[k] = data_[k];
 
   hasBaseline_ = (baseline1_ || baseline2_ || baseline3_);
+  refreshVisible();
 }
 
 void ChartWidget::clearBaseline() {
@@ -311,10 +322,12 @@ void ChartWidget::clearBaseline() {
   drop(baseline1_);
   drop(baseline2_);
   drop(baseline3_);
+  for (hx::DecimatedSeries &d : baselineData_) d.clear();
   hasBaseline_ = false;
 }
 
 void ChartWidget::clear() {
+  for (hx::DecimatedSeries &d : data_) d.clear();
   series1_->clear();
   if (series2_) series2_->clear();
   if (series3_) series3_->clear();
@@ -339,53 +352,94 @@ void ChartWidget::clear() {
 }
 
 void ChartWidget::addSample(double t, const hx::State& state, double pidSetpointTcOut, double coldFlow) {
-  // Add data points based on chart type
-  switch (type_) {
-    case TEMPERATURE:
-      series1_->append(t, state.Tc_out);
-      series2_->append(t, state.Th_out);
-      break;
-
-    case HEAT_DUTY:
-      series1_->append(t, state.Q / 1000.0);  // Watts to kW
-      series2_->append(t, state.U);
-      break;
-
-    case PRESSURE:
-      series1_->append(t, state.dP_tube);
-      series2_->append(t, state.dP_shell);
-      break;
-
-    case FOULING:
-      series1_->append(t, state.Rf * 10000.0);  // Scale for visibility
-      break;
+  hx::State s = state;
+  if (!std::isnan(pidSetpointTcOut)) s.pidSetpoint = pidSetpointTcOut;
+  if (!std::isnan(coldFlow)) s.pidColdFlow = coldFlow;
+  const std::pair<double, hx::State> sample{t, s};
+  addSamples(&sample, 1);
+}
 
-    case PID_CONTROL:
-      series1_->append(t, state.Tc_out);
-      if (series2_) {
-        const double setpoint = std::isnan(pidSetpointTcOut) ? state.Tc_out : pidSetpointTcOut;
-        series2_->append(t, setpoint);
-      }
-      if (series3_) {
-        const double flow = std::isnan(coldFlow) ? 0.0 : coldFlow;  // No scaling
-        series3_->append(t, flow);
-        // Update running min/max incrementally so updateAxes() doesn't
-        // have to copy+scan the entire QLineSeries on each tick.
+void ChartWidget::addSamples(const std::pair<double, hx::State> *samples, size_t n) {
+  if (n == 0) return;
+
+  // Only the history grows here; what Qt draws is rebuilt once, for the
+  // visible range, by the refresh this schedules.
+  for (size_t i = 0; i < n; ++i) {
+    const double t = samples[i].first;
+    const hx::State &state = samples[i].second;
+    switch (type_) {
+      case TEMPERATURE:
+        data_[0].append(t, state.Tc_out);
+        data_[1].append(t, state.Th_out);
+        break;
+      case HEAT_DUTY:
+        data_[0].append(t, state.Q / 1000.0);  // Watts to kW
+        data_[1].append(t, state.U);
+        break;
+      case PRESSURE:
+        data_[0].append(t, state.dP_tube);
+        data_[1].append(t, state.dP_shell);
+        break;
+      case FOULING:
+        data_[0].append(t, state.Rf * 10000.0);  // Scale for visibility
+        break;
+      case PID_CONTROL: {
+        data_[0].append(t, state.Tc_out);
+        const double setpoint = std::isnan(state.pidSetpoint) ? state.Tc_out : state.pidSetpoint;
+        data_[1].append(t, setpoint);
+        const double flow = std::isnan(state.pidColdFlow) ? 0.0 : state.pidColdFlow;  // No scaling
+        data_[2].append(t, flow);
+        // Running min/max so updateAxes() never scans the history.
         if (flow < flowSeenMin_) flowSeenMin_ = flow;
         if (flow > flowSeenMax_) flowSeenMax_ = flow;
+        break;
       }
-      break;
+    }
   }
 
-  // Auto-scale time axis
-  if (t > axisX_->max()) {
-    axisX_->setMax(t + 10);
+  const double tLast = samples[n - 1].first;
+  if (tLast > axisX_->max()) {
+    axisX_->setMax(tLast + 10);
   }
 
-  // Auto-scale Y axis with proper margins
-  if (++sampleCount_ % 10 == 0) {  // Update every 10 samples
-    updateAxes(t, state);
+  // Rescale whenever the count crosses a multiple of 10, using the newest state.
+  const int before = sampleCount_;
+  sampleCount_ += static_cast<int>(n);
+  if (sampleCount_ / 10 != before / 10) {
+    updateAxes(tLast, samples[n - 1].second);
   }
+  scheduleRefresh();
+}
+
+void ChartWidget::scheduleRefresh() {
+  if (refreshQueued_) return;
+  refreshQueued_ = true;
+  QTimer::singleShot(0, this, [this]() {
+    refreshQueued_ = false;
+    refreshVisible();
+  });
+}
+
+void ChartWidget::refreshVisible() {
+  const double xLo = axisX_->min();
+  const double xHi = axisX_->max();
+  const size_t columns = static_cast<size_t>(std::max(64.0, chart_->plotArea().width()));
+
+  auto apply = [&](QLineSeries *series, const hx::DecimatedSeries &data) {
+    if (!series) return;
+    data.decimate(xLo, xHi, columns, lodScratch_);
+    lodPoints_.clear();
+    lodPoints_.reserve(static_cast<qsizetype>(lodScratch_.size()));
+    for (const hx::SeriesPoint &p : lodScratch_) lodPoints_.append(QPointF(p.x, p.y));
+    series->replace(lodPoints_);
+  };
+
+  apply(series1_, data_[0]);
+  apply(series2_, data_[1]);
+  apply(series3_, data_[2]);
+  apply(baseline1_, baselineData_[0]);
+  apply(baseline2_, baselineData_[1]);
+  apply(baseline3_, baselineData_[2]);
 }
 
 void ChartWidget::updateAxes(double t, const hx::State& state) {
@@ -444,9 +498,9 @@ void ChartWidget::updateAxes(double t, const hx::State& state) {
   }
   
   // Update right Y-axis for PID control chart with flow rate data.
-  // Use the running min/max maintained in addSample() so we don't have
-  // to copy & scan series3_->points() (O(n)) every time.
-  if (type_ == PID_CONTROL && axisY2_ && series3_ && series3_->count() > 0 &&
+  // Use the running min/max maintained in addSamples() so we don't have
+  // to scan the flow history (O(n)) every time.
+  if (type_ == PID_CONTROL && axisY2_ && series3_ && !data_[2].empty() &&
       std::isfinite(flowSeenMin_) && std::isfinite(flowSeenMax_)) {
     const double flowMin = flowSeenMin_;
     const double flowMax = flowSeenMax_;
@@ -473,7 +527,7 @@ void ChartWidget::zoomOut() {
 void ChartWidget::resetZoom() {
   chart_->zoomReset();
   // Reset to default ranges
-  axisX_->setRange(0, series1_->count() > 0 ? series1_->at(series1_->count()-1).x() : 100);
+  axisX_->setRange(0, !data_[0].empty() ? data_[0].lastX() : 100);
   
   switch (type_) {
     case TEMPERATURE: axisY_->setRange(20, 100); break;
@@ -5,8 +5,12 @@
 #include <QtCharts/QChartView>
 #include <QtCharts/QLineSeries>
 #include <QtCharts/QValueAxis>
+#include <QList>
+#include <QPointF>
+#include <utility>
 #include <vector>
 #include <limits>
+#include "core/DecimatedSeries.hpp"
 #include "core/Types.hpp"
 
 /**
@@ -35,6 +39,12 @@ private:
  * 
  * Each chart shows only related series with appropriate scaling.
  * Much clearer than cramming all 7 series on one chart!
+ *
+ * The full-resolution history of every trace lives in an hx::DecimatedSeries;
+ * the QLineSeries only ever hold the min/max level of detail for the visible
+ * x-range (about two points per pixel column), rebuilt whenever the axis
+ * range changes — live scrolling, wheel / rubber-band zoom, panning — so
+ * drawing cost does not grow with the length of the run.
  */
 class ChartWidget : public QWidget {
   Q_OBJECT
@@ -52,6 +62,11 @@ public:
 
   void clear();
   void addSample(double t, const hx::State& state, double pidSetpointTcOut = std::numeric_limits<double>::quiet_NaN(), double coldFlow = std::numeric_limits<double>::quiet_NaN());
+  /** Append \p n consecutive samples to the DecimatedSeries histories
+   *  (data_) and scheduleRefresh() once; refreshVisible() then redraws only
+   *  the visible range.  The PID chart takes its setpoint and cold flow
+   *  from State::pidSetpoint / State::pidColdFlow. */
+  void addSamples(const std::pair<double, hx::State> *samples, size_t n);
 
   /** Snapshot the current live traces as an immutable baseline overlay.
    *  The baseline is rendered as dashed lines with reduced opacity so the user
@@ -69,6 +84,10 @@ private:
   void setupChart();
   void setupSeries();
   void updateAxes(double t, const hx::State& state);
+  /** Coalesce refreshVisible() requests into one per event-loop pass. */
+  void scheduleRefresh();
+  /** Re-decimate every trace for the current x-range and plot width. */
+  void refreshVisible();
 
   ChartType type_;
   QChart *chart_{};
@@ -102,4 +121,11 @@ private:
   // avoids an O(n) rescan of the whole QLineSeries on every updateAxes().
   double flowSeenMin_{ std::numeric_limits<double>::infinity()};
   double flowSeenMax_{-std::numeric_limits<double>::infinity()};
+
+  // Full-resolution history behind series1_..3_ and baseline1_..3_.
+  hx::DecimatedSeries data_[3];
+  hx::DecimatedSeries baselineData_[3];
+  std::vector<hx::SeriesPoint> lodScratch_;  // reused by refreshVisible()
+  QList<QPointF> lodPoints_;
+  bool refreshQueued_{false};
 };
@@ -147,6 +147,11 @@ void HeatExchangerWidget::updateSimulationState(const hx::State &state) {
   update();
 }
 
+void HeatExchangerWidget::updateAxialProfile(const QVector<double> &Th) {
+  Th_axial_ = Th;
+  update();
+}
+
 void HeatExchangerWidget::setOperatingPoint(const hx::OperatingPoint &op) {
   op_ = op;
   if (hotFlowSlider_) {
@@ -517,7 +522,7 @@ void HeatExchangerWidget::drawTubes(QPainter &p) {
   double tubeStartX = shellX_ + 6;
 
   // Whether we have a proper axial T(x) profile from the finite-volume model.
-  const bool haveAxial = hasState_ && !state_.Th_axial.empty();
+  const bool haveAxial = hasState_ && !Th_axial_.isEmpty();
   const double Tspan = std::max(1.0, op_.Tin_hot - op_.Tin_cold);
 
   for (int i = 0; i < visibleTubes_; ++i) {
@@ -528,10 +533,10 @@ void HeatExchangerWidget::drawTubes(QPainter &p) {
     if (haveAxial) {
       // Paint an actual T(x) gradient derived from the axial cell array:
       // index 0 = hot inlet side (x=0), index N-1 = hot outlet side (x=L).
-      const int N = static_cast<int>(state_.Th_axial.size());
+      const int N = static_cast<int>(Th_axial_.size());
       for (int k = 0; k < N; ++k) {
         const double x = (N == 1) ? 0.5 : static_cast<double>(k) / (N - 1);
-        const double Tk = state_.Th_axial[static_cast<size_t>(k)];
+        const double Tk = Th_axial_[k];
         // Normalize into [0,1] with 1 = hot, 0 = cold. Clamp so disturbance
         // overshoots don't blow the color map out of range.
         double normT = (Tk - op_.Tin_cold) / Tspan;
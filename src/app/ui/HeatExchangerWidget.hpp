@@ -18,6 +18,8 @@ public:
 
   void setGeometryData(const hx::Geometry &geometry);
   void updateSimulationState(const hx::State &state);
+  /** Hot-side cell temperatures (index 0 = hot inlet); empty → lumped look. */
+  void updateAxialProfile(const QVector<double> &Th);
   void setOperatingPoint(const hx::OperatingPoint &op);
   void setSimulationRunning(bool running);
 
@@ -85,6 +87,7 @@ private:
   // --- State ---
   hx::Geometry geom_{};
   hx::State state_{};
+  QVector<double> Th_axial_;   // owned copy of the latest hot-side profile
   hx::OperatingPoint op_{};
   bool hasGeometry_{false};
   bool hasState_{false};
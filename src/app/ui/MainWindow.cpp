@@ -5,6 +5,7 @@
 #include "SimWorker.hpp"
 #include "SpectrumWidget.hpp"
 #include "MonteCarloDialog.hpp"
+#include "MonteCarloWorker.hpp"
 #include "VibrationDialog.hpp"
 #include "FoulingMapDialog.hpp"
 #include "RunLogDialog.hpp"
@@ -41,7 +42,6 @@
 #include <QDesktopServices>
 #include <QUrl>
 #include <QInputDialog>
-#include <QProgressDialog>
 #include <QPrinter>
 #include <QPageLayout>
 #include <QPageSize>
@@ -88,6 +88,12 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
   geometryUpdateTimer_->setSingleShot(true);
   geometryUpdateTimer_->setInterval(300);
   connect(geometryUpdateTimer_, &QTimer::timeout, this, &MainWindow::onGeometryDebounceTimeout);
+
+  // Display-frame timer: drains the worker's sample ring while a run is live.
+  frameTimer_ = new QTimer(this);
+  frameTimer_->setTimerType(Qt::PreciseTimer);
+  frameTimer_->setInterval(16);
+  connect(frameTimer_, &QTimer::timeout, this, &MainWindow::onFrameTick);
   DIAG_END(*diagnostics, "Debounce timer ready");
   
   DIAG_BEGIN(*diagnostics, "Reset to Defaults");
@@ -130,6 +136,13 @@ MainWindow::~MainWindow() {
     simThread_->quit();
     simThread_->wait();
   }
+  if (mcThread_) {
+    mcWorker_->control().cancel.store(true);
+    mcThread_->quit();
+    mcThread_->wait();
+    delete mcWorker_;
+    mcWorker_ = nullptr;
+  }
 }
 
 void MainWindow::resetToDefaults() {
@@ -361,8 +374,9 @@ QWidget* MainWindow::createTopBar() {
   btnMonteCarlo_->setToolTip(
       "Run a Monte-Carlo sensitivity study: N trials with Gaussian noise\n"
       "applied to flows, inlet temperatures, fluid properties and fouling.\n"
-      "Produces histograms, summary statistics, and a tornado chart showing\n"
-      "the relative influence of each input on the heat-transfer performance.");
+      "Produces histograms, summary statistics, Sobol' sensitivity indices\n"
+      "and a tornado chart showing the relative influence of each input on\n"
+      "the heat-transfer performance.");
   btnMonteCarlo_->setStyleSheet(
       "QPushButton{background:#8e44ad;color:white;font-weight:600;}"
       "QPushButton:hover{background:#9b59b6;}"
@@ -440,11 +454,25 @@ QWidget* MainWindow::createTopBar() {
   cmbSpeed_->addItem("20x", 20);
   cmbSpeed_->addItem("50x", 50);
   cmbSpeed_->addItem("100x", 100);
+  cmbSpeed_->addItem("Max (unpaced)", 0);
   cmbSpeed_->setCurrentIndex(0);
   cmbSpeed_->setMinimumWidth(130);
-  cmbSpeed_->setToolTip("Simulation speed multiplier\n1x = real-time (1800 s takes 30 min)\n100x = fast (1800 s takes 18 s)");
+  cmbSpeed_->setToolTip("Simulation speed multiplier\n1x = real-time (1800 s takes 30 min)\n100x = fast (1800 s takes 18 s)\n"
+                        "Max = no pacing: the simulator runs flat out and the charts show what the display keeps up with");
   row2Layout->addWidget(cmbSpeed_);
 
+  row2Layout->addWidget(new QLabel("Overflow:", this));
+  cmbOverflow_ = new QComboBox(this);
+  cmbOverflow_->addItem("Decimate", static_cast<int>(hx::OverflowPolicy::Decimate));
+  cmbOverflow_->addItem("Drop", static_cast<int>(hx::OverflowPolicy::Drop));
+  cmbOverflow_->addItem("Block", static_cast<int>(hx::OverflowPolicy::Block));
+  cmbOverflow_->setCurrentIndex(0);
+  cmbOverflow_->setToolTip("What happens when the display falls behind the simulator:\n"
+                           "Decimate = keep only the newest of the samples that don't fit\n"
+                           "Drop = discard samples that don't fit\n"
+                           "Block = slow the simulator down to the display rate (keeps every sample)");
+  row2Layout->addWidget(cmbOverflow_);
+
   row2Layout->addWidget(new QLabel("Simulation:", this));
   cmbSimulationMode_ = new QComboBox(this);
   cmbSimulationMode_->addItem("Steady Clean (no fouling)");
@@ -475,6 +503,11 @@ QWidget* MainWindow::createTopBar() {
   lblStatus_->setStyleSheet("color: #27ae60; font-weight: bold; font-size: 10pt;");
   row2Layout->addWidget(lblStatus_);
 
+  lblSamples_ = new QLabel(this);
+  lblSamples_->setStyleSheet("color: #7f8c8d; font-size: 9pt;");
+  lblSamples_->setToolTip("Samples delivered to the charts, and samples lost to the overflow policy");
+  row2Layout->addWidget(lblSamples_);
+
   row2Layout->addStretch();
 
   return topBar;
@@ -786,6 +819,34 @@ QWidget* MainWindow::createTopBar() {
           this, &MainWindow::onParameterChanged);
   formGeom->addRow("Shell-side Method:", cmbShellMethod_);
 
+  cmbAxialIntegrator_ = new QComboBox(this);
+  cmbAxialIntegrator_->addItem("Explicit (CFL sub-steps)", static_cast<int>(hx::AxialIntegrator::ExplicitSubstep));
+  cmbAxialIntegrator_->addItem("Backward Euler (implicit)", static_cast<int>(hx::AxialIntegrator::BackwardEuler));
+  cmbAxialIntegrator_->addItem("Crank–Nicolson (implicit)", static_cast<int>(hx::AxialIntegrator::CrankNicolson));
+  cmbAxialIntegrator_->setCurrentIndex(0);
+  cmbAxialIntegrator_->setToolTip(
+      "Time integrator for the axial finite-volume model.\n"
+      "Explicit: forward Euler with CFL sub-stepping; cost grows with flow "
+      "rate and cell count.\n"
+      "Backward Euler / Crank–Nicolson: one block-tridiagonal solve per "
+      "step, stable for any time step.");
+  connect(cmbAxialIntegrator_, QOverload<int>::of(&QComboBox::currentIndexChanged),
+          this, &MainWindow::onParameterChanged);
+  formGeom->addRow("Axial Integrator:", cmbAxialIntegrator_);
+
+  cmbLumpedIntegrator_ = new QComboBox(this);
+  cmbLumpedIntegrator_->addItem("Explicit Euler (fixed dt)", static_cast<int>(hx::LumpedIntegrator::ExplicitEuler));
+  cmbLumpedIntegrator_->addItem("Dormand–Prince 5(4) (adaptive)", static_cast<int>(hx::LumpedIntegrator::DormandPrince45));
+  cmbLumpedIntegrator_->setCurrentIndex(0);
+  cmbLumpedIntegrator_->setToolTip(
+      "Time integrator for the lumped model (1 axial cell).\n"
+      "Explicit Euler: one step per time step; accuracy depends on dt.\n"
+      "Dormand–Prince: error-controlled internal steps (rtol 1e-6, atol 1e-4 K); "
+      "results are interpolated onto the time-step grid.");
+  connect(cmbLumpedIntegrator_, QOverload<int>::of(&QComboBox::currentIndexChanged),
+          this, &MainWindow::onParameterChanged);
+  formGeom->addRow("Lumped Integrator:", cmbLumpedIntegrator_);
+
   layout->addWidget(grpGeometry);
 
   // === FOULING ===
@@ -1381,6 +1442,13 @@ void MainWindow::updateSimulationCore() {
       ? static_cast<hx::ShellSideMethod>(cmbShellMethod_->currentData().toInt())
       : hx::ShellSideMethod::Kern;
 
+  simConfig_.axialIntegrator = cmbAxialIntegrator_
+      ? static_cast<hx::AxialIntegrator>(cmbAxialIntegrator_->currentData().toInt())
+      : hx::AxialIntegrator::ExplicitSubstep;
+  simConfig_.lumpedIntegrator = cmbLumpedIntegrator_
+      ? static_cast<hx::LumpedIntegrator>(cmbLumpedIntegrator_->currentData().toInt())
+      : hx::LumpedIntegrator::ExplicitEuler;
+
   // FLUID PRESETS (feeds T-dependent property library)
   simConfig_.hotPreset  = cmbHotPreset_
       ? static_cast<hx::FluidPreset>(cmbHotPreset_->currentData().toInt())
@@ -1479,13 +1547,7 @@ void MainWindow::onStart() {
   if (spectrumWidget_) spectrumWidget_->clear();
   if (kpiPanel_) kpiPanel_->reset();
   U_clean_baseline_ = 0.0;
-  simulationData_.clear();
-  // Pre-reserve to avoid 10+ reallocations over a typical run.  Adds a
-  // small slack so the +60 s scenario tail doesn't force a reallocation.
-  if (simConfig_.dt > 0.0) {
-    const size_t est = static_cast<size_t>(simConfig_.tEnd / simConfig_.dt) + 128;
-    simulationData_.reserve(est);
-  }
+  trace_.clear();
 
   // Create simulator
   auto simulator = std::make_unique<hx::Simulator>(*thermo_, *hydro_, *fouling_, simConfig_);
@@ -1506,13 +1568,24 @@ void MainWindow::onStart() {
   // Set speed multiplier from combo box
   int speedMultiplier = cmbSpeed_->currentData().toInt();
   simWorker_->setSpeedMultiplier(speedMultiplier);
-  
-  
+  sampleRing_ = std::make_shared<hx::SampleRing>(
+      8192, static_cast<hx::OverflowPolicy>(cmbOverflow_->currentData().toInt()));
+  simWorker_->setSampleRing(sampleRing_);
+  updateSampleCounters();
+  // Only the exchanger view draws T(x); samples stay scalar otherwise.
+  simWorker_->setProfileSubscription(exchWidget_ != nullptr && simConfig_.numAxialCells > 1);
+  if (exchWidget_) exchWidget_->updateAxialProfile({});
+
   simWorker_->moveToThread(simThread_);
 
   // Connect signals
   connect(simThread_, &QThread::started, simWorker_, &SimWorker::run);
-  connect(simWorker_, &SimWorker::sampleReady, this, &MainWindow::onSimulationSample);
+  connect(simWorker_, &SimWorker::profileReady, this,
+          [this](double t, const QVector<double> &Th, const QVector<double> &Tc) {
+            trace_.appendProfile(t, hx::ProfileView(Th.constData(), static_cast<size_t>(Th.size())),
+                                 hx::ProfileView(Tc.constData(), static_cast<size_t>(Tc.size())));
+            if (exchWidget_) exchWidget_->updateAxialProfile(Th);
+          });
   connect(simWorker_, &SimWorker::finished, this, &MainWindow::onSimulationFinished);
   connect(simWorker_, &SimWorker::finished, simThread_, &QThread::quit);
   connect(simThread_, &QThread::finished, simWorker_, &QObject::deleteLater);
@@ -1532,6 +1605,7 @@ void MainWindow::onStart() {
   // Start
   if (exchWidget_) exchWidget_->setSimulationRunning(true);
   simThread_->start();
+  frameTimer_->start();
   statusBar()->showMessage("Simulation running...");
 }
 
@@ -1550,41 +1624,84 @@ void MainWindow::onStop() {
   statusBar()->showMessage("Stopping simulation...");
 }
 
-void MainWindow::onSimulationSample(double t, const hx::State& state) {
-  // Store data for export
-  simulationData_.push_back({t, state});
-  
-  // Add to all charts
-  chartTemp_->addSample(t, state);
-  chartHeat_->addSample(t, state);
-  chartPressure_->addSample(t, state);
-  chartFouling_->addSample(t, state);
+// -----------------------------------------------------------------------------
+// Frame-coalesced rendering.  Once per display frame every record the worker
+// has queued since the previous frame is recorded in trace_ and collected in
+// frameBatch_, which is handed to each chart as one batch: one history
+// append per trace, one axis update, one FFT at most.  The exchanger view and the KPI
+// panel only show the present, so they are refreshed once with the newest
+// state.  Per-frame cost is then one repaint per widget however fast the
+// simulator runs.
+// -----------------------------------------------------------------------------
+void MainWindow::drainSamples(size_t maxRecords) {
+  if (!sampleRing_) return;
+  frameBatch_.clear();
+  sampleRing_->drain([this](const hx::SampleRecord &r) {
+                       trace_.append(r.t, r.state);
+                       frameBatch_.emplace_back(r.t, r.state);
+                     },
+                     maxRecords);
+  renderSamples();
+}
+
+void MainWindow::renderSamples() {
+  if (frameBatch_.empty()) return;
+  const std::pair<double, hx::State> *batch = frameBatch_.data();
+  const size_t n = frameBatch_.size();
+
+  chartTemp_->addSamples(batch, n);
+  chartHeat_->addSamples(batch, n);
+  chartPressure_->addSamples(batch, n);
+  chartFouling_->addSamples(batch, n);
   if (chartPID_) {
-    chartPID_->addSample(t, state, state.pidSetpoint, state.pidColdFlow);
+    chartPID_->addSamples(batch, n);
   }
   if (spectrumWidget_) {
-    spectrumWidget_->addSample(t, state.Tc_out);
+    frameTcOut_.clear();
+    frameTcOut_.reserve(static_cast<qsizetype>(n));
+    for (size_t i = 0; i < n; ++i) frameTcOut_.append(QPointF(batch[i].first, batch[i].second.Tc_out));
+    spectrumWidget_->addSamples(frameTcOut_);
   }
+
+  const hx::State &latest = batch[n - 1].second;
   if (exchWidget_) {
-    exchWidget_->updateSimulationState(state);
+    exchWidget_->updateSimulationState(latest);
   }
   if (kpiPanel_) {
-    // Capture clean-U baseline once, at first valid sample of the run.
-    if (U_clean_baseline_ <= 0.0 && state.U > 0.0 && state.Rf <= 1e-9) {
-      U_clean_baseline_ = state.U;
+    // Capture clean-U baseline once, at the first valid sample of the run —
+    // which may be anywhere in this frame's batch.
+    for (size_t i = 0; i < n && U_clean_baseline_ <= 0.0; ++i) {
+      const hx::State &s = batch[i].second;
+      if (s.U > 0.0 && s.Rf <= 1e-9) U_clean_baseline_ = s.U;
     }
-    const double baseline = (U_clean_baseline_ > 0.0) ? U_clean_baseline_ : state.U;
-    kpiPanel_->update(state, op_, hot_, cold_, geom_, simConfig_.limits, baseline);
+    const double baseline = (U_clean_baseline_ > 0.0) ? U_clean_baseline_ : latest.U;
+    kpiPanel_->update(latest, op_, hot_, cold_, geom_, simConfig_.limits, baseline);
   }
+}
+
+void MainWindow::updateSampleCounters() {
+  if (!lblSamples_) return;
+  if (!sampleRing_) {
+    lblSamples_->clear();
+    return;
+  }
+  const hx::SampleRingStats st = sampleRing_->stats();
+  lblSamples_->setText(QStringLiteral("Samples: %1  dropped: %2  coalesced: %3")
+                           .arg(st.drained).arg(st.dropped).arg(st.coalesced));
+}
 
-  // Live per-tube fouling heatmap: every ~30 samples (≈0.6 s of UI time at
-  // the worker's 50 Hz cap) recompute the spatial map from the current bulk
-  // Rf and push it to the open dialog.  Computing the map is O(nTubes·nAxial)
-  // — small enough not to dent the UI thread but big enough that we don't
-  // want to run it on every sample.
-  if (heatmapDlg_ && state.Rf > 0.0) {
-    if (++heatmapSampleCounter_ >= 30) {
-      heatmapSampleCounter_ = 0;
+void MainWindow::onFrameTick() {
+  drainSamples(static_cast<size_t>(-1));
+  updateSampleCounters();
+
+  // Live per-tube fouling heatmap: every ~36 frames (≈0.6 s) recompute the
+  // spatial map from the latest bulk Rf and push it to the open dialog.
+  // Computing the map is O(nTubes·nAxial) — small enough not to dent the UI
+  // thread but big enough that we don't want to run it every frame.
+  if (heatmapDlg_ && !trace_.empty()) {
+    const hx::State &state = trace_.lastState();
+    if (state.Rf > 0.0 && ++heatmapFrameCounter_ >= 36) {
+      heatmapFrameCounter_ = 0;
       const hx::FoulingMap liveMap =
           hx::computeFoulingMap(geom_, op_, state.Rf, 24);
       heatmapDlg_->updateMap(liveMap, geom_);
@@ -1593,11 +1710,17 @@ void MainWindow::onSimulationSample(double t, const hx::State& state) {
 }
 
 void MainWindow::onSimulationFinished() {
+  // finished() is queued after the worker's last push, so this drain sees
+  // every record that made it into the ring.
+  frameTimer_->stop();
+  drainSamples(static_cast<size_t>(-1));
+  updateSampleCounters();
+
   btnStart_->setEnabled(true);
   btnPause_->setEnabled(false);
   btnStop_->setEnabled(false);
   btnExport_->setEnabled(true);
-  const bool haveData = !simulationData_.empty();
+  const bool haveData = !trace_.empty();
   btnSnapshot_->setEnabled(haveData);
   btnReport_->setEnabled(haveData);
   if (exchWidget_) exchWidget_->setSimulationRunning(false);
@@ -1606,38 +1729,23 @@ void MainWindow::onSimulationFinished() {
   isRunning_ = false;
   isPaused_ = false;
   statusBar()->showMessage(QString("Simulation completed successfully - %1 data points collected")
-                          .arg(simulationData_.size()), 5000);
+                          .arg(trace_.size()), 5000);
 
   // === Auto-log to SQLite run history (D12) =========================
   // Persist the run so the user can browse / compare it later via the
   // "Run Log..." dialog.  Non-fatal — any DB error is swallowed and
   // reported on the status bar so the main UI flow is unaffected.
   if (haveData && hx::RunLog::instance().isOpen()) {
-    const auto &[tFinal, sFinal] = simulationData_.back();
-    std::vector<hx::RunSample> samples;
-    samples.reserve(simulationData_.size());
-    for (const auto &[t, s] : simulationData_) {
-      hx::RunSample rs;
-      rs.t        = t;
-      rs.Tc_out   = s.Tc_out;
-      rs.Th_out   = s.Th_out;
-      rs.Q        = s.Q;
-      rs.U        = s.U;
-      rs.Rf       = s.Rf;
-      rs.dP_tube  = s.dP_tube;
-      rs.dP_shell = s.dP_shell;
-      rs.pid_cmd  = s.pidColdFlow;        // NaN when PID disabled
-      samples.push_back(rs);
-    }
+    // Samples stream straight from the recorder's chunks into the insert.
     hx::RunRecord rec = hx::RunLog::makeRecord(
         simConfig_, op_, geom_, hot_, cold_,
         simulationModeLabel(simulationMode_),
-        tFinal, sFinal);
-    const qint64 rowId = hx::RunLog::instance().saveRun(rec, samples);
+        trace_.lastTime(), trace_.lastState());
+    const qint64 rowId = hx::RunLog::instance().saveRun(rec, trace_);
     if (rowId > 0) {
       statusBar()->showMessage(
           QString("Run archived to history database (id = %1, %2 samples)")
-              .arg(rowId).arg(simulationData_.size()),
+              .arg(rowId).arg(trace_.size()),
           5000);
     }
   }
@@ -1680,7 +1788,7 @@ void MainWindow::onReset() {
   if (spectrumWidget_) spectrumWidget_->clear();
   if (kpiPanel_) kpiPanel_->reset();
   U_clean_baseline_ = 0.0;
-  simulationData_.clear();
+  trace_.clear();
   btnExport_->setEnabled(false);
   btnSnapshot_->setEnabled(false);
   btnReport_->setEnabled(false);
@@ -1768,8 +1876,8 @@ void MainWindow::onExportData() {
   // Write header
   out << "Time[s],Tc_out[C],Th_out[C],Q[W],U[W/m2K],Rf[m2K/W],dP_tube[Pa],dP_shell[Pa]\n";
   
-  // Write data
-  for (const auto& [t, state] : simulationData_) {
+  // Write data (streamed chunk by chunk from the recorder)
+  trace_.forEach([&out](double t, const hx::State &state) {
     out << t << "," 
         << state.Tc_out << "," 
         << state.Th_out << ","
@@ -1778,17 +1886,17 @@ void MainWindow::onExportData() {
         << state.Rf << ","
         << state.dP_tube << "," 
         << state.dP_shell << "\n";
-  }
+  });
   
   file.close();
   statusBar()->showMessage(QString("Data exported to %1").arg(filename), 5000);
   QMessageBox::information(this, "Export Complete",
                           QString("Simulation data exported to:\n%1\n\n%2 data points saved.")
-                          .arg(filename).arg(simulationData_.size()));
+                          .arg(filename).arg(trace_.size()));
 }
 
 void MainWindow::onSnapshotBaseline() {
-  if (simulationData_.empty()) {
+  if (trace_.empty()) {
     statusBar()->showMessage("Run a simulation first before capturing a baseline", 4000);
     return;
   }
@@ -1849,7 +1957,7 @@ QString fmt(double v, int prec = 3) {
 } // namespace
 
 void MainWindow::onGenerateReport() {
-  if (simulationData_.empty()) {
+  if (trace_.empty()) {
     QMessageBox::information(this, "No Data",
         "Run a simulation first - the report needs final-state values to summarise.");
     return;
@@ -1867,7 +1975,8 @@ void MainWindow::onGenerateReport() {
   const bool isPdf = (ext == QStringLiteral("pdf"))
                      || (ext.isEmpty() && selectedFilter.contains(QStringLiteral("pdf"), Qt::CaseInsensitive));
 
-  const auto &[t_final, s_final] = simulationData_.back();
+  const double t_final = trace_.lastTime();
+  const hx::State &s_final = trace_.lastState();
   const double dT_hot  = op_.Tin_hot  - s_final.Th_out;
   const double dT_cold = s_final.Tc_out - op_.Tin_cold;
   const double Ch = op_.m_dot_hot  * hot_.cp;
@@ -1912,7 +2021,7 @@ void MainWindow::onGenerateReport() {
       << QDateTime::currentDateTime().toString(QStringLiteral("yyyy-MM-dd HH:mm:ss"))
       << "</b> &middot; Mode <b>" << simulationModeLabel(simulationMode_)
       << "</b> &middot; Duration <b>" << fmt(t_final, 4) << " s</b> &middot; "
-      << "<b>" << simulationData_.size() << "</b> samples</p>\n";
+      << "<b>" << trace_.size() << "</b> samples</p>\n";
 
   out << "<h2>Key Performance Indicators (final state)</h2>\n";
   out << "<div>";
@@ -2157,10 +2266,15 @@ void MainWindow::onAutoTunePid() {
 }
 
 void MainWindow::onMonteCarlo() {
-  if (isRunning_) {
-    QMessageBox::information(this, "Simulation Running",
-        "Stop the running simulation before launching a Monte-Carlo study - "
-        "the ensemble needs exclusive use of the plant model.");
+  // One study at a time; a second click brings the running one to the front.
+  if (mcThread_) {
+    if (mcDlg_) {
+      mcDlg_->raise();
+      mcDlg_->activateWindow();
+    } else {
+      statusBar()->showMessage(
+          QStringLiteral("Monte-Carlo: the previous study is still winding down."), 4000);
+    }
     return;
   }
 
@@ -2178,65 +2292,128 @@ void MainWindow::onMonteCarlo() {
           "Number of Monte-Carlo trials:\n"
           "\n"
           "Each trial perturbs flows, inlet temperatures, fluid properties\n"
-          "and fouling asymptote by Gaussian noise (σ ≈ 2–15%%) and runs a\n"
-          "short dynamic simulation to settle. More trials → smoother\n"
-          "distributions. Typical: 100–500."),
-      200, 20, 2000, 50, &ok);
+          "and fouling asymptote by Gaussian noise (σ ≈ 2–15%%) and solves\n"
+          "the steady state it settles to. More trials → smoother\n"
+          "distributions; the study runs in the background and can be\n"
+          "stopped once its convergence tab looks settled. Typical:\n"
+          "256–10000; Sobol' sampling balances best at 8 × a power of two."),
+      256, 20, 100000, 32, &ok);
+  if (!ok) return;
+
+  // Sampling design: the stratified / low-discrepancy designs reach a given
+  // standard error on the mean with several times fewer trials.
+  const hx::SamplingStrategy strategies[] = {
+      hx::SamplingStrategy::Sobol, hx::SamplingStrategy::LatinHypercube,
+      hx::SamplingStrategy::Halton, hx::SamplingStrategy::MonteCarlo};
+  QStringList strategyNames;
+  for (hx::SamplingStrategy s : strategies) {
+    strategyNames << QString::fromUtf8(hx::samplingStrategyName(s));
+  }
+  const QString strategy = QInputDialog::getItem(
+      this,
+      QStringLiteral("Monte-Carlo Sensitivity"),
+      QStringLiteral("Sampling strategy:"),
+      strategyNames, 0, false, &ok);
   if (!ok) return;
 
   hx::MonteCarloSettings mc;
   mc.nTrials = nTrials;
+  mc.sampling = strategies[std::max<qsizetype>(0, strategyNames.indexOf(strategy))];
   mc.includeFouling = (simulationMode_ == SimulationMode::SteadyFouling
                        || simulationMode_ == SimulationMode::DynamicFouling);
   mc.seed = static_cast<uint32_t>(QDateTime::currentSecsSinceEpoch() & 0xffffffffu);
+  mc.bootstrapResamples = 200;
+  mc.keepTrials = true;              // the dialog exports the per-trial data
+  mc.snapshotIntervalMs = 250;       // live distributions in the dialog
+  // Leave a core to the live simulation (and this thread) when one is running.
+  if (isRunning_) mc.threads = std::max(1, QThread::idealThreadCount() - 1);
+
+  // The study runs on its own thread (and fans out to a worker pool).  This
+  // thread only polls the worker's control block: progress and the latest
+  // snapshot go to the dialog, Stop and Close are single atomic stores.
+  mcThread_ = new QThread(this);
+  mcWorker_ = new MonteCarloWorker(op_, geom_, hot_, cold_, foulParams_, simConfig_, mc);
+  mcWorker_->moveToThread(mcThread_);
+  connect(mcThread_, &QThread::started, mcWorker_, &MonteCarloWorker::run);
+  connect(mcWorker_, &MonteCarloWorker::finished, this, &MainWindow::onMonteCarloFinished);
+  mcSnapshotSerial_ = 0;
+
+  hx::MonteCarloResult pending;
+  pending.partial        = true;
+  pending.nTrialsPlanned = mc.nTrials;
+  pending.sampling       = mc.sampling;
+  pending.solver         = mc.solver;
+  pending.message        = "Running Monte-Carlo study...";
+  auto *dlg = new MonteCarloDialog(pending, this);
+  dlg->setAttribute(Qt::WA_DeleteOnClose);
+  dlg->setRunning(true);
+  mcDlg_ = dlg;
+  connect(dlg, &MonteCarloDialog::stopRequested, this, [this]() {
+    if (mcWorker_) mcWorker_->control().stop.store(true);
+  });
+  // Closing the dialog abandons the study.
+  connect(dlg, &QObject::destroyed, this, [this]() {
+    mcDlg_ = nullptr;
+    if (mcWorker_) mcWorker_->control().cancel.store(true);
+  });
 
-  const int total = mc.nTrials + 2 * 13;  // 13 = max tornado params
-  QProgressDialog progress(
-      QStringLiteral("Running Monte-Carlo study..."),
-      QStringLiteral("Cancel"), 0, total, this);
-  progress.setWindowModality(Qt::WindowModal);
-  progress.setMinimumDuration(0);
-  progress.setAutoClose(false);
-  progress.setValue(0);
-
-  auto cb = [&progress](int current, int totalArg, const char *phase) -> bool {
-    progress.setMaximum(totalArg);
-    progress.setValue(current);
-    progress.setLabelText(QString::fromLatin1(phase));
-    QCoreApplication::processEvents();
-    return !progress.wasCanceled();
-  };
+  if (!mcTimer_) {
+    mcTimer_ = new QTimer(this);
+    mcTimer_->setInterval(100);
+    connect(mcTimer_, &QTimer::timeout, this, [this]() {
+      if (!mcWorker_ || !mcDlg_) return;
+      hx::MonteCarloControl &control = mcWorker_->control();
+      mcDlg_->setProgress(control.done.load(), control.total.load());
+      const int serial = control.snapshotSerial.load(std::memory_order_acquire);
+      if (serial == mcSnapshotSerial_) return;
+      mcSnapshotSerial_ = serial;
+      if (const auto snapshot = control.snapshot()) mcDlg_->updateResult(*snapshot);
+    });
+  }
 
   statusBar()->showMessage(
-      QStringLiteral("Running Monte-Carlo study (%1 trials)...").arg(mc.nTrials));
-
-  const hx::MonteCarloResult result = hx::runMonteCarlo(
-      op_, geom_, hot_, cold_, foulParams_, simConfig_, mc, cb);
+      QStringLiteral("Running Monte-Carlo study (%1 trials) in the background...").arg(mc.nTrials));
+  dlg->show();
+  mcThread_->start();
+  mcTimer_->start();
+}
 
-  progress.setValue(progress.maximum());
-  progress.close();
+void MainWindow::onMonteCarloFinished() {
+  mcTimer_->stop();
+  // run() has returned; once the thread is down the worker can go from here.
+  mcThread_->quit();
+  mcThread_->wait();
+  const hx::MonteCarloResult result = mcWorker_->result();
+  delete mcWorker_;
+  mcWorker_ = nullptr;
+  mcThread_->deleteLater();
+  mcThread_ = nullptr;
 
   if (!result.ok) {
     statusBar()->showMessage(
         QStringLiteral("Monte-Carlo: %1").arg(QString::fromStdString(result.message)),
         8000);
-    if (!progress.wasCanceled()) {
+    // No dialog left means the user closed it, i.e. cancelled: nothing to report.
+    if (mcDlg_) {
       QMessageBox::warning(this, QStringLiteral("Monte-Carlo"),
                            QString::fromStdString(result.message));
+      mcDlg_->close();
     }
     return;
   }
 
   statusBar()->showMessage(
-      QStringLiteral("Monte-Carlo complete — %1 trials. μ(Q)=%2 W, σ(Q)=%3 W.")
+      QStringLiteral("Monte-Carlo %1 — %2 trials. μ(Q)=%3 W, σ(Q)=%4 W.")
+          .arg(result.partial ? QStringLiteral("stopped") : QStringLiteral("complete"))
           .arg(result.nTrials)
           .arg(result.statQ.mean,   0, 'g', 4)
           .arg(result.statQ.stddev, 0, 'g', 3),
       10000);
 
-  auto *dlg = new MonteCarloDialog(result, this);
-  dlg->setAttribute(Qt::WA_DeleteOnClose);
-  dlg->show();
+  if (mcDlg_) {
+    mcDlg_->setRunning(false);
+    mcDlg_->updateResult(result);
+  }
 }
 
 void MainWindow::onVibrationCheck() {
@@ -2280,8 +2457,8 @@ void MainWindow::onFoulingHeatmap() {
   // initial picture matches what the user is currently seeing on the charts.
   // Fall back to the integrator's t=0 value, then the foulParams defaults.
   double Rf_bulk = 0.0;
-  if (!simulationData_.empty()) {
-    Rf_bulk = simulationData_.back().second.Rf;
+  if (!trace_.empty()) {
+    Rf_bulk = trace_.lastState().Rf;
   }
   if (Rf_bulk <= 0.0 && fouling_) Rf_bulk = fouling_->Rf(0.0);
   if (Rf_bulk <= 0.0) Rf_bulk = foulParams_.Rf0 > 0.0 ? foulParams_.Rf0
@@ -2292,12 +2469,12 @@ void MainWindow::onFoulingHeatmap() {
   auto *dlg = new FoulingMapDialog(map, geom_, this);
   dlg->setAttribute(Qt::WA_DeleteOnClose);
   heatmapDlg_ = dlg;
-  heatmapSampleCounter_ = 0;
+  heatmapFrameCounter_ = 0;
   // Clear our pointer when the user closes the dialog so the next click
-  // creates a fresh one (and so onSimulationSample doesn't dereference it).
+  // creates a fresh one (and so onFrameTick doesn't dereference it).
   connect(dlg, &QObject::destroyed, this, [this]() {
     heatmapDlg_ = nullptr;
-    heatmapSampleCounter_ = 0;
+    heatmapFrameCounter_ = 0;
   });
   dlg->show();
 
@@ -6,6 +6,8 @@
 #include <QSpinBox>
 #include <QPushButton>
 #include <QLabel>
+#include <QList>
+#include <QPointF>
 #include <QCheckBox>
 #include <QComboBox>
 #include <QThread>
@@ -18,13 +20,17 @@
 #include "core/Hydraulics.hpp"
 #include "core/Fouling.hpp"
 #include "core/FluidLibrary.hpp"
+#include "core/SampleRing.hpp"
 #include "core/Simulator.hpp"
+#include "core/TraceRecorder.hpp"
 
 class ChartWidget;
 class HeatExchangerWidget;
 class KPIPanel;
 class SpectrumWidget;
 class SimWorker;
+class MonteCarloWorker;
+class MonteCarloDialog;
 class QGroupBox;
 class FoulingMapDialog;
 
@@ -65,12 +71,13 @@ private slots:
   void onGenerateReport();
   void onAutoTunePid();
   void onMonteCarlo();
+  void onMonteCarloFinished();
   void onVibrationCheck();
   void onFoulingHeatmap();
   void onRunLog();
   void onParameterChanged();
   void onGeometryDebounceTimeout();
-  void onSimulationSample(double t, const hx::State& state);
+  void onFrameTick();
   void onSimulationFinished();
   void onSimulationModeChanged(int index);
 
@@ -107,6 +114,8 @@ private:
   QDoubleSpinBox *spnDuration_{};
   QDoubleSpinBox *spnTimeStep_{};
   QComboBox *cmbSpeed_{};
+  QComboBox *cmbOverflow_{};
+  QLabel *lblSamples_{};
   QComboBox *cmbSimulationMode_{};
   QComboBox *cmbScenario_{};
 
@@ -144,6 +153,8 @@ private:
   QDoubleSpinBox *spnWallThickness_{};
   QComboBox *cmbFlowArrangement_{};
   QComboBox *cmbShellMethod_{};
+  QComboBox *cmbAxialIntegrator_{};
+  QComboBox *cmbLumpedIntegrator_{};
 
   // === FOULING PARAMETERS (LEFT PANEL) ===
   QDoubleSpinBox *spnRf0_{};
@@ -203,18 +214,37 @@ private:
   QThread *simThread_{};
   SimWorker *simWorker_{};
   SimulationMode simulationMode_{SimulationMode::DynamicFouling};
+  // Worker → GUI sample queue, drained by frameTimer_ once per display frame.
+  std::shared_ptr<hx::SampleRing> sampleRing_;
+  QTimer *frameTimer_{};
+  void drainSamples(size_t maxRecords);
+  /** Push frameBatch_ to the charts and KPI views as one frame. */
+  void renderSamples();
+  std::vector<std::pair<double, hx::State>> frameBatch_;  // this frame's samples, capacity reused
+  QList<QPointF> frameTcOut_;  // reused (t, Tc_out) batch for the spectrum tab
+  void updateSampleCounters();
   
   // === GEOMETRY UPDATE DEBOUNCING ===
   QTimer *geometryUpdateTimer_{};
   
   bool isRunning_{false};
   bool isPaused_{false};
-  std::vector<std::pair<double, hx::State>> simulationData_;  // For export
+  hx::TraceRecorder trace_;  // whole run, chunked and spilled to disk; feeds export / report / run log
 
   // Live per-tube fouling heatmap dialog (non-modal).  When open, simulation
   // samples push fresh FoulingMap snapshots through updateMap() so the user
   // sees fouling evolve in real time instead of a frozen t=0 picture.
   FoulingMapDialog *heatmapDlg_{};
-  int               heatmapSampleCounter_{0};
+  int               heatmapFrameCounter_{0};
+
+  // === BACKGROUND MONTE-CARLO ===
+  // One study at a time, on its own thread next to the simulation.  mcTimer_
+  // polls the worker's control block and feeds snapshots to mcDlg_, which is
+  // cleared when the user closes it (and then cancels the study).
+  QThread          *mcThread_{};
+  MonteCarloWorker *mcWorker_{};
+  MonteCarloDialog *mcDlg_{};
+  QTimer           *mcTimer_{};
+  int               mcSnapshotSerial_{0};
 };
 
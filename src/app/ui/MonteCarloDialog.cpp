@@ -7,6 +7,7 @@
 #include <QHeaderView>
 #include <QPushButton>
 #include <QLabel>
+#include <QProgressBar>
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QSplitter>
@@ -20,10 +21,14 @@
 #include <QtCharts/QHorizontalBarSeries>
 #include <QtCharts/QBarSet>
 #include <QtCharts/QBarCategoryAxis>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QLogValueAxis>
 #include <QtCharts/QValueAxis>
 
 #include <algorithm>
+#include <climits>
 #include <cmath>
+#include <limits>
 
 namespace {
 
@@ -66,6 +71,19 @@ HistogramBins makeHistogram(const std::vector<double> &data, int nBins) {
   return h;
 }
 
+/** Bins of the streaming histogram carried by \p stat (no per-trial data kept). */
+HistogramBins histogramFromStat(const hx::MonteCarloStat &stat) {
+  HistogramBins h;
+  const size_t n = stat.histCounts.size();
+  h.lo = stat.histLo;
+  h.hi = stat.histLo + stat.histBinWidth * static_cast<double>(n);
+  for (size_t i = 0; i < n; ++i) {
+    h.centers.push_back(stat.histLo + (static_cast<double>(i) + 0.5) * stat.histBinWidth);
+    h.counts.push_back(static_cast<int>(std::min<std::uint64_t>(stat.histCounts[i], INT_MAX)));
+  }
+  return h;
+}
+
 QChart *buildHistogramChart(const QString &title,
                             const QString &xUnit,
                             const std::vector<double> &data,
@@ -76,7 +94,7 @@ QChart *buildHistogramChart(const QString &title,
   chart->setAnimationOptions(QChart::NoAnimation);
 
   constexpr int kBins = 28;
-  const HistogramBins h = makeHistogram(data, kBins);
+  const HistogramBins h = data.empty() ? histogramFromStat(stat) : makeHistogram(data, kBins);
 
   auto *set = new QBarSet(QObject::tr("count"));
   set->setColor(QColor("#3498db"));
@@ -120,39 +138,161 @@ QChart *buildHistogramChart(const QString &title,
   return chart;
 }
 
+/** An estimate against trial count (log scale), dashed ±1.96·SE band around it. */
+QChart *buildConvergenceChart(const QString &title,
+                              const QString &yUnit,
+                              const std::vector<hx::MonteCarloConvergence> &points,
+                              double hx::MonteCarloConvergence::*value,
+                              double hx::MonteCarloConvergence::*se) {
+  auto *chart = new QChart();
+  chart->legend()->hide();
+  chart->setAnimationOptions(QChart::NoAnimation);
+
+  auto *estimate = new QLineSeries();
+  auto *lower    = new QLineSeries();
+  auto *upper    = new QLineSeries();
+  QPen bandPen(QColor("#95a5a6"));
+  bandPen.setStyle(Qt::DashLine);
+  estimate->setPen(QPen(QColor("#3498db"), 2.0));
+  lower->setPen(bandPen);
+  upper->setPen(bandPen);
+
+  double yLo = std::numeric_limits<double>::infinity();
+  double yHi = -yLo;
+  double xHi = 10.0;
+  for (const auto &p : points) {
+    const double x = static_cast<double>(p.trials);
+    const double y = p.*value;
+    const double half = 1.96 * p.*se;
+    estimate->append(x, y);
+    lower->append(x, y - half);
+    upper->append(x, y + half);
+    yLo = std::min(yLo, y - half);
+    yHi = std::max(yHi, y + half);
+    xHi = std::max(xHi, x);
+  }
+  chart->addSeries(upper);
+  chart->addSeries(lower);
+  chart->addSeries(estimate);
+
+  auto *axX = new QLogValueAxis();
+  axX->setBase(10.0);
+  axX->setRange(points.empty() ? 1.0 : std::max(1.0, 0.8 * points.front().trials), 1.25 * xHi);
+  axX->setLabelFormat("%g");
+  axX->setTitleText(QObject::tr("trials"));
+  chart->addAxis(axX, Qt::AlignBottom);
+
+  auto *axY = new QValueAxis();
+  if (std::isfinite(yLo) && std::isfinite(yHi)) {
+    const double pad = std::max(0.05 * (yHi - yLo), 1e-9 * std::fabs(yHi) + 1e-12);
+    axY->setRange(yLo - pad, yHi + pad);
+  }
+  axY->setTitleText(yUnit);
+  chart->addAxis(axY, Qt::AlignLeft);
+  for (auto *series : {upper, lower, estimate}) {
+    series->attachAxis(axX);
+    series->attachAxis(axY);
+  }
+
+  hx::MonteCarloConvergence last;
+  last.meanQ = last.seMeanQ = last.p95Q = last.seP95Q = std::numeric_limits<double>::quiet_NaN();
+  if (!points.empty()) last = points.back();
+  chart->setTitle(QStringLiteral("%1  —  %2 ± %3 (95 %) after %4 trials; dashed: 95 % band")
+                      .arg(title, fmtNum(last.*value, 5), fmtNum(1.96 * last.*se, 3))
+                      .arg(last.trials));
+  return chart;
+}
+
 } // namespace
 
 MonteCarloDialog::MonteCarloDialog(const hx::MonteCarloResult &result,
                                      QWidget *parent)
     : QDialog(parent), r_(result) {
-  setWindowTitle(QStringLiteral("Monte-Carlo Sensitivity — %1 trials").arg(r_.nTrials));
   resize(1100, 720);
 
   auto *mainLayout = new QVBoxLayout(this);
 
-  auto *summary = new QLabel(QString::fromStdString(r_.message), this);
-  summary->setWordWrap(true);
-  summary->setStyleSheet(QStringLiteral(
+  summary_ = new QLabel(this);
+  summary_->setWordWrap(true);
+  summary_->setStyleSheet(QStringLiteral(
       "QLabel{background:#f4f8fb;border-left:4px solid #3498db;"
       "padding:8px 12px;color:#2c3e50;font-size:10pt;}"));
-  mainLayout->addWidget(summary);
+  mainLayout->addWidget(summary_);
 
-  auto *tabs = new QTabWidget(this);
-  tabs->addTab(buildStatsTab(),     QStringLiteral("Summary statistics"));
-  tabs->addTab(buildHistogramTab(), QStringLiteral("Distributions"));
-  tabs->addTab(buildTornadoTab(),   QStringLiteral("Tornado"));
-  mainLayout->addWidget(tabs, 1);
+  tabs_ = new QTabWidget(this);
+  mainLayout->addWidget(tabs_, 1);
 
   auto *buttons = new QHBoxLayout();
-  auto *csvBtn  = new QPushButton(QStringLiteral("Save CSV..."), this);
-  auto *close   = new QPushButton(QStringLiteral("Close"), this);
-  buttons->addWidget(csvBtn);
+  progress_ = new QProgressBar(this);
+  progress_->setVisible(false);
+  stopBtn_  = new QPushButton(QStringLiteral("Stop"), this);
+  stopBtn_->setToolTip(QStringLiteral("Finish now and keep the trials summarised so far"));
+  stopBtn_->setVisible(false);
+  csvBtn_   = new QPushButton(QStringLiteral("Save CSV..."), this);
+  auto *close = new QPushButton(QStringLiteral("Close"), this);
+  buttons->addWidget(csvBtn_);
+  buttons->addWidget(progress_, 1);
+  buttons->addWidget(stopBtn_);
   buttons->addStretch(1);
   buttons->addWidget(close);
   mainLayout->addLayout(buttons);
 
-  connect(csvBtn, &QPushButton::clicked, this, &MonteCarloDialog::onSaveCsv);
-  connect(close,  &QPushButton::clicked, this, &QDialog::accept);
+  connect(csvBtn_,  &QPushButton::clicked, this, &MonteCarloDialog::onSaveCsv);
+  connect(stopBtn_, &QPushButton::clicked, this, [this]() {
+    stopBtn_->setEnabled(false);
+    stopBtn_->setText(QStringLiteral("Stopping..."));
+    emit stopRequested();
+  });
+  connect(close,    &QPushButton::clicked, this, &QDialog::accept);
+
+  rebuildTabs();
+}
+
+void MonteCarloDialog::updateResult(const hx::MonteCarloResult &result) {
+  r_ = result;
+  rebuildTabs();
+}
+
+void MonteCarloDialog::setProgress(int done, int total) {
+  progress_->setMaximum(std::max(1, total));
+  progress_->setValue(std::clamp(done, 0, progress_->maximum()));
+}
+
+void MonteCarloDialog::setRunning(bool running) {
+  running_ = running;
+  progress_->setVisible(running);
+  stopBtn_->setVisible(running);
+  stopBtn_->setEnabled(running);
+  stopBtn_->setText(QStringLiteral("Stop"));
+  updateHeader();
+}
+
+void MonteCarloDialog::updateHeader() {
+  setWindowTitle(running_ || r_.partial
+                     ? QStringLiteral("Monte-Carlo Sensitivity — %1 of %2 trials")
+                           .arg(r_.nTrials).arg(r_.nTrialsPlanned)
+                     : QStringLiteral("Monte-Carlo Sensitivity — %1 trials").arg(r_.nTrials));
+  summary_->setText(QString::fromStdString(r_.message));
+  csvBtn_->setEnabled(!running_ && !r_.Q.empty());
+}
+
+void MonteCarloDialog::rebuildTabs() {
+  updateHeader();
+
+  // Charts are rebuilt rather than patched: a snapshot arrives a few times a
+  // second at most, and rebuilding keeps one code path for live and final.
+  const int current = tabs_->currentIndex();
+  while (tabs_->count() > 0) {
+    QWidget *page = tabs_->widget(0);
+    tabs_->removeTab(0);
+    page->deleteLater();
+  }
+  tabs_->addTab(buildStatsTab(),       QStringLiteral("Summary statistics"));
+  tabs_->addTab(buildHistogramTab(),   QStringLiteral("Distributions"));
+  tabs_->addTab(buildConvergenceTab(), QStringLiteral("Convergence"));
+  tabs_->addTab(buildTornadoTab(),     QStringLiteral("Tornado"));
+  tabs_->addTab(buildSobolTab(),       QStringLiteral("Sobol' indices"));
+  if (current >= 0) tabs_->setCurrentIndex(current);
 }
 
 QWidget *MonteCarloDialog::buildStatsTab() {
@@ -172,7 +312,10 @@ QWidget *MonteCarloDialog::buildStatsTab() {
                                 QStringLiteral("p5"),
                                 QStringLiteral("p50"),
                                 QStringLiteral("p95"),
-                                QStringLiteral("Max")};
+                                QStringLiteral("Max"),
+                                QStringLiteral("SE mean"),
+                                QStringLiteral("SE p5"),
+                                QStringLiteral("SE p95")};
 
   table->setRowCount(rows.size());
   table->setColumnCount(columns.size());
@@ -188,7 +331,8 @@ QWidget *MonteCarloDialog::buildStatsTab() {
       &r_.statQ, &r_.statU, &r_.statTc, &r_.statEps, &r_.statDPt, &r_.statDPs};
   for (int i = 0; i < rows.size(); ++i) {
     const auto &s = *stats[i];
-    const double vals[] = {s.mean, s.stddev, s.minv, s.p5, s.p50, s.p95, s.maxv};
+    const double vals[] = {s.mean, s.stddev, s.minv, s.p5, s.p50, s.p95, s.maxv,
+                           s.seMean, s.seP5, s.seP95};
     for (int j = 0; j < columns.size(); ++j) {
       auto *item = new QTableWidgetItem(fmtNum(vals[j], 5));
       item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
@@ -198,12 +342,15 @@ QWidget *MonteCarloDialog::buildStatsTab() {
   vb->addWidget(table);
 
   auto *note = new QLabel(
-      QStringLiteral("<i>%1 Monte-Carlo trials with σ applied to flows, "
-                     "inlet temperatures, fluid properties%2. Baseline heat "
-                     "duty Q₀ = %3 W, baseline U₀ = %4 W/m²·K.</i>")
+      QStringLiteral("<i>%1 trials (%2 sampling, %3) with σ applied to flows, "
+                     "inlet temperatures, fluid properties%4. Standard errors "
+                     "from %5 independent replicates. Baseline heat "
+                     "duty Q₀ = %6 W, baseline U₀ = %7 W/m²·K.</i>")
           .arg(r_.nTrials)
-          .arg(r_.tornado.empty() ? QStringLiteral("")
-                                   : QStringLiteral(", and fouling asymptote"))
+          .arg(QString::fromUtf8(hx::samplingStrategyName(r_.sampling)))
+          .arg(QString::fromUtf8(hx::trialSolverName(r_.solver)))
+          .arg(r_.includeFouling ? QStringLiteral(", and fouling asymptote") : QStringLiteral(""))
+          .arg(r_.replicates)
           .arg(fmtNum(r_.baselineQ, 5))
           .arg(fmtNum(r_.baselineU, 5)),
       w);
@@ -248,13 +395,46 @@ QWidget *MonteCarloDialog::buildHistogramTab() {
   return w;
 }
 
+QWidget *MonteCarloDialog::buildConvergenceTab() {
+  auto *w = new QWidget(this);
+  auto *vb = new QVBoxLayout(w);
+
+  auto *splitter = new QSplitter(Qt::Vertical, w);
+  auto *viewMean = new QChartView(
+      buildConvergenceChart(QStringLiteral("Mean heat duty"), QStringLiteral("Q [W]"),
+                            r_.convergence, &hx::MonteCarloConvergence::meanQ,
+                            &hx::MonteCarloConvergence::seMeanQ),
+      splitter);
+  viewMean->setRenderHint(QPainter::Antialiasing);
+  splitter->addWidget(viewMean);
+  auto *viewP95 = new QChartView(
+      buildConvergenceChart(QStringLiteral("95th-percentile heat duty"), QStringLiteral("Q [W]"),
+                            r_.convergence, &hx::MonteCarloConvergence::p95Q,
+                            &hx::MonteCarloConvergence::seP95Q),
+      splitter);
+  viewP95->setRenderHint(QPainter::Antialiasing);
+  splitter->addWidget(viewP95);
+  vb->addWidget(splitter);
+
+  auto *note = new QLabel(
+      QStringLiteral("<i>Estimates over the first n trials, recorded each time the "
+                     "summarised ensemble grows by a fifth. The band narrows as "
+                     "1/√n for plain Monte-Carlo and faster for the stratified "
+                     "and low-discrepancy designs; stop once it is as narrow as "
+                     "the decision needs.</i>"), w);
+  note->setWordWrap(true);
+  note->setStyleSheet(QStringLiteral("color:#566573;padding:4px 8px;"));
+  vb->addWidget(note);
+  return w;
+}
+
 QWidget *MonteCarloDialog::buildTornadoTab() {
   auto *w  = new QWidget(this);
   auto *vb = new QVBoxLayout(w);
 
   auto *chart = new QChart();
   chart->setTitle(QStringLiteral(
-      "Sensitivity of heat duty Q to ±1σ perturbation of each input "
+      "Share of σ(Q) due to each input, σ(Q)·√Sₜ "
       "(sorted by magnitude; baseline Q₀ = %1 W)").arg(fmtNum(r_.baselineQ, 4)));
   chart->setAnimationOptions(QChart::NoAnimation);
 
@@ -293,7 +473,7 @@ QWidget *MonteCarloDialog::buildTornadoTab() {
   if (mx < 1e-9) mx = 1.0;
   auto *axX = new QValueAxis();
   axX->setRange(-1.15 * mx, 1.15 * mx);
-  axX->setTitleText(QStringLiteral("ΔQ from baseline [W]"));
+  axX->setTitleText(QStringLiteral("±1σ-equivalent ΔQ [W]"));
   axX->setLabelFormat("%.0f");
   chart->addAxis(axX, Qt::AlignBottom);
   series->attachAxis(axX);
@@ -303,11 +483,76 @@ QWidget *MonteCarloDialog::buildTornadoTab() {
   vb->addWidget(view);
 
   auto *note = new QLabel(
-      QStringLiteral("<i>Each row shows ΔQ when the named parameter is "
-                     "displaced by one standard deviation (all other "
-                     "parameters held at nominal). Longer bars ⇒ "
+      QStringLiteral("<i>Each bar is σ(Q)·√Sₜ, the part of the heat-duty "
+                     "spread the named input accounts for, interactions "
+                     "included (%1 Saltelli base samples). For a linear "
+                     "response it equals the ΔQ of a ±1σ displacement; the "
+                     "bar's side gives the direction. Longer bars ⇒ "
                      "heat-transfer performance is more sensitive to that "
-                     "input.</i>"), w);
+                     "input.</i>").arg(r_.sobolSamples), w);
+  note->setWordWrap(true);
+  note->setStyleSheet(QStringLiteral("color:#566573;padding:4px 8px;"));
+  vb->addWidget(note);
+  return w;
+}
+
+QWidget *MonteCarloDialog::buildSobolTab() {
+  auto *w  = new QWidget(this);
+  auto *vb = new QVBoxLayout(w);
+
+  const bool withCi = r_.bootstrapResamples > 0;
+  QStringList columns;
+  for (const auto &si : r_.sobol) {
+    const QString name = QString::fromStdString(si.output);
+    columns << QStringLiteral("S₁ %1").arg(name) << QStringLiteral("Sₜ %1").arg(name);
+  }
+  QStringList rows;
+  for (const auto &name : r_.paramNames) rows << QString::fromStdString(name);
+
+  auto *table = new QTableWidget(w);
+  table->setRowCount(rows.size());
+  table->setColumnCount(columns.size());
+  table->setHorizontalHeaderLabels(columns);
+  table->setVerticalHeaderLabels(rows);
+  table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+  table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  table->setSelectionMode(QAbstractItemView::NoSelection);
+  table->setAlternatingRowColors(true);
+
+  auto cell = [withCi](double v, double lo, double hi) {
+    return withCi ? QStringLiteral("%1 [%2, %3]").arg(fmtNum(v, 2), fmtNum(lo, 2), fmtNum(hi, 2))
+                  : fmtNum(v, 3);
+  };
+  for (int c = 0; c < static_cast<int>(r_.sobol.size()); ++c) {
+    const auto &si = r_.sobol[static_cast<size_t>(c)];
+    for (int i = 0; i < static_cast<int>(si.index.size()) && i < rows.size(); ++i) {
+      const auto &x = si.index[static_cast<size_t>(i)];
+      auto *first = new QTableWidgetItem(cell(x.first, x.firstLo, x.firstHi));
+      auto *total = new QTableWidgetItem(cell(x.total, x.totalLo, x.totalHi));
+      first->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+      total->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+      table->setItem(i, 2 * c,     first);
+      table->setItem(i, 2 * c + 1, total);
+    }
+  }
+  vb->addWidget(table);
+
+  auto *note = new QLabel(
+      r_.sobol.empty() && r_.partial
+          ? QStringLiteral("<i>Sobol' indices are computed once every trial, the "
+                           "Saltelli trials included, has finished.</i>")
+      : r_.sobol.empty()
+          ? QStringLiteral("<i>Sensitivity analysis was skipped (no Saltelli base samples).</i>")
+          : QStringLiteral("<i>S₁: share of the output variance due to the input "
+                           "alone (Saltelli 2010); Sₜ: share including all its "
+                           "interactions (Jansen). Sₜ − S₁ measures interactions. "
+                           "N = %1 base samples, %2 extra trials%3.</i>")
+                .arg(r_.sobolSamples)
+                .arg(r_.sobolSamples * (static_cast<int>(r_.paramNames.size()) + 1))
+                .arg(withCi ? QStringLiteral("; brackets: 95 % bootstrap interval from %1 resamples")
+                                  .arg(r_.bootstrapResamples)
+                            : QString()),
+      w);
   note->setWordWrap(true);
   note->setStyleSheet(QStringLiteral("color:#566573;padding:4px 8px;"));
   vb->addWidget(note);
@@ -331,7 +576,7 @@ void MonteCarloDialog::onSaveCsv() {
   out.setEncoding(QStringConverter::Utf8);
 
   out << "trial,Q_W,U_Wm2K,Tc_out_C,Th_out_C,dP_tube_Pa,dP_shell_Pa,eps,NTU\n";
-  for (int i = 0; i < r_.nTrials; ++i) {
+  for (int i = 0; i < static_cast<int>(r_.Q.size()); ++i) {
     out << i
         << ',' << r_.Q[i]
         << ',' << r_.U[i]
@@ -343,7 +588,17 @@ void MonteCarloDialog::onSaveCsv() {
         << ',' << r_.NTU[i]
         << '\n';
   }
-  out << "\n# Tornado sensitivity (ΔQ at ±1σ per parameter):\n";
+  out << "\n# Sobol' indices (parameter,output,S1,S1_lo,S1_hi,ST,ST_lo,ST_hi):\n";
+  for (const auto &si : r_.sobol) {
+    for (size_t i = 0; i < si.index.size() && i < r_.paramNames.size(); ++i) {
+      const auto &x = si.index[i];
+      out << "# " << QString::fromStdString(r_.paramNames[i])
+          << ',' << QString::fromStdString(si.output)
+          << ',' << x.first << ',' << x.firstLo << ',' << x.firstHi
+          << ',' << x.total << ',' << x.totalLo << ',' << x.totalHi << '\n';
+    }
+  }
+  out << "\n# Tornado sensitivity (σ(Q)·√ST per parameter, signed):\n";
   out << "# parameter,deltaPlus_W,deltaMinus_W,sensitivity_W\n";
   for (const auto &e : r_.tornado) {
     out << "# " << QString::fromStdString(e.name)
@@ -352,5 +607,8 @@ void MonteCarloDialog::onSaveCsv() {
         << ',' << e.sensitivity
         << '\n';
   }
+  out << "# sampling: " << QString::fromUtf8(hx::samplingStrategyName(r_.sampling))
+      << ", replicates: " << r_.replicates
+      << ", trials: " << QString::fromUtf8(hx::trialSolverName(r_.solver)) << '\n';
   file.close();
 }
@@ -3,16 +3,25 @@
 #include <QDialog>
 #include "core/MonteCarlo.hpp"
 
+class QLabel;
+class QProgressBar;
+class QPushButton;
+class QTabWidget;
 class QTableWidget;
 
 /**
- * \brief Read-only Monte-Carlo results viewer.
+ * \brief Monte-Carlo results viewer, live while the study runs.
  *
  *   Tab 1 — summary statistics (mean / stddev / percentiles) of all KPIs.
  *   Tab 2 — histograms (Q, U, ε).
- *   Tab 3 — tornado chart of ∂Q/∂param sensitivities.
+ *   Tab 3 — convergence of mean Q and p95 Q with their 95 % bands.
+ *   Tab 4 — tornado chart of each input's share of σ_Q.
+ *   Tab 5 — first-order / total-effect Sobol' indices of all outputs.
  *
- * The dialog also offers CSV export of the raw per-trial vectors.
+ * While a study runs the owner feeds partial results through updateResult()
+ * and progress through setProgress(); Stop emits stopRequested().  Once
+ * setRunning(false) is called the dialog is a plain viewer that also offers
+ * CSV export of the raw per-trial vectors.
  */
 class MonteCarloDialog : public QDialog {
   Q_OBJECT
@@ -20,13 +29,32 @@ public:
   explicit MonteCarloDialog(const hx::MonteCarloResult &result,
                              QWidget *parent = nullptr);
 
+  /** Show \p result (rebuilding every tab, keeping the current one). */
+  void updateResult(const hx::MonteCarloResult &result);
+  void setProgress(int done, int total);
+  void setRunning(bool running);
+  [[nodiscard]] bool isRunning() const { return running_; }
+
+signals:
+  void stopRequested();
+
 private slots:
   void onSaveCsv();
 
 private:
+  void updateHeader();
+  void rebuildTabs();
   QWidget *buildStatsTab();
   QWidget *buildHistogramTab();
+  QWidget *buildConvergenceTab();
   QWidget *buildTornadoTab();
+  QWidget *buildSobolTab();
 
   hx::MonteCarloResult r_;
+  bool running_{false};
+  QLabel *summary_{};
+  QTabWidget *tabs_{};
+  QProgressBar *progress_{};
+  QPushButton *stopBtn_{};
+  QPushButton *csvBtn_{};
 };
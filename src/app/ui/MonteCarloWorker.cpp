@@ -0,0 +1,12 @@
+#include "MonteCarloWorker.hpp"
+
+MonteCarloWorker::MonteCarloWorker(const hx::OperatingPoint &op, const hx::Geometry &geom,
+                                   const hx::Fluid &hot, const hx::Fluid &cold,
+                                   const hx::FoulingParams &fp, const hx::SimConfig &cfg,
+                                   const hx::MonteCarloSettings &mc, QObject *parent)
+    : QObject(parent), op_(op), geom_(geom), hot_(hot), cold_(cold), fp_(fp), cfg_(cfg), mc_(mc) {}
+
+void MonteCarloWorker::run() {
+  result_ = hx::runMonteCarlo(op_, geom_, hot_, cold_, fp_, cfg_, mc_, {}, &control_);
+  emit finished();
+}
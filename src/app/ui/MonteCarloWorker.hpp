@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QObject>
+#include "core/MonteCarlo.hpp"
+#include "core/Types.hpp"
+
+/**
+ * @brief Background worker for a Monte-Carlo study
+ * Runs hx::runMonteCarlo() in its own thread (which fans out to a worker pool)
+ *
+ * Nothing but finished() is signalled: the GUI polls control() for progress
+ * and the latest partial-result snapshot, and uses it to stop or cancel the
+ * study.  The inputs are copies, so the live simulation and the UI can carry
+ * on changing while the study runs.
+ */
+class MonteCarloWorker : public QObject {
+  Q_OBJECT
+
+public:
+  MonteCarloWorker(const hx::OperatingPoint &op, const hx::Geometry &geom,
+                   const hx::Fluid &hot, const hx::Fluid &cold,
+                   const hx::FoulingParams &fp, const hx::SimConfig &cfg,
+                   const hx::MonteCarloSettings &mc, QObject *parent = nullptr);
+
+  /** Progress, stop / cancel and snapshots; safe from any thread. */
+  hx::MonteCarloControl &control() { return control_; }
+  /** Final result; valid once finished() has been emitted. */
+  const hx::MonteCarloResult &result() const { return result_; }
+
+public slots:
+  void run();
+
+signals:
+  void finished();
+
+private:
+  hx::OperatingPoint op_;
+  hx::Geometry geom_;
+  hx::Fluid hot_;
+  hx::Fluid cold_;
+  hx::FoulingParams fp_;
+  hx::SimConfig cfg_;
+  hx::MonteCarloSettings mc_;
+  hx::MonteCarloControl control_;
+  hx::MonteCarloResult result_;
+};
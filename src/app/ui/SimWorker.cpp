@@ -1,7 +1,7 @@
 #include "SimWorker.hpp"
-#include <QThread>
 #include <algorithm>
-#include <cmath>
+#include <chrono>
+#include <thread>
 
 SimWorker::SimWorker(QObject *parent) : QObject(parent) {}
 
@@ -11,7 +11,7 @@ void SimWorker::setSimulator(std::unique_ptr<hx::Simulator> sim, const hx::SimCo
 }
 
 void SimWorker::run() {
-  if (!simulator_) {
+  if (!simulator_ || !ring_) {
     emit finished();
     return;
   }
@@ -20,55 +20,67 @@ void SimWorker::run() {
   const double dt = config_.dt;
   const double tEnd = config_.tEnd;
 
+  using Clock = std::chrono::steady_clock;
+  // Real-time pacing against the wall clock: simulated time t is due at
+  // start + t / speed.  The worker only sleeps when it is more than a couple
+  // of milliseconds ahead, so short dt at high speed costs no per-step
+  // sleeps; speed 0 never sleeps.  Samples are pushed on every step — the
+  // ring and the GUI's frame timer, not this loop, decide the display rate.
+  const bool paced = speedMultiplier_ > 0;
+  const double wallPerSim = paced ? 1.0 / speedMultiplier_ : 0.0;
+  const auto start = Clock::now();
+  constexpr auto kMinSleep = std::chrono::milliseconds(2);
+  constexpr auto kProfileInterval = std::chrono::milliseconds(33);
+  auto lastProfile = start - kProfileInterval;
+
   double t = 0.0;
   int lastPercent = 0;
-
-  // Real-time pacing: each simulated dt should take dt·1000/speed ms in wall
-  // time.  At high speed × small dt the ideal delay collapses to <5 ms,
-  // which would push 200+ Hz sampleReady signals at the UI thread and make
-  // the charts / KPIs / exchanger widget unresponsive (and eventually blow
-  // out the event queue).
-  const double idealDelayMs = (dt * 1000.0) / std::max(1, speedMultiplier_);
-
-  // UI-emit cap: never fire sampleReady more than ~50 Hz (20 ms gap).  When
-  // the ideal delay is below that we batch multiple simulation steps into a
-  // single sleep+emit, so wall-clock pacing is preserved while the UI gets
-  // a sane update rate.
-  constexpr int  kMinEmitMs      = 20;
-  const int      stepsPerEmit    = (idealDelayMs < kMinEmitMs)
-                                     ? std::max(1, static_cast<int>(std::ceil(kMinEmitMs / std::max(idealDelayMs, 0.1))))
-                                     : 1;
-  const int      delayMs         = std::max(1,
-                                     static_cast<int>(idealDelayMs * stepsPerEmit));
-
-  int stepCounter = 0;
-  hx::State lastState{};
+  double lastT = 0.0;
+  bool any = false;
   while (t < tEnd && !stopRequested_) {
-    lastState = simulator_->step(t);
-    t += dt;
-    ++stepCounter;
+    const hx::State &s = simulator_->step(t);
+    ring_->push({t, s});
+    lastT = t;
+    any = true;
 
-    // Batch emit: only notify the UI every `stepsPerEmit` simulator steps.
-    if (stepCounter >= stepsPerEmit) {
-      emit sampleReady(t - dt, lastState);
-      stepCounter = 0;
+    const auto now = Clock::now();
+    if (profilesWanted_ && now - lastProfile >= kProfileInterval) {
+      emitProfile(t);
+      lastProfile = now;
+    }
 
-      int percent = static_cast<int>((t / tEnd) * 100.0);
-      if (percent != lastPercent) {
-        emit progress(percent);
-        lastPercent = percent;
-      }
+    t += dt;
+    const int percent = static_cast<int>((t / tEnd) * 100.0);
+    if (percent != lastPercent) {
+      emit progress(percent);
+      lastPercent = percent;
+    }
 
-      QThread::msleep(static_cast<unsigned long>(delayMs));
+    if (paced) {
+      const auto due = start + std::chrono::duration_cast<Clock::duration>(
+                                   std::chrono::duration<double>(t * wallPerSim));
+      if (due - now > kMinSleep) std::this_thread::sleep_until(due);
     }
   }
 
-  // Final sample if the last batch didn't align exactly.
-  if (stepCounter > 0) emit sampleReady(t - dt, lastState);
+  // Deliver a sample still held back by the Decimate policy, and the final
+  // profile (the simulator's cells still hold it: no step() since).
+  ring_->flush();
+  if (any && profilesWanted_) emitProfile(lastT);
 
   emit finished();
 }
 
+// The profile views borrow the simulator's cell arrays, which the next
+// step() overwrites on this thread, so subscribers get an owned copy.
+void SimWorker::emitProfile(double t) {
+  const hx::ProfileView Th = simulator_->axialTh();
+  const hx::ProfileView Tc = simulator_->axialTc();
+  if (Th.empty()) return;
+  emit profileReady(t, QVector<double>(Th.begin(), Th.end()), QVector<double>(Tc.begin(), Tc.end()));
+}
+
 void SimWorker::stop() {
   stopRequested_ = true;
+  if (ring_) ring_->close();
 }
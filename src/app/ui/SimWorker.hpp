@@ -1,35 +1,54 @@
 #pragma once
 
 #include <QObject>
+#include <QVector>
+#include <atomic>
 #include <memory>
+#include "core/SampleRing.hpp"
 #include "core/Simulator.hpp"
 #include "core/Types.hpp"
 
 /**
  * @brief Background worker for running simulation
  * Runs in separate thread to keep UI responsive
+ *
+ * Samples are not signalled one by one: every step is written to a
+ * hx::SampleRing that the GUI drains once per frame, so the simulator never
+ * waits on (or floods) the event loop.  Only progress, the occasional axial
+ * profile and finished() go through queued signals.
  */
 class SimWorker : public QObject {
   Q_OBJECT
 
 public:
   explicit SimWorker(QObject *parent = nullptr);
-  
+
   void setSimulator(std::unique_ptr<hx::Simulator> sim, const hx::SimConfig& config);
+  /** Sample destination; must be set before run(). */
+  void setSampleRing(std::shared_ptr<hx::SampleRing> ring) { ring_ = std::move(ring); }
+  /** Simulated seconds per wall second; 0 = as fast as possible (no pacing). */
   void setSpeedMultiplier(int speed) { speedMultiplier_ = speed; }
+  /** Opt in to profileReady() (axial runs only). */
+  void setProfileSubscription(bool enabled) { profilesWanted_ = enabled; }
 
 public slots:
   void run();
+  /** Thread-safe; also releases a producer waiting on a full ring. */
   void stop();
 
 signals:
-  void sampleReady(double t, hx::State state);
+  /** Axial profile copy, at most ~30 Hz of wall time, emitted only when subscribed. */
+  void profileReady(double t, QVector<double> Th, QVector<double> Tc);
   void finished();
   void progress(int percent);
 
 private:
   std::unique_ptr<hx::Simulator> simulator_;
+  std::shared_ptr<hx::SampleRing> ring_;
   hx::SimConfig config_{};
-  bool stopRequested_{false};
-  int speedMultiplier_{1};  // 1x = real-time, 100x = 100x faster
+  std::atomic<bool> stopRequested_{false};
+  int speedMultiplier_{1};  // 1x = real-time, 100x = 100x faster, 0 = unpaced
+  bool profilesWanted_{false};
+
+  void emitProfile(double t);
 };
@@ -94,6 +94,16 @@ void SpectrumWidget::clear() {
 }
 
 void SpectrumWidget::addSample(double t, double Tc_out) {
+  push(t, Tc_out);
+  maybeRecompute();
+}
+
+void SpectrumWidget::addSamples(const QList<QPointF> &samples) {
+  for (const QPointF &p : samples) push(p.x(), p.y());
+  maybeRecompute();
+}
+
+void SpectrumWidget::push(double t, double Tc_out) {
   // Estimate sample interval from successive arrival times.  Use the
   // running estimate (not an average) so step-changes in dt are tracked
   // instantly.
@@ -107,7 +117,9 @@ void SpectrumWidget::addSample(double t, double Tc_out) {
   writeIdx_ = (writeIdx_ + 1) % kWindow;
   if (filled_ < kWindow) ++filled_;
   ++stepsSinceFft_;
+}
 
+void SpectrumWidget::maybeRecompute() {
   if (stepsSinceFft_ >= kRecomputeEvery &&
       filled_ >= static_cast<int>(kMinFilled * kWindow)) {
     recomputeSpectrum();
@@ -7,6 +7,8 @@
 #include <QtCharts/QValueAxis>
 #include <QtCharts/QLogValueAxis>
 #include <QLabel>
+#include <QList>
+#include <QPointF>
 #include <complex>
 #include <vector>
 
@@ -28,6 +30,8 @@ class SpectrumWidget : public QWidget {
 
   /** Push the latest T_c,out sample.  Time is used to estimate dt. */
   void addSample(double t, double Tc_out);
+  /** Push a frame's worth of (t, T_c,out) samples; the spectrum is recomputed at most once. */
+  void addSamples(const QList<QPointF> &samples);
 
   /** Throw away the buffer and blank the chart. */
   void clear();
@@ -36,6 +40,8 @@ class SpectrumWidget : public QWidget {
   int  windowSize() const { return static_cast<int>(buf_.size()); }
 
  private:
+  void push(double t, double Tc_out);
+  void maybeRecompute();
   void recomputeSpectrum();
   static void fftRadix2(std::vector<std::complex<double>> &a);
 
@@ -0,0 +1,300 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+// -----------------------------------------------------------------------------
+//  Global allocation accounting.  Every operator new / new[] form, aligned
+//  included, is replaced.  On glibc malloc / calloc / realloc / free are
+//  interposed as well, which catches allocators that bypass operator new
+//  (Eigen's dynamic matrices use std::malloc); elsewhere those are not seen
+//  and mallocCounted() is false.
+// -----------------------------------------------------------------------------
+#if defined(__GLIBC__)
+#define HX_BENCH_COUNT_MALLOC 1
+extern "C" {
+void *__libc_malloc(std::size_t);
+void *__libc_calloc(std::size_t, std::size_t);
+void *__libc_realloc(void *, std::size_t);
+void *__libc_memalign(std::size_t, std::size_t);
+void  __libc_free(void *);
+}
+#elif defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace {
+std::atomic<std::uint64_t> g_allocCount{0};
+std::atomic<std::uint64_t> g_allocBytes{0};
+volatile double g_sink = 0.0;
+
+void countAlloc(std::size_t n) {
+  g_allocCount.fetch_add(1, std::memory_order_relaxed);
+  g_allocBytes.fetch_add(n, std::memory_order_relaxed);
+}
+
+void *countedAlloc(std::size_t n) {
+  countAlloc(n);
+#ifdef HX_BENCH_COUNT_MALLOC
+  return __libc_malloc(n == 0 ? 1 : n);
+#else
+  return std::malloc(n == 0 ? 1 : n);
+#endif
+}
+
+void *countedAlignedAlloc(std::size_t n, std::align_val_t al) {
+  countAlloc(n);
+  const std::size_t a = static_cast<std::size_t>(al);
+  if (n == 0) n = 1;
+#if defined(HX_BENCH_COUNT_MALLOC)
+  return __libc_memalign(a, n);
+#elif defined(_WIN32)
+  return _aligned_malloc(n, a);
+#else
+  void *p = nullptr;
+  return posix_memalign(&p, std::max(a, sizeof(void *)), n) == 0 ? p : nullptr;
+#endif
+}
+
+void alignedFree(void *p) {
+#if defined(_WIN32) && !defined(HX_BENCH_COUNT_MALLOC)
+  _aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+} // anonymous namespace
+
+#ifdef HX_BENCH_COUNT_MALLOC
+extern "C" {
+void *malloc(std::size_t n) { return countedAlloc(n); }
+void *calloc(std::size_t n, std::size_t size) {
+  countAlloc(n * size);
+  return __libc_calloc(n, size);
+}
+void *realloc(void *p, std::size_t n) {
+  if (n != 0) countAlloc(n);   // realloc(p, 0) frees
+  return __libc_realloc(p, n);
+}
+void free(void *p) { __libc_free(p); }
+}
+#endif
+
+void *operator new(std::size_t n) {
+  if (void *p = countedAlloc(n)) return p;
+  throw std::bad_alloc();
+}
+void *operator new[](std::size_t n) {
+  if (void *p = countedAlloc(n)) return p;
+  throw std::bad_alloc();
+}
+void *operator new(std::size_t n, const std::nothrow_t &) noexcept { return countedAlloc(n); }
+void *operator new[](std::size_t n, const std::nothrow_t &) noexcept { return countedAlloc(n); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+void *operator new(std::size_t n, std::align_val_t a) {
+  if (void *p = countedAlignedAlloc(n, a)) return p;
+  throw std::bad_alloc();
+}
+void *operator new[](std::size_t n, std::align_val_t a) {
+  if (void *p = countedAlignedAlloc(n, a)) return p;
+  throw std::bad_alloc();
+}
+void *operator new(std::size_t n, std::align_val_t a, const std::nothrow_t &) noexcept {
+  return countedAlignedAlloc(n, a);
+}
+void *operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t &) noexcept {
+  return countedAlignedAlloc(n, a);
+}
+void operator delete(void *p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+
+namespace bench {
+
+std::uint64_t allocCount() { return g_allocCount.load(std::memory_order_relaxed); }
+std::uint64_t allocBytes() { return g_allocBytes.load(std::memory_order_relaxed); }
+
+bool mallocCounted() {
+#ifdef HX_BENCH_COUNT_MALLOC
+  return true;
+#else
+  return false;
+#endif
+}
+
+void doNotOptimize(double v) { g_sink = v; }
+
+Result run(const Case &c, double minTime, int repetitions) {
+  using clock = std::chrono::steady_clock;
+  if (c.setup) c.setup();
+
+  // Calibrate: grow the batch until it takes at least minTime.
+  std::uint64_t iters = 1;
+  for (;;) {
+    const auto t0 = clock::now();
+    for (std::uint64_t i = 0; i < iters; ++i) c.op();
+    const double el = std::chrono::duration<double>(clock::now() - t0).count();
+    if (el >= minTime || iters >= (1ull << 40)) break;
+    const double grow = (el > 1e-9) ? std::min(10.0, 1.4 * minTime / el) : 10.0;
+    iters = std::max(iters + 1, static_cast<std::uint64_t>(static_cast<double>(iters) * grow));
+  }
+
+  Result r;
+  r.group = c.group;
+  r.name  = c.name;
+  r.param = c.param;
+  r.iterations = iters;
+  r.nsPerOp = std::numeric_limits<double>::infinity();
+  for (int rep = 0; rep < std::max(1, repetitions); ++rep) {
+    const std::uint64_t a0 = allocCount();
+    const std::uint64_t b0 = allocBytes();
+    const auto t0 = clock::now();
+    for (std::uint64_t i = 0; i < iters; ++i) c.op();
+    const double el = std::chrono::duration<double>(clock::now() - t0).count();
+    const double n = static_cast<double>(iters);
+    r.nsPerOp     = std::min(r.nsPerOp, el * 1e9 / n);
+    r.allocsPerOp = static_cast<double>(allocCount() - a0) / n;
+    r.bytesPerOp  = static_cast<double>(allocBytes() - b0) / n;
+  }
+  if (c.usesMalloc && !mallocCounted()) {
+    // Part of the heap traffic would be missed: report "not measured".
+    r.allocsPerOp = std::numeric_limits<double>::quiet_NaN();
+    r.bytesPerOp  = std::numeric_limits<double>::quiet_NaN();
+  }
+  if (c.metric) {
+    r.metricName = c.metricName;
+    r.metric     = c.metric();
+  }
+  return r;
+}
+
+namespace {
+
+std::string fmtNumber(double v) {
+  if (!std::isfinite(v)) return "null";
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), "%.9g", v);
+  return buf;
+}
+
+/** \p s as a JSON string body: quotes, backslashes and control characters escaped. */
+std::string jsonEscape(const std::string &s) {
+  std::string out;
+  out.reserve(s.size());
+  for (const char ch : s) {
+    switch (ch) {
+      case '"':  out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\t': out += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(ch) < 0x20) {
+          char buf[8];
+          std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(ch)));
+          out += buf;
+        } else {
+          out += ch;
+        }
+    }
+  }
+  return out;
+}
+
+/** Inverse of jsonEscape() for the escapes it produces. */
+std::string jsonUnescape(const std::string &s) {
+  std::string out;
+  out.reserve(s.size());
+  for (size_t i = 0; i < s.size(); ++i) {
+    if (s[i] != '\\' || i + 1 == s.size()) { out += s[i]; continue; }
+    const char e = s[++i];
+    if (e == 'n') out += '\n';
+    else if (e == 't') out += '\t';
+    else if (e == 'u' && i + 4 < s.size()) {
+      out += static_cast<char>(std::strtol(s.substr(i + 1, 4).c_str(), nullptr, 16));
+      i += 4;
+    } else out += e;
+  }
+  return out;
+}
+
+/** Extract `"key": value` from one serialised result line. */
+bool findField(const std::string &line, const char *key, std::string &out) {
+  const std::string needle = std::string("\"") + key + "\":";
+  const size_t k = line.find(needle);
+  if (k == std::string::npos) return false;
+  size_t i = k + needle.size();
+  while (i < line.size() && line[i] == ' ') ++i;
+  if (i < line.size() && line[i] == '"') {
+    size_t e = i + 1;
+    while (e < line.size() && line[e] != '"') e += (line[e] == '\\') ? 2u : 1u;
+    if (e >= line.size()) return false;
+    out = jsonUnescape(line.substr(i + 1, e - i - 1));
+  } else {
+    size_t e = i;
+    while (e < line.size() && line[e] != ',' && line[e] != '}') ++e;
+    out = line.substr(i, e - i);
+  }
+  return true;
+}
+
+double toNumber(const std::string &s) {
+  if (s == "null") return std::numeric_limits<double>::quiet_NaN();
+  return std::strtod(s.c_str(), nullptr);
+}
+
+} // anonymous namespace
+
+bool writeJson(const std::string &path, const std::vector<Result> &results) {
+  std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+  if (!ofs) return false;
+  ofs << "{\n  \"format\": \"heatxtwin-bench-1\",\n  \"results\": [\n";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result &r = results[i];
+    ofs << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"group\": \"" << jsonEscape(r.group) << "\""
+        << ", \"param\": " << fmtNumber(r.param)
+        << ", \"ns_per_op\": " << fmtNumber(r.nsPerOp)
+        << ", \"allocs_per_op\": " << fmtNumber(r.allocsPerOp)
+        << ", \"bytes_per_op\": " << fmtNumber(r.bytesPerOp)
+        << ", \"iterations\": " << r.iterations
+        << ", \"metric_name\": \"" << jsonEscape(r.metricName) << "\""
+        << ", \"metric\": " << fmtNumber(r.metric) << "}"
+        << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  ofs << "  ]\n}\n";
+  return static_cast<bool>(ofs);
+}
+
+bool readJson(const std::string &path, std::vector<Result> &results) {
+  std::ifstream ifs(path);
+  if (!ifs) return false;
+  std::string line;
+  while (std::getline(ifs, line)) {
+    std::string v;
+    if (!findField(line, "name", v)) continue;
+    Result r;
+    r.name = v;
+    if (findField(line, "group", v))         r.group = v;
+    if (findField(line, "param", v))         r.param = toNumber(v);
+    if (findField(line, "ns_per_op", v))     r.nsPerOp = toNumber(v);
+    if (findField(line, "allocs_per_op", v)) r.allocsPerOp = toNumber(v);
+    if (findField(line, "bytes_per_op", v))  r.bytesPerOp = toNumber(v);
+    if (findField(line, "iterations", v))    r.iterations = static_cast<std::uint64_t>(toNumber(v));
+    if (findField(line, "metric_name", v))   r.metricName = v;
+    if (findField(line, "metric", v))        r.metric = toNumber(v);
+    results.push_back(r);
+  }
+  return true;
+}
+
+} // namespace bench
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+/**
+ * \brief Minimal micro-benchmark harness for the hx_core kernels.
+ *
+ *  Each case is a closure executing one "op" (one U() evaluation, one
+ *  Simulator::step, one full Monte-Carlo study...).  The harness calibrates
+ *  the iteration count until a batch runs for at least \c minTime seconds,
+ *  then reports the best of \c repetitions batches.  Heap allocations are
+ *  counted through the global operator new replacements in Bench.cpp
+ *  (aligned forms included) and, on glibc, by interposing malloc, so
+ *  "allocs/op" reflects every allocation the kernel triggers, including
+ *  those buried inside std::vector or Eigen.  Where malloc cannot be
+ *  interposed, cases marked \c usesMalloc report allocs/op as not measured.
+ *
+ *  \c group + \c param identify a scaling curve: all cases sharing a group
+ *  are reported together with their log-log slope (ns/op vs param).
+ */
+struct Case {
+  Case() = default;
+  Case(std::string g, std::string n, double p,
+       std::function<void()> s, std::function<void()> o)
+      : group(std::move(g)), name(std::move(n)), param(p),
+        setup(std::move(s)), op(std::move(o)) {}
+
+  std::string group;          // e.g. "Simulator::step/axial"
+  std::string name;           // unique, e.g. "Simulator::step/axial/cells=20"
+  double      param = 0.0;    // x-axis for scaling curves (0 = none)
+  std::function<void()> setup;  // optional, run once before timing
+  std::function<void()> op;     // one operation
+  // Allocates through malloc directly (Eigen dynamic matrices): its
+  // allocation counts are only reported where mallocCounted().
+  bool usesMalloc = false;
+  // Optional accuracy / diagnostic metric, evaluated once after timing.
+  std::string metricName;
+  std::function<double()> metric;
+};
+
+struct Result {
+  std::string group;
+  std::string name;
+  double      param         = 0.0;
+  double      nsPerOp       = 0.0;
+  double      allocsPerOp   = 0.0;
+  double      bytesPerOp    = 0.0;
+  std::uint64_t iterations  = 0;
+  // Free-form accuracy / diagnostic metric (e.g. max relative error of an
+  // approximation).  NaN when the case does not report one.
+  double      metric        = std::numeric_limits<double>::quiet_NaN();
+  std::string metricName;
+};
+
+/** Global allocation counters (maintained by the operator new override). */
+std::uint64_t allocCount();
+std::uint64_t allocBytes();
+
+/** True when malloc / calloc / realloc are counted too, not only operator new. */
+bool mallocCounted();
+
+/** Prevent the optimiser from discarding a computed value. */
+void doNotOptimize(double v);
+
+/** Time one case. */
+Result run(const Case &c, double minTime, int repetitions);
+
+/** Serialise results as a JSON document (one result object per line). */
+bool writeJson(const std::string &path, const std::vector<Result> &results);
+
+/** Load a JSON document previously produced by writeJson(). */
+bool readJson(const std::string &path, std::vector<Result> &results);
+
+} // namespace bench
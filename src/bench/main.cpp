@@ -0,0 +1,802 @@
+// heatxtwin_bench — micro-benchmarks for the hx_core physics kernels.
+//
+// Reports ns/op, heap allocations/op and (for parameterised groups) the
+// log-log scaling slope, writes everything to a machine-readable JSON file
+// and optionally compares against a stored baseline, failing with exit code 1
+// when any case slows down by more than the configured threshold.
+//
+//   heatxtwin_bench --out bench.json
+//   heatxtwin_bench --baseline bench_main.json --threshold 0.10
+
+#include "Bench.hpp"
+
+#include "core/BellDelaware.hpp"
+#include "core/FluidLibrary.hpp"
+#include "core/FluidPropertyTable.hpp"
+#include "core/Fouling.hpp"
+#include "core/DecimatedSeries.hpp"
+#include "core/DesignOptimizer.hpp"
+#include "core/DesignSweep.hpp"
+#include "core/FoulingMap.hpp"
+#include "core/Hydraulics.hpp"
+#include "core/MonteCarlo.hpp"
+#include "core/MultiFidelity.hpp"
+#include "core/RareEvent.hpp"
+#include "core/SampleRing.hpp"
+#include "core/Simulator.hpp"
+#include "core/SimulatorBatch.hpp"
+#include "core/Surrogate.hpp"
+#include "core/Thermo.hpp"
+#include "core/TraceRecorder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// -----------------------------------------------------------------------------
+//  Reference plant — identical to MainWindow::resetToDefaults() so numbers are
+//  representative of what the GUI runs.
+// -----------------------------------------------------------------------------
+hx::Geometry defaultGeometry() {
+  hx::Geometry g{};
+  g.nTubes = 100;
+  g.Di = 0.019;
+  g.Do = 0.025;
+  g.L = 5.0;
+  g.pitch = 0.032;
+  g.shellID = 0.5;
+  g.baffleSpacing = 0.25;
+  g.baffleCutFrac = 0.25;
+  g.nBaffles = 20;
+  g.wall_k = 16.0;
+  g.wall_thickness = 0.002;
+  return g;
+}
+
+hx::Fluid water() { return {997.0, 0.001, 4180.0, 0.6}; }
+
+hx::OperatingPoint defaultOp() { return {1.2, 1.0, 80.0, 25.0}; }
+
+hx::FoulingParams defaultFouling() {
+  hx::FoulingParams fp{};
+  fp.Rf0 = 0.0;
+  fp.RfMax = 0.0005;
+  fp.tau = 3600.0;
+  fp.alpha = 1e-8;
+  fp.model = hx::FoulingParams::Model::Asymptotic;
+  return fp;
+}
+
+hx::SimConfig defaultSimConfig(int cells) {
+  hx::SimConfig cfg{};
+  cfg.dt = 0.1;
+  cfg.tEnd = 3600.0;
+  cfg.Mh = 10.0;
+  cfg.Mc = 12.0;
+  cfg.limits = {1e5, 1e5, 0.1, 5.0};
+  cfg.hotCustom = water();
+  cfg.coldCustom = water();
+  cfg.numAxialCells = cells;
+  return cfg;
+}
+
+/** Owns everything a Simulator references so it can live inside a closure. */
+struct SimFixture {
+  hx::Thermo     thermo;
+  hx::Hydraulics hydro;
+  hx::Fouling    foul;
+  hx::Simulator  sim;
+  double         t = 0.0;
+  double         dt;
+
+  SimFixture(const hx::SimConfig &cfg, hx::ShellSideMethod method)
+      : thermo(defaultGeometry(), water(), water()),
+        hydro(defaultGeometry(), water(), water()),
+        foul(defaultFouling()),
+        sim(thermo, hydro, foul, cfg),
+        dt(cfg.dt) {
+    thermo.setShellMethod(method);
+    hydro.setShellMethod(method);
+    sim.reset(defaultOp());
+  }
+};
+
+std::vector<bench::Case> buildCases() {
+  std::vector<bench::Case> cases;
+  const hx::Geometry g = defaultGeometry();
+  const hx::Fluid w = water();
+
+  // --- Heat-transfer coefficients -------------------------------------------
+  for (auto method : {hx::ShellSideMethod::Kern, hx::ShellSideMethod::BellDelaware}) {
+    const char *mname = (method == hx::ShellSideMethod::Kern) ? "kern" : "bell-delaware";
+    auto thermo = std::make_shared<hx::Thermo>(g, w, w);
+    thermo->setShellMethod(method);
+    cases.push_back({"Thermo::U", std::string("Thermo::U/") + mname, 0.0, {},
+                     [thermo]() { bench::doNotOptimize(thermo->U(1.2, 1.0, 1e-4, 1e-4, 0.5)); }});
+    cases.push_back({"Thermo::steady", std::string("Thermo::steady/") + mname, 0.0, {},
+                     [thermo]() {
+                       bench::doNotOptimize(thermo->steady(defaultOp(), 1e-4, 1e-4, 0.5).Q);
+                     }});
+  }
+
+  cases.push_back({"computeBellDelaware", "computeBellDelaware", 0.0, {},
+                   [g, w]() { bench::doNotOptimize(hx::computeBellDelaware(g, w, 1.0, 1e-4, 0.5).h_shell); }});
+  {
+    auto bd = std::make_shared<hx::BellDelawarePrecomputed>(g);
+    cases.push_back({"BellDelawarePrecomputed::evaluate", "BellDelawarePrecomputed::evaluate/fouled", 0.0, {},
+                     [bd, w]() { bench::doNotOptimize(bd->evaluate(w, 1.0, 1e-4, 0.5).h_shell); }});
+    cases.push_back({"BellDelawarePrecomputed::evaluate", "BellDelawarePrecomputed::evaluate/clean", 0.0, {},
+                     [bd, w]() { bench::doNotOptimize(bd->evaluate(w, 1.0).h_shell); }});
+  }
+
+  for (auto method : {hx::ShellSideMethod::Kern, hx::ShellSideMethod::BellDelaware}) {
+    const char *mname = (method == hx::ShellSideMethod::Kern) ? "kern" : "bell-delaware";
+    auto hydro = std::make_shared<hx::Hydraulics>(g, w, w);
+    hydro->setShellMethod(method);
+    cases.push_back({"Hydraulics::dP_shell", std::string("Hydraulics::dP_shell/") + mname, 0.0, {},
+                     [hydro]() { bench::doNotOptimize(hydro->dP_shell(1.0, 1e-4, 0.5, 0.0)); }});
+  }
+
+  // --- Fluid property library -----------------------------------------------
+  for (const auto &info : hx::fluidPresetCatalog()) {
+    if (info.preset == hx::FluidPreset::Custom) continue;
+    const hx::FluidPreset p = info.preset;
+    const double lo = info.T_min, span = info.T_max - info.T_min;
+    auto T = std::make_shared<double>(0.0);
+    cases.push_back({"evaluateFluid", std::string("evaluateFluid/") + info.displayName, 0.0, {},
+                     [p, lo, span, T]() {
+                       // Sweep the valid range so branch/clamp behaviour is realistic.
+                       *T += 0.37;
+                       if (*T > span) *T -= span;
+                       bench::doNotOptimize(hx::evaluateFluid(p, lo + *T).mu);
+                     }});
+  }
+
+  // Same sweep through the cached tables; the metric is the worst relative
+  // error of any property against the closed form over the preset's range.
+  for (const auto &info : hx::fluidPresetCatalog()) {
+    if (info.preset == hx::FluidPreset::Custom) continue;
+    const hx::FluidPreset p = info.preset;
+    const hx::FluidPropertyTable *table = hx::FluidPropertyTable::forPreset(p);
+    const double lo = info.T_min, span = info.T_max - info.T_min;
+    auto T = std::make_shared<double>(0.0);
+    bench::Case c("FluidPropertyTable::lookup",
+                  std::string("FluidPropertyTable::lookup/") + info.displayName, 0.0, {},
+                  [table, lo, span, T]() {
+                    *T += 0.37;
+                    if (*T > span) *T -= span;
+                    bench::doNotOptimize(table->lookup(lo + *T).mu);
+                  });
+    c.metricName = "max_rel_err";
+    c.metric = [table, p, lo, span]() {
+      double worst = 0.0;
+      for (int i = 0; i <= 20000; ++i) {
+        const double Ti = lo + span * i / 20000.0;
+        const hx::Fluid a = hx::evaluateFluid(p, Ti);
+        const hx::Fluid b = table->lookup(Ti);
+        worst = std::max({worst, std::fabs(b.rho - a.rho) / a.rho, std::fabs(b.mu - a.mu) / a.mu,
+                          std::fabs(b.cp - a.cp) / a.cp, std::fabs(b.k - a.k) / a.k});
+      }
+      return worst;
+    };
+    cases.push_back(std::move(c));
+  }
+  {
+    // Batch form: one property set per axial cell of a 200-cell profile.
+    auto Tcells = std::make_shared<std::vector<double>>(200);
+    auto out = std::make_shared<std::vector<hx::Fluid>>(200);
+    for (size_t i = 0; i < Tcells->size(); ++i) (*Tcells)[i] = 80.0 - 0.25 * static_cast<double>(i);
+    const hx::FluidPropertyTable *table = hx::FluidPropertyTable::forPreset(hx::FluidPreset::Water);
+    cases.push_back({"FluidPropertyTable::lookup/batch", "FluidPropertyTable::lookup/batch/cells=200",
+                     200.0, {},
+                     [table, Tcells, out]() {
+                       table->lookup(Tcells->data(), Tcells->size(), out->data());
+                       bench::doNotOptimize((*out)[100].mu);
+                     }});
+  }
+
+  // --- Worker → GUI sample ring (one push, drained in frame-sized batches) ----
+  {
+    auto ring = std::make_shared<hx::SampleRing>(8192, hx::OverflowPolicy::Drop);
+    auto rec = std::make_shared<hx::SampleRecord>();
+    cases.push_back({"SampleRing::push", "SampleRing::push+drain", 0.0, {},
+                     [ring, rec]() {
+                       rec->t += 0.1;
+                       ring->push(*rec);
+                       if (ring->size() >= 256) {
+                         ring->drain([](const hx::SampleRecord &r) { bench::doNotOptimize(r.t); });
+                       }
+                     }});
+  }
+
+  // --- Chart level of detail (append one sample, decimate a full-width view) --
+  for (int n : {10000, 1000000}) {
+    auto series = std::make_shared<hx::DecimatedSeries>();
+    auto pts = std::make_shared<std::vector<hx::SeriesPoint>>();
+    const std::string tag = "n=" + std::to_string(n);
+    cases.push_back({"DecimatedSeries::append", "DecimatedSeries::append/" + tag, static_cast<double>(n),
+                     [series, n]() {
+                       series->clear();
+                       series->reserve(static_cast<size_t>(n) + (1u << 20));
+                       for (int i = 0; i < n; ++i) {
+                         series->append(0.1 * i, std::sin(1e-3 * i));
+                       }
+                     },
+                     [series]() {
+                       const double x = series->lastX() + 0.1;
+                       series->append(x, std::sin(x));
+                     }});
+    cases.push_back({"DecimatedSeries::decimate", "DecimatedSeries::decimate/" + tag + "/px=800",
+                     static_cast<double>(n),
+                     [series, pts, n]() {
+                       series->clear();
+                       for (int i = 0; i < n; ++i) series->append(0.1 * i, std::sin(1e-3 * i));
+                       pts->reserve(4096);
+                     },
+                     [series, pts]() {
+                       series->decimate(series->firstX(), series->lastX(), 800, *pts);
+                       bench::doNotOptimize(pts->back().x);
+                     }});
+  }
+
+  // --- Run recording (columnar chunks; a small budget forces the spill path) ----
+  {
+    hx::TraceRecorderConfig rc;
+    rc.ramBudgetBytes = 4u << 20;
+    auto rec = std::make_shared<hx::TraceRecorder>(rc);
+    auto t = std::make_shared<double>(0.0);
+    cases.push_back({"TraceRecorder", "TraceRecorder::append/spill", 0.0,
+                     [rec, t]() {
+                       rec->clear();
+                       *t = 0.0;
+                     },
+                     [rec, t]() {
+                       hx::State s{};
+                       s.Tc_out = *t;
+                       rec->append(*t, s);
+                       *t += 0.1;
+                     }});
+    auto scan = std::make_shared<hx::TraceRecorder>(rc);
+    cases.push_back({"TraceRecorder", "TraceRecorder::forEach/n=1e6", 1e6,
+                     [scan]() {
+                       scan->clear();
+                       hx::State s{};
+                       for (int i = 0; i < 1000000; ++i) {
+                         s.Tc_out = i;
+                         scan->append(0.1 * i, s);
+                       }
+                     },
+                     [scan]() {
+                       double sum = 0.0;
+                       scan->forEach([&sum](double, const hx::State &s) { sum += s.Tc_out; });
+                       bench::doNotOptimize(sum);
+                     }});
+  }
+
+  // --- Simulator::step --------------------------------------------------------
+  for (int cells : {1, 20, 200}) {
+    const std::string mode = (cells <= 1) ? "lumped" : "axial";
+    auto fx = std::make_shared<std::unique_ptr<SimFixture>>();
+    cases.push_back({"Simulator::step", "Simulator::step/" + mode + "/cells=" + std::to_string(cells),
+                     static_cast<double>(cells),
+                     [fx, cells]() {
+                       *fx = std::make_unique<SimFixture>(defaultSimConfig(cells),
+                                                          hx::ShellSideMethod::Kern);
+                     },
+                     [fx]() {
+                       SimFixture &f = **fx;
+                       bench::doNotOptimize(f.sim.step(f.t).Q);
+                       f.t += f.dt;
+                     }});
+  }
+  {
+    // Adaptive lumped integrator; the metric is RHS evaluations per step
+    // (explicit Euler costs exactly one).
+    auto fx = std::make_shared<std::unique_ptr<SimFixture>>();
+    auto steps = std::make_shared<long long>(0);
+    bench::Case c("Simulator::step/dopri5", "Simulator::step/dopri5/lumped", 1.0,
+                  [fx, steps]() {
+                    hx::SimConfig cfg = defaultSimConfig(1);
+                    cfg.lumpedIntegrator = hx::LumpedIntegrator::DormandPrince45;
+                    *fx = std::make_unique<SimFixture>(cfg, hx::ShellSideMethod::Kern);
+                    *steps = 0;
+                  },
+                  [fx, steps]() {
+                    SimFixture &f = **fx;
+                    bench::doNotOptimize(f.sim.step(f.t).Q);
+                    f.t += f.dt;
+                    ++*steps;
+                  });
+    c.metricName = "rhs_evals_per_step";
+    c.metric = [fx, steps]() {
+      return static_cast<double>((*fx)->sim.integratorStats().rhsEvals) /
+             static_cast<double>(std::max(1LL, *steps));
+    };
+    cases.push_back(std::move(c));
+  }
+  {
+    // Constant operating point with fouling: only Rf moves, so the memo in
+    // Simulator::overallU should re-evaluate h_shell every step but h_tube
+    // once.  The metric is the fraction of U() calls that reused h_tube.
+    auto fx = std::make_shared<std::unique_ptr<SimFixture>>();
+    bench::Case c("Simulator::step/steady-fouling", "Simulator::step/steady-fouling/cells=1", 1.0,
+                  [fx]() {
+                    *fx = std::make_unique<SimFixture>(defaultSimConfig(1), hx::ShellSideMethod::Kern);
+                    (*fx)->sim.setSteadyStateMode(true);
+                  },
+                  [fx]() {
+                    SimFixture &f = **fx;
+                    bench::doNotOptimize(f.sim.step(f.t).Q);
+                    f.t += f.dt;
+                  });
+    c.metricName = "tube_hit_rate";
+    c.metric = [fx]() {
+      const hx::HeatTransferMemoStats &s = (*fx)->sim.heatTransferStats();
+      return static_cast<double>(s.tubeHits) /
+             static_cast<double>(std::max(1LL, s.tubeHits + s.tubeMisses));
+    };
+    cases.push_back(std::move(c));
+  }
+  {
+    // Closed loop with a scripted timeline — the allocs/op column must stay
+    // at zero here too (controller and scenario state live inline).
+    auto fx = std::make_shared<std::unique_ptr<SimFixture>>();
+    cases.push_back({"Simulator::step/pid-scenario", "Simulator::step/pid-scenario/cells=20", 20.0,
+                     [fx]() {
+                       hx::SimConfig cfg = defaultSimConfig(20);
+                       cfg.pid.enabled = true;
+                       cfg.pid.ff_enabled = true;
+                       cfg.pid.ff_auto_energy_balance = true;
+                       cfg.scenario = hx::scenarioStartupRamp();
+                       *fx = std::make_unique<SimFixture>(cfg, hx::ShellSideMethod::Kern);
+                     },
+                     [fx]() {
+                       SimFixture &f = **fx;
+                       bench::doNotOptimize(f.sim.step(f.t).Q);
+                       f.t += f.dt;
+                     }});
+  }
+  for (int cells : {20, 200}) {
+    auto fx = std::make_shared<std::unique_ptr<SimFixture>>();
+    cases.push_back({"Simulator::step/backward-euler",
+                     "Simulator::step/backward-euler/cells=" + std::to_string(cells),
+                     static_cast<double>(cells),
+                     [fx, cells]() {
+                       hx::SimConfig cfg = defaultSimConfig(cells);
+                       cfg.axialIntegrator = hx::AxialIntegrator::BackwardEuler;
+                       *fx = std::make_unique<SimFixture>(cfg, hx::ShellSideMethod::Kern);
+                     },
+                     [fx]() {
+                       SimFixture &f = **fx;
+                       bench::doNotOptimize(f.sim.step(f.t).Q);
+                       f.t += f.dt;
+                     }});
+  }
+  {
+    auto fx = std::make_shared<std::unique_ptr<SimFixture>>();
+    cases.push_back({"Simulator::step/bell-delaware", "Simulator::step/bell-delaware/cells=20", 20.0,
+                     [fx]() {
+                       *fx = std::make_unique<SimFixture>(defaultSimConfig(20),
+                                                          hx::ShellSideMethod::BellDelaware);
+                     },
+                     [fx]() {
+                       SimFixture &f = **fx;
+                       bench::doNotOptimize(f.sim.step(f.t).Q);
+                       f.t += f.dt;
+                     }});
+  }
+
+  // --- Direct steady solve (from a fresh reset, Picard on a water preset) ----
+  for (int cells : {1, 20, 200}) {
+    auto fx = std::make_shared<std::unique_ptr<SimFixture>>();
+    cases.push_back({"Simulator::solveSteadyAxial",
+                     "Simulator::solveSteadyAxial/cells=" + std::to_string(cells),
+                     static_cast<double>(cells),
+                     [fx, cells]() {
+                       hx::SimConfig cfg = defaultSimConfig(cells);
+                       cfg.hotPreset = hx::FluidPreset::Water;
+                       *fx = std::make_unique<SimFixture>(cfg, hx::ShellSideMethod::Kern);
+                     },
+                     [fx]() {
+                       SimFixture &f = **fx;
+                       f.sim.reset(defaultOp());
+                       bench::doNotOptimize(f.sim.solveSteadyAxial().residual);
+                     }});
+  }
+
+  // --- Fouling heat-map ------------------------------------------------------
+  for (int nT : {100, 1000, 10000}) {
+    hx::Geometry gm = g;
+    gm.nTubes = nT;
+    // Size the shell so the triangular layout actually fits nT tubes.
+    const double R = gm.pitch * std::sqrt(nT * std::sqrt(3.0) / (2.0 * 3.14159265358979323846)) * 1.05;
+    gm.shellID = 2.0 * R + gm.Do;
+    cases.push_back({"computeFoulingMap", "computeFoulingMap/tubes=" + std::to_string(nT),
+                     static_cast<double>(nT), {},
+                     [gm]() {
+                       const hx::FoulingMap m = hx::computeFoulingMap(gm, defaultOp(), 2e-4, 24);
+                       bench::doNotOptimize(m.Rf_mean_overall);
+                     }});
+  }
+
+  // --- Lock-step ensemble (one op = one step of every lane) ------------------
+  for (int lanes : {64, 1024, 16384}) {
+    auto batch = std::make_shared<std::unique_ptr<hx::SimulatorBatch>>();
+    auto t = std::make_shared<double>(0.0);
+    cases.push_back({"SimulatorBatch::step", "SimulatorBatch::step/lanes=" + std::to_string(lanes),
+                     static_cast<double>(lanes),
+                     [batch, t, g, w, lanes]() {
+                       hx::SimConfig cfg = defaultSimConfig(1);
+                       cfg.disturbanceType = hx::SimConfig::DisturbanceType::None;
+                       *batch = std::make_unique<hx::SimulatorBatch>(g, cfg, true);
+                       (*batch)->reserve(static_cast<size_t>(lanes));
+                       for (int i = 0; i < lanes; ++i) {
+                         hx::OperatingPoint op = defaultOp();
+                         op.m_dot_cold *= 0.5 + static_cast<double>(i) / lanes;
+                         (*batch)->addLane(op, w, w, defaultFouling());
+                       }
+                       (*batch)->reset();
+                       *t = 0.0;
+                     },
+                     [batch, t]() {
+                       (*batch)->step(*t);
+                       bench::doNotOptimize((*batch)->Q()[0]);
+                       *t += 0.1;
+                     }});
+  }
+
+  // --- Monte-Carlo study -----------------------------------------------------
+  for (int nTrials : {50, 200}) {
+    cases.push_back({"runMonteCarlo", "runMonteCarlo/trials=" + std::to_string(nTrials),
+                     static_cast<double>(nTrials), {},
+                     [g, w, nTrials]() {
+                       hx::MonteCarloSettings mc;
+                       mc.nTrials = nTrials;
+                       const auto r = hx::runMonteCarlo(defaultOp(), g, w, w, defaultFouling(),
+                                                        defaultSimConfig(1), mc);
+                       bench::doNotOptimize(r.statQ.mean);
+                     }});
+  }
+  // Same study pinned to one worker: the ratio to trials=2000 is the thread-pool speed-up.
+  for (int threads : {1, 0}) {
+    const std::string tag = threads == 1 ? "threads=1" : "threads=all";
+    cases.push_back({"runMonteCarlo/2000", "runMonteCarlo/trials=2000/" + tag, 2000.0, {},
+                     [g, w, threads]() {
+                       hx::MonteCarloSettings mc;
+                       mc.nTrials = 2000;
+                       mc.threads = threads;
+                       const auto r = hx::runMonteCarlo(defaultOp(), g, w, w, defaultFouling(),
+                                                        defaultSimConfig(1), mc);
+                       bench::doNotOptimize(r.statQ.mean);
+                     }});
+  }
+
+  // Sampling designs at equal trial count: the design itself must stay noise next to the trials.
+  for (hx::SamplingStrategy sampling : {hx::SamplingStrategy::MonteCarlo, hx::SamplingStrategy::LatinHypercube,
+                                        hx::SamplingStrategy::Sobol, hx::SamplingStrategy::Halton}) {
+    cases.push_back({"runMonteCarlo/sampling",
+                     std::string("runMonteCarlo/trials=256/") + hx::samplingStrategyName(sampling), 256.0, {},
+                     [g, w, sampling]() {
+                       hx::MonteCarloSettings mc;
+                       mc.nTrials = 256;
+                       mc.sampling = sampling;
+                       const auto r = hx::runMonteCarlo(defaultOp(), g, w, w, defaultFouling(),
+                                                        defaultSimConfig(1), mc);
+                       bench::doNotOptimize(r.statQ.seMean);
+                     }});
+  }
+
+  // Saltelli sensitivity: N·(K+1) extra trials on top of an N-trial ensemble, so slope ≈ 1.
+  for (int n : {32, 128, 512}) {
+    cases.push_back({"runMonteCarlo/sobol", "runMonteCarlo/sobolSamples=" + std::to_string(n),
+                     static_cast<double>(n), {},
+                     [g, w, n]() {
+                       hx::MonteCarloSettings mc;
+                       mc.nTrials = n;
+                       mc.sobolSamples = n;
+                       mc.bootstrapResamples = 100;
+                       const auto r = hx::runMonteCarlo(defaultOp(), g, w, w, defaultFouling(),
+                                                        defaultSimConfig(1), mc);
+                       bench::doNotOptimize(r.sobol.front().index.front().total);
+                     }});
+  }
+
+  // Trial solvers on one worker: the direct steady solve against 120 integrated
+  // steps.  The metric is the mean number of time steps per trial, which for
+  // Converged should stay far below the 120-step horizon.
+  const std::pair<hx::TrialSolver, const char *> solvers[] = {
+      {hx::TrialSolver::Steady, "steady"}, {hx::TrialSolver::Converged, "converged"},
+      {hx::TrialSolver::Dynamic, "dynamic"}};
+  for (const auto &[solver, tag] : solvers) {
+    auto meanSteps = std::make_shared<double>(0.0);
+    bench::Case c("runMonteCarlo/solver", std::string("runMonteCarlo/trials=2000/") + tag, 2000.0, {},
+                  [g, w, solver = solver, meanSteps]() {
+                    hx::MonteCarloSettings mc;
+                    mc.nTrials = 2000;
+                    mc.threads = 1;
+                    mc.sobolSamples = 0;
+                    mc.solver = solver;
+                    const auto r = hx::runMonteCarlo(defaultOp(), g, w, w, defaultFouling(),
+                                                     defaultSimConfig(1), mc);
+                    bench::doNotOptimize(r.statQ.mean);
+                    *meanSteps = r.meanSteps;
+                  });
+    c.metricName = "mean_steps";
+    c.metric = [meanSteps]() { return *meanSteps; };
+    cases.push_back(std::move(c));
+  }
+
+  // Streaming summary vs kept per-trial vectors at equal trial count.
+  for (bool keep : {false, true}) {
+    cases.push_back({"runMonteCarlo/100000", std::string("runMonteCarlo/trials=100000/") +
+                                                  (keep ? "keepTrials" : "streaming"),
+                     100000.0, {},
+                     [g, w, keep]() {
+                       hx::MonteCarloSettings mc;
+                       mc.nTrials = 100000;
+                       mc.sobolSamples = 0;
+                       mc.keepTrials = keep;
+                       const auto r = hx::runMonteCarlo(defaultOp(), g, w, w, defaultFouling(),
+                                                        defaultSimConfig(1), mc);
+                       bench::doNotOptimize(r.statQ.p95);
+                     }});
+  }
+
+  // Subset simulation of a shell-side ΔP limit: the default exchanger's
+  // 2.35 Pa nominal is exceeded past 2.9 Pa with P ≈ 1e-2 and past 3.3 Pa
+  // with P ≈ 1e-4.  Cost grows with log(1/P), i.e. slope ≈ 0.1 against 1/P.
+  const std::pair<double, double> exceedances[] = {{100.0, 2.9}, {10000.0, 3.3}};
+  for (const auto &[inverseP, limit] : exceedances) {
+    cases.push_back({"estimateExceedance",
+                     "estimateExceedance/P=1e-" + std::to_string(static_cast<int>(std::log10(inverseP))),
+                     inverseP, {},
+                     [g, w, limit = limit]() {
+                       hx::MonteCarloSettings mc;
+                       hx::ExceedanceSettings ex;
+                       ex.conditions = {{hx::LimitOutput::dP_shell, limit, true}};
+                       const auto r = hx::estimateExceedance(defaultOp(), g, w, w, defaultFouling(),
+                                                             defaultSimConfig(1), mc, ex);
+                       bench::doNotOptimize(r.probability);
+                     }});
+  }
+
+  // Multi-fidelity study of the 50-cell axial model (Dynamic trials) with
+  // the lumped model as control variate, at a budget of 100 and 400 axial
+  // trials.  The cost ratio is fixed so the allocation does not depend on
+  // the machine; the cost is linear in the budget (slope ≈ 1).
+  for (double budget : {100.0, 400.0}) {
+    cases.push_back({"runMultiFidelity",
+                     "runMultiFidelity/budget=" + std::to_string(static_cast<int>(budget)),
+                     budget, {},
+                     [g, w, budget]() {
+                       hx::MonteCarloSettings mc;
+                       mc.solver = hx::TrialSolver::Dynamic;
+                       hx::MultiFidelitySettings mf;
+                       mf.budget = budget;
+                       mf.costRatio = 0.03;
+                       const auto r = hx::runMultiFidelity(defaultOp(), g, w, w, defaultFouling(),
+                                                           defaultSimConfig(50), mc, mf);
+                       bench::doNotOptimize(r.stats[0].mean);
+                     }});
+  }
+
+  // Polynomial-chaos surrogate: the 1024-trial build, and one query of all
+  // six outputs against the surrogate it builds (setup, untimed).
+  cases.push_back({"buildSurrogate", "buildSurrogate/trials=1024", 1024.0, {},
+                   [g, w]() {
+                     hx::MonteCarloSettings mc;
+                     hx::SurrogateSettings ss;
+                     const auto r = hx::buildSurrogate(defaultOp(), g, w, w, defaultFouling(),
+                                                       defaultSimConfig(1), mc, ss);
+                     bench::doNotOptimize(r.model.outputs[0].looError);
+                   }});
+  cases.back().usesMalloc = true;   // Eigen least-squares fit
+  {
+    auto model = std::make_shared<hx::Surrogate>();
+    cases.push_back({"Surrogate::whatIf", "Surrogate::whatIf/all-outputs", 0.0,
+                     [model, g, w]() {
+                       *model = hx::buildSurrogate(defaultOp(), g, w, w, defaultFouling(),
+                                                   defaultSimConfig(1), hx::MonteCarloSettings{},
+                                                   hx::SurrogateSettings{}).model;
+                     },
+                     [model]() {
+                       // Hot flow 8 % down, hot viscosity 20 % up.
+                       bench::doNotOptimize(model->whatIf({-0.08, 0.0, 0.0, 0.0, 0.0, 0.2})[0]);
+                     }});
+    cases.back().usesMalloc = true;
+    cases.back().metricName = "loo_error_Q";
+    cases.back().metric = [model]() { return model->outputs[0].looError; };
+  }
+
+  // Design-space sweep over a k^4 grid of tube count, shell ID, baffle
+  // spacing and length (no results file); cost per design is flat, slope ≈ 1.
+  for (int k : {6, 10}) {
+    const double designs = std::pow(static_cast<double>(k), 4.0);
+    cases.push_back({"runDesignSweep", "runDesignSweep/k=" + std::to_string(k), designs, {},
+                     [g, w, k]() {
+                       hx::SweepSettings s;
+                       s.base          = g;
+                       s.nTubes        = {50.0, 400.0, k};
+                       s.shellID       = {0.3, 1.0, k};
+                       s.baffleSpacing = {0.1, 1.2, k};
+                       s.L             = {3.0, 9.0, k};
+                       const auto r = hx::runDesignSweep(defaultOp(), w, w, s);
+                       bench::doNotOptimize(static_cast<double>(r.feasible));
+                     }});
+  }
+
+  // SQP design optimisation of tube count, length, shell ID and baffle
+  // spacing for minimum area under duty and ΔP limits; the metric is the
+  // number of model evaluations (values plus exact gradients) per solve.
+  for (const auto method : {hx::ShellSideMethod::Kern, hx::ShellSideMethod::BellDelaware}) {
+    hx::OptimizeSettings s;
+    s.base          = g;
+    s.shellMethod   = method;
+    s.Rf_shell      = 2e-4;
+    s.Rf_tube       = 1e-4;
+    s.nTubes        = {20.0, 400.0};
+    s.L             = {1.0, 9.0};
+    s.shellID       = {0.2, 1.0};
+    s.baffleSpacing = {0.1, 1.2};
+    s.Q_min         = 180e3;
+    s.dP_tube_max   = 2000.0;
+    s.dP_shell_max  = 2000.0;
+    const std::string name = method == hx::ShellSideMethod::Kern ? "kern" : "bell-delaware";
+    cases.push_back({"optimizeDesign", "optimizeDesign/" + name, 0.0, {},
+                     [s, w]() {
+                       const auto r = hx::optimizeDesign(defaultOp(), w, w, s);
+                       bench::doNotOptimize(r.area);
+                     }});
+    cases.back().usesMalloc = true;   // Eigen QP subproblems
+    cases.back().metricName = "evaluations";
+    cases.back().metric = [s, w]() {
+      return static_cast<double>(hx::optimizeDesign(defaultOp(), w, w, s).evaluations);
+    };
+  }
+
+  return cases;
+}
+
+/** Least-squares slope of log(ns/op) against log(param) for one group. */
+double scalingSlope(const std::vector<const bench::Result *> &pts) {
+  double sx = 0, sy = 0, sxx = 0, sxy = 0;
+  const double n = static_cast<double>(pts.size());
+  for (const auto *r : pts) {
+    const double x = std::log(r->param), y = std::log(r->nsPerOp);
+    sx += x; sy += y; sxx += x * x; sxy += x * y;
+  }
+  const double den = n * sxx - sx * sx;
+  return (std::fabs(den) > 1e-12) ? (n * sxy - sx * sy) / den : 0.0;
+}
+
+void printUsage(const char *argv0) {
+  std::fprintf(stderr,
+      "Usage: %s [options]\n"
+      "  --out PATH         JSON results file (default: bench_results.json)\n"
+      "  --baseline PATH    compare against a previous JSON results file\n"
+      "  --threshold F      allowed slowdown before a case is a regression (default 0.15)\n"
+      "  --filter TEXT      only run cases whose name contains TEXT\n"
+      "  --min-time S       minimum timed batch duration per case (default 0.2)\n"
+      "  --reps N           timed batches per case, best is kept (default 3)\n"
+      "  --list             list case names and exit\n",
+      argv0);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+  std::string outPath = "bench_results.json";
+  std::string baselinePath;
+  std::string filter;
+  double threshold = 0.15;
+  double minTime = 0.2;
+  int reps = 3;
+  bool listOnly = false;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *a = argv[i];
+    const bool hasNext = (i + 1 < argc);
+    if (std::strcmp(a, "--out") == 0 && hasNext)            outPath = argv[++i];
+    else if (std::strcmp(a, "--baseline") == 0 && hasNext)  baselinePath = argv[++i];
+    else if (std::strcmp(a, "--threshold") == 0 && hasNext) threshold = std::atof(argv[++i]);
+    else if (std::strcmp(a, "--filter") == 0 && hasNext)    filter = argv[++i];
+    else if (std::strcmp(a, "--min-time") == 0 && hasNext)  minTime = std::atof(argv[++i]);
+    else if (std::strcmp(a, "--reps") == 0 && hasNext)      reps = std::atoi(argv[++i]);
+    else if (std::strcmp(a, "--list") == 0)                 listOnly = true;
+    else { printUsage(argv[0]); return 2; }
+  }
+
+  const std::vector<bench::Case> cases = buildCases();
+  if (listOnly) {
+    for (const auto &c : cases) std::printf("%s\n", c.name.c_str());
+    return 0;
+  }
+
+  std::vector<bench::Result> results;
+  std::printf("%-48s %14s %12s %12s\n", "case", "ns/op", "allocs/op", "bytes/op");
+  for (const auto &c : cases) {
+    if (!filter.empty() && c.name.find(filter) == std::string::npos) continue;
+    const bench::Result r = bench::run(c, minTime, reps);
+    if (std::isfinite(r.allocsPerOp))
+      std::printf("%-48s %14.1f %12.2f %12.1f", r.name.c_str(), r.nsPerOp, r.allocsPerOp, r.bytesPerOp);
+    else
+      std::printf("%-48s %14.1f %12s %12s", r.name.c_str(), r.nsPerOp, "n/a", "n/a");
+    if (std::isfinite(r.metric)) std::printf("   %s = %.3g", r.metricName.c_str(), r.metric);
+    std::printf("\n");
+    std::fflush(stdout);
+    results.push_back(r);
+  }
+
+  // Scaling curves: every group with at least two distinct positive params.
+  std::map<std::string, std::vector<const bench::Result *>> groups;
+  for (const auto &r : results) {
+    if (r.param > 0.0) groups[r.group].push_back(&r);
+  }
+  bool printedHeader = false;
+  for (auto &[name, pts] : groups) {
+    if (pts.size() < 2) continue;
+    if (!printedHeader) { std::printf("\nScaling (ns/op ~ param^slope)\n"); printedHeader = true; }
+    std::sort(pts.begin(), pts.end(),
+              [](const bench::Result *a, const bench::Result *b) { return a->param < b->param; });
+    std::printf("  %-36s slope %.2f  [", name.c_str(), scalingSlope(pts));
+    for (size_t i = 0; i < pts.size(); ++i) {
+      std::printf("%s%g: %.0f ns", i ? ", " : "", pts[i]->param, pts[i]->nsPerOp);
+    }
+    std::printf("]\n");
+  }
+
+  // Cached property tables against the closed-form correlations they replace.
+  bool printedTables = false;
+  for (const auto &r : results) {
+    const std::string prefix = "FluidPropertyTable::lookup/";
+    if (r.name.compare(0, prefix.size(), prefix) != 0) continue;
+    const std::string ref = "evaluateFluid/" + r.name.substr(prefix.size());
+    for (const auto &e : results) {
+      if (e.name != ref || !(r.nsPerOp > 0.0)) continue;
+      if (!printedTables) { std::printf("\nTabulated vs closed-form fluid properties\n"); printedTables = true; }
+      std::printf("  %-36s %6.2fx faster  (max rel. error %.1e)\n", r.name.substr(prefix.size()).c_str(),
+                  e.nsPerOp / r.nsPerOp, r.metric);
+    }
+  }
+
+  if (!bench::writeJson(outPath, results)) {
+    std::fprintf(stderr, "Cannot write %s\n", outPath.c_str());
+    return 1;
+  }
+  std::printf("\nResults written to %s\n", outPath.c_str());
+
+  if (baselinePath.empty()) return 0;
+
+  std::vector<bench::Result> base;
+  if (!bench::readJson(baselinePath, base)) {
+    std::fprintf(stderr, "Cannot read baseline %s\n", baselinePath.c_str());
+    return 1;
+  }
+  std::map<std::string, const bench::Result *> byName;
+  for (const auto &b : base) byName[b.name] = &b;
+
+  int regressions = 0;
+  std::printf("\nComparison against %s (threshold +%.0f%%)\n", baselinePath.c_str(), threshold * 100.0);
+  for (const auto &r : results) {
+    const auto it = byName.find(r.name);
+    if (it == byName.end() || !(it->second->nsPerOp > 0.0)) continue;
+    const double ratio = r.nsPerOp / it->second->nsPerOp;
+    const bool slower = ratio > 1.0 + threshold;
+    const bool moreAllocs = r.allocsPerOp > it->second->allocsPerOp + 0.5;
+    if (slower || moreAllocs) ++regressions;
+    std::printf("  %-48s %6.2fx  allocs %6.2f -> %6.2f %s\n", r.name.c_str(), ratio,
+                it->second->allocsPerOp, r.allocsPerOp,
+                slower ? "REGRESSION" : (moreAllocs ? "ALLOC REGRESSION" : ""));
+  }
+  std::printf("%d regression(s)\n", regressions);
+  return regressions == 0 ? 0 : 1;
+}
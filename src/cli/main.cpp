@@ -0,0 +1,331 @@
+// heatxtwin_cli — headless batch runner for the hx_core physics library.
+//
+// Loads one or more configs/*.toml plant descriptions through
+// io::Config::fromToml, runs every case flat-out (no UI pacing, no event
+// loop) across a pool of worker threads and reports the aggregate simulator
+// throughput in steps per second.  Intended for Linux compute nodes without a
+// display; nothing here links against Qt.
+
+#include "core/Fouling.hpp"
+#include "core/Hydraulics.hpp"
+#include "core/Simulator.hpp"
+#include "core/Thermo.hpp"
+#include "io/Config.hpp"
+#include "io/CsvLogger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/** Mirrors MainWindow::SimulationMode so batch results match the GUI. */
+struct RunMode {
+  bool steady  = false;   // true = no disturbances
+  bool fouling = true;    // true = fouling model active
+};
+
+struct CliOptions {
+  std::vector<std::string> configs;
+  int         repeats   = 1;
+  int         threads   = 0;        // 0 ⇒ hardware_concurrency
+  double      tEnd      = -1.0;     // <0 ⇒ use config value
+  double      dt        = -1.0;
+  int         cells     = -1;
+  int         integrator = -1;      // <0 ⇒ use config value (hx::AxialIntegrator)
+  int         lumpedIntegrator = -1; // <0 ⇒ use config value (hx::LumpedIntegrator)
+  double      rtol      = -1.0;
+  double      atol      = -1.0;
+  RunMode     mode;
+  bool        steadyStart = false;  // start from Simulator::solveSteadyAxial()
+  std::string summaryPath;          // per-case final-state CSV
+  std::string traceDir;             // per-case full trace CSVs (slow)
+  bool        quiet     = false;
+};
+
+struct CaseResult {
+  int         configIndex = 0;
+  int         replicate   = 0;
+  long long   steps       = 0;
+  long long   forcedSteps = 0;   // dopri5 steps accepted over tolerance at the step-size floor
+  double      wallSeconds = 0.0;
+  hx::State   last{};
+  bool        ok          = false;
+  std::string error;
+};
+
+void printUsage(const char *argv0) {
+  std::fprintf(stderr,
+      "Usage: %s [options] <config.toml> [more.toml ...]\n"
+      "\n"
+      "Options:\n"
+      "  --repeat N        run every config N times (default 1)\n"
+      "  --threads N       worker threads (default: all hardware threads)\n"
+      "  --t-end S         override [simulation].tEnd [s]\n"
+      "  --dt S            override [simulation].dt [s]\n"
+      "  --cells N         override [simulation].numAxialCells (1 = lumped)\n"
+      "  --integrator I    axial integrator: explicit | backward-euler |\n"
+      "                    crank-nicolson (default: from config)\n"
+      "  --lumped-integrator I  lumped integrator: euler | dopri5\n"
+      "                    (default: from config)\n"
+      "  --rtol X, --atol X  dopri5 error tolerances (atol in K)\n"
+      "  --mode M          steady-clean | steady-fouling | dynamic-clean |\n"
+      "                    dynamic-fouling (default)\n"
+      "  --steady-start    start every case from the directly solved steady\n"
+      "                    state instead of the linear initial profile\n"
+      "  --summary PATH    write one CSV row per case with the final state\n"
+      "  --trace DIR       write a full per-step CSV per case (slow)\n"
+      "  --quiet           only print the throughput summary\n",
+      argv0);
+}
+
+bool parseMode(const char *s, RunMode &m) {
+  if (std::strcmp(s, "steady-clean") == 0)    { m = {true,  false}; return true; }
+  if (std::strcmp(s, "steady-fouling") == 0)  { m = {true,  true};  return true; }
+  if (std::strcmp(s, "dynamic-clean") == 0)   { m = {false, false}; return true; }
+  if (std::strcmp(s, "dynamic-fouling") == 0) { m = {false, true};  return true; }
+  return false;
+}
+
+bool parseIntegrator(const char *s, int &out) {
+  if (std::strcmp(s, "explicit") == 0)       { out = static_cast<int>(hx::AxialIntegrator::ExplicitSubstep); return true; }
+  if (std::strcmp(s, "backward-euler") == 0) { out = static_cast<int>(hx::AxialIntegrator::BackwardEuler);   return true; }
+  if (std::strcmp(s, "crank-nicolson") == 0) { out = static_cast<int>(hx::AxialIntegrator::CrankNicolson);   return true; }
+  return false;
+}
+
+bool parseLumpedIntegrator(const char *s, int &out) {
+  if (std::strcmp(s, "euler") == 0)  { out = static_cast<int>(hx::LumpedIntegrator::ExplicitEuler);   return true; }
+  if (std::strcmp(s, "dopri5") == 0) { out = static_cast<int>(hx::LumpedIntegrator::DormandPrince45); return true; }
+  return false;
+}
+
+bool parseArgs(int argc, char **argv, CliOptions &o) {
+  for (int i = 1; i < argc; ++i) {
+    const char *a = argv[i];
+    auto next = [&]() -> const char * { return (i + 1 < argc) ? argv[++i] : nullptr; };
+    const char *v = nullptr;
+    if (std::strcmp(a, "--help") == 0 || std::strcmp(a, "-h") == 0) {
+      return false;
+    } else if (std::strcmp(a, "--repeat") == 0 && (v = next())) {
+      o.repeats = std::max(1, std::atoi(v));
+    } else if (std::strcmp(a, "--threads") == 0 && (v = next())) {
+      o.threads = std::max(0, std::atoi(v));
+    } else if (std::strcmp(a, "--t-end") == 0 && (v = next())) {
+      o.tEnd = std::atof(v);
+    } else if (std::strcmp(a, "--dt") == 0 && (v = next())) {
+      o.dt = std::atof(v);
+    } else if (std::strcmp(a, "--cells") == 0 && (v = next())) {
+      o.cells = std::atoi(v);
+    } else if (std::strcmp(a, "--integrator") == 0 && (v = next())) {
+      if (!parseIntegrator(v, o.integrator)) {
+        std::fprintf(stderr, "Unknown integrator: %s\n", v);
+        return false;
+      }
+    } else if (std::strcmp(a, "--lumped-integrator") == 0 && (v = next())) {
+      if (!parseLumpedIntegrator(v, o.lumpedIntegrator)) {
+        std::fprintf(stderr, "Unknown lumped integrator: %s\n", v);
+        return false;
+      }
+    } else if (std::strcmp(a, "--rtol") == 0 && (v = next())) {
+      o.rtol = std::atof(v);
+    } else if (std::strcmp(a, "--atol") == 0 && (v = next())) {
+      o.atol = std::atof(v);
+    } else if (std::strcmp(a, "--mode") == 0 && (v = next())) {
+      if (!parseMode(v, o.mode)) {
+        std::fprintf(stderr, "Unknown mode: %s\n", v);
+        return false;
+      }
+    } else if (std::strcmp(a, "--steady-start") == 0) {
+      o.steadyStart = true;
+    } else if (std::strcmp(a, "--summary") == 0 && (v = next())) {
+      o.summaryPath = v;
+    } else if (std::strcmp(a, "--trace") == 0 && (v = next())) {
+      o.traceDir = v;
+    } else if (std::strcmp(a, "--quiet") == 0) {
+      o.quiet = true;
+    } else if (a[0] == '-') {
+      std::fprintf(stderr, "Unknown or incomplete option: %s\n", a);
+      return false;
+    } else {
+      o.configs.emplace_back(a);
+    }
+  }
+  return !o.configs.empty();
+}
+
+/** Run one case to completion exactly like SimWorker::run, minus the pacing. */
+CaseResult runCase(const io::AppConfig &app, const CliOptions &o,
+                   int configIndex, int replicate) {
+  CaseResult r;
+  r.configIndex = configIndex;
+  r.replicate   = replicate;
+
+  hx::SimConfig cfg = app.sim;
+  if (o.tEnd  > 0.0) cfg.tEnd = o.tEnd;
+  if (o.dt    > 0.0) cfg.dt   = o.dt;
+  if (o.cells > 0)   cfg.numAxialCells = o.cells;
+  if (o.integrator >= 0) cfg.axialIntegrator = static_cast<hx::AxialIntegrator>(o.integrator);
+  if (o.lumpedIntegrator >= 0) cfg.lumpedIntegrator = static_cast<hx::LumpedIntegrator>(o.lumpedIntegrator);
+  if (o.rtol > 0.0)  cfg.rtol = o.rtol;
+  if (o.atol > 0.0)  cfg.atol = o.atol;
+  if (cfg.dt <= 0.0) {
+    r.error = "dt must be positive";
+    return r;
+  }
+
+  hx::Thermo     thermo(app.geometry, app.hot, app.cold);
+  hx::Hydraulics hydro (app.geometry, app.hot, app.cold);
+  hx::Fouling    foul  (app.fouling);
+  thermo.setShellMethod(cfg.shellMethod);
+  hydro .setShellMethod(cfg.shellMethod);
+
+  hx::Simulator sim(thermo, hydro, foul, cfg);
+  sim.reset(app.op);
+  sim.setSteadyStateMode(o.mode.steady);
+  sim.setFoulingEnabled(o.mode.fouling);
+  if (o.steadyStart) {
+    const hx::SteadySolveResult ss = sim.solveSteadyAxial();
+    if (!ss.ok) {
+      r.error = hx::steadySolveMessage(ss);
+      return r;
+    }
+  }
+
+  io::CsvLogger trace;
+  if (!o.traceDir.empty()) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "/case_%04d_%04d.csv", configIndex, replicate);
+    if (!trace.open(o.traceDir + name)) {
+      r.error = "cannot open trace file in " + o.traceDir;
+      return r;
+    }
+  }
+
+  const auto t0 = std::chrono::steady_clock::now();
+  double t = 0.0;
+  while (t < cfg.tEnd) {
+    r.last = sim.step(t);
+    if (trace.isOpen()) trace.write(t, r.last);
+    t += cfg.dt;
+    ++r.steps;
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  r.forcedSteps = sim.integratorStats().forced;
+  r.wallSeconds = std::chrono::duration<double>(t1 - t0).count();
+  r.ok = true;
+  return r;
+}
+
+bool writeSummary(const std::string &path, const CliOptions &o,
+                  const std::vector<CaseResult> &results) {
+  std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+  if (!ofs) return false;
+  ofs << "config,replicate,steps,wall_s,Tc_out,Th_out,Q,U,Rf,dP_tube,dP_shell\n";
+  char line[512];
+  for (const auto &r : results) {
+    if (!r.ok) continue;
+    std::snprintf(line, sizeof(line),
+                  "%s,%d,%lld,%.6f,%.6f,%.6f,%.6f,%.6f,%.9g,%.6f,%.6f\n",
+                  o.configs[static_cast<size_t>(r.configIndex)].c_str(), r.replicate,
+                  r.steps, r.wallSeconds, r.last.Tc_out, r.last.Th_out, r.last.Q,
+                  r.last.U, r.last.Rf, r.last.dP_tube, r.last.dP_shell);
+    ofs << line;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+  CliOptions opts;
+  if (!parseArgs(argc, argv, opts)) {
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  std::vector<io::AppConfig> apps;
+  apps.reserve(opts.configs.size());
+  for (const auto &path : opts.configs) {
+    try {
+      apps.push_back(io::Config::fromToml(path));
+    } catch (const std::exception &e) {
+      std::fprintf(stderr, "Failed to load %s: %s\n", path.c_str(), e.what());
+      return 1;
+    }
+  }
+
+  const int nCases = static_cast<int>(apps.size()) * opts.repeats;
+  int nThreads = opts.threads > 0 ? opts.threads
+                                  : static_cast<int>(std::thread::hardware_concurrency());
+  nThreads = std::clamp(nThreads, 1, std::max(1, nCases));
+
+  // Cases are claimed from a shared counter so long and short configs
+  // balance themselves across the pool; each worker owns its own
+  // Thermo/Hydraulics/Fouling/Simulator, so nothing is shared while stepping.
+  std::vector<CaseResult> results(static_cast<size_t>(nCases));
+  std::atomic<int> nextCase{0};
+  std::atomic<int> completed{0};
+
+  auto worker = [&]() {
+    for (;;) {
+      const int k = nextCase.fetch_add(1);
+      if (k >= nCases) return;
+      const int ci = k / opts.repeats;
+      const int rep = k % opts.repeats;
+      results[static_cast<size_t>(k)] = runCase(apps[static_cast<size_t>(ci)], opts, ci, rep);
+      const int done = completed.fetch_add(1) + 1;
+      if (!opts.quiet) {
+        const auto &r = results[static_cast<size_t>(k)];
+        if (r.ok) {
+          std::fprintf(stderr, "[%d/%d] %s #%d: %lld steps in %.3f s, Q = %.1f W\n",
+                       done, nCases, opts.configs[static_cast<size_t>(ci)].c_str(), rep,
+                       r.steps, r.wallSeconds, r.last.Q);
+          if (r.forcedSteps > 0) {
+            std::fprintf(stderr, "  warning: dopri5 accepted %lld internal steps over tolerance "
+                                 "at the step-size floor\n", r.forcedSteps);
+          }
+        } else {
+          std::fprintf(stderr, "[%d/%d] %s #%d: FAILED (%s)\n",
+                       done, nCases, opts.configs[static_cast<size_t>(ci)].c_str(), rep,
+                       r.error.c_str());
+        }
+      }
+    }
+  };
+
+  const auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  pool.reserve(static_cast<size_t>(nThreads));
+  for (int i = 0; i < nThreads; ++i) pool.emplace_back(worker);
+  for (auto &th : pool) th.join();
+  const auto t1 = std::chrono::steady_clock::now();
+  const double wall = std::chrono::duration<double>(t1 - t0).count();
+
+  long long totalSteps = 0;
+  int failed = 0;
+  for (const auto &r : results) {
+    if (r.ok) totalSteps += r.steps;
+    else ++failed;
+  }
+
+  if (!opts.summaryPath.empty() && !writeSummary(opts.summaryPath, opts, results)) {
+    std::fprintf(stderr, "Cannot write summary to %s\n", opts.summaryPath.c_str());
+    return 1;
+  }
+
+  std::printf("cases: %d (%d failed)  threads: %d  steps: %lld  wall: %.3f s  "
+              "throughput: %.0f steps/s (%.0f steps/s/thread)\n",
+              nCases, failed, nThreads, totalSteps, wall,
+              wall > 0.0 ? static_cast<double>(totalSteps) / wall : 0.0,
+              wall > 0.0 ? static_cast<double>(totalSteps) / wall / nThreads : 0.0);
+  return failed == 0 ? 0 : 1;
+}
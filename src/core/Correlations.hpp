@@ -0,0 +1,268 @@
+#pragma once
+
+#include "BellDelaware.hpp"
+#include "Scalar.hpp"
+#include "Types.hpp"
+#include <cmath>
+
+namespace hx {
+
+/**
+ * \brief Geometry with every continuous field in the scalar type \c T.
+ *
+ *  hx::Geometry holds doubles and integer tube / baffle counts; the
+ *  correlations below accept either, so a ScalarGeometry<Dual<N>> carries
+ *  derivatives with respect to the seeded fields (the counts included, as a
+ *  continuous relaxation).
+ */
+template <class T>
+struct ScalarGeometry {
+  T nTubes = 1.0;
+  T Di = 0.0, Do = 0.0, L = 0.0, pitch = 0.0, shellID = 0.0;
+  T baffleSpacing = 0.0, baffleCutFrac = 0.0;
+  T nBaffles = 1.0;
+  T wall_k = 0.0, wall_thickness = 0.0;
+  T K_minor_tube = 1.5;
+  T K_turns_shell = 0.0;
+
+  static ScalarGeometry from(const Geometry &g) {
+    ScalarGeometry s;
+    s.nTubes = static_cast<double>(g.nTubes);
+    s.Di = g.Di; s.Do = g.Do; s.L = g.L; s.pitch = g.pitch; s.shellID = g.shellID;
+    s.baffleSpacing = g.baffleSpacing; s.baffleCutFrac = g.baffleCutFrac;
+    s.nBaffles = static_cast<double>(g.nBaffles);
+    s.wall_k = g.wall_k; s.wall_thickness = g.wall_thickness;
+    s.K_minor_tube = g.K_minor_tube; s.K_turns_shell = g.K_turns_shell;
+    return s;
+  }
+
+  [[nodiscard]] T areaOuter() const { return 3.14159265358979323846 * Do * L * nTubes; }
+};
+
+// =============================================================================
+// Heat transfer (Thermo)
+//
+// Templated on the scalar type T of the flows / fouling arguments; G is
+// hx::Geometry or ScalarGeometry<T>.  Fluid properties stay double.  Thermo's
+// members are these functions at T = double.
+// =============================================================================
+
+/** Wall conduction resistance per unit outer area: ln(Do/Di)·Do / (2·k_wall) [m²K/W]. */
+template <class T, class G>
+T wallResistanceOf(const G &g) {
+  using std::log;
+  const T Do = g.Do;
+  return log(Do / maxOf(g.Di, 1e-9)) * Do / (2.0 * maxOf(g.wall_k, 1e-9));
+}
+
+/** Tube-side h: Dittus–Boelter (n = 0.4) above Re 2300, Nu = 4.36 below [W/m²K]. */
+template <class T, class G>
+T tubeCoefficient(const G &g, const Fluid &hot, const T &m_dot_hot) {
+  using std::pow;
+  constexpr double PI = 3.14159265358979323846;
+  const T Di = g.Di;
+  const T A  = PI * (Di * Di) / 4.0 * maxOf(1, g.nTubes);
+  const T v  = (m_dot_hot / hot.rho) / A;
+  const T Re = hot.rho * v * Di / hot.mu;
+  const double Pr = hot.cp * hot.mu / hot.k;
+  const T Nu = (Re < 2300.0) ? T(4.36) : T(0.023 * pow(Re, 0.8) * std::pow(Pr, 0.4));
+  return Nu * hot.k / Di;
+}
+
+/** Kern shell-side equivalent diameter narrowed by a deposit of Rf_shell·k_deposit [m]. */
+template <class T, class G>
+T kernEquivalentDiameter(const G &g, const T &Rf_shell, const T &k_deposit) {
+  const T delta_shell = Rf_shell * k_deposit;
+  const T De_clean = g.shellID - g.Do;
+  return maxOf(1e-6, T(De_clean - 2.0 * delta_shell));
+}
+
+/** Kern-style (Zhukauskas) shell-side h at equivalent diameter \p De [W/m²K]. */
+template <class T, class G>
+T kernShellCoefficient(const G &g, const Fluid &cold, const T &m_dot_cold, const T &De) {
+  using std::pow;
+  // As = (Ds / Pt) · (Pt − Do) · B
+  const T As = (g.shellID / maxOf(g.pitch, 1e-6)) * (g.pitch - g.Do) * g.baffleSpacing;
+  const T v  = (m_dot_cold / cold.rho) / maxOf(As, 1e-6);
+  const T Re = cold.rho * v * De / cold.mu;
+  const double Pr = cold.cp * cold.mu / cold.k;
+  // Nu = C · Re^m · Pr^n · (Pr/Pr_w)^0.25 with C = 0.27, m = 0.63, n = 0.37 and
+  // the viscosity-ratio term taken as 1 (see Thermo::h_shell()).
+  const T Nu = 0.27 * pow(maxOf(Re, 1.0), 0.63) * std::pow(Pr, 0.37);
+  return Nu * cold.k / De;
+}
+
+/** Shell-side h of either method, with the deposit narrowing the gap (Kern) or thickening the ODs (Bell–Delaware). */
+template <class T, class G>
+T shellCoefficient(const G &g, const BasicBellDelaware<T> &bd, ShellSideMethod method,
+                   const Fluid &cold, const T &m_dot_cold, const T &Rf_shell, const T &k_deposit) {
+  if (method == ShellSideMethod::BellDelaware) {
+    return bd.evaluate(cold, m_dot_cold, Rf_shell, k_deposit).h_shell;
+  }
+  return kernShellCoefficient(g, cold, m_dot_cold, kernEquivalentDiameter(g, Rf_shell, k_deposit));
+}
+
+/** Overall U on the outer area: 1/U = 1/h_s + R_w + (1/h_t)·(Di/Do) + Rf_s + Rf_t. */
+template <class T, class G>
+T overallCoefficient(const G &g, const T &Rw, const T &h_t, const T &h_s,
+                     const T &Rf_shell, const T &Rf_tube) {
+  const T ht = maxOf(h_t, 1.0);
+  const T hs = maxOf(h_s, 1.0);
+  const T invU = (1.0 / hs) + Rw + (1.0 / ht) * (g.Di / g.Do) + Rf_shell + Rf_tube;
+  return 1.0 / maxOf(invU, 1e-9);
+}
+
+/** ε for counter-flow (Kays & London, Table 11-2). */
+template <class T>
+T effectivenessCounter(const T &NTU, const T &Cr) {
+  using std::abs;
+  using std::exp;
+  if (abs(1.0 - Cr) < 1e-12) return NTU / (1.0 + NTU);
+  const T e = exp(-NTU * (1.0 - Cr));
+  return (1.0 - e) / (1.0 - Cr * e);
+}
+
+/** ε for parallel-flow. */
+template <class T>
+T effectivenessParallel(const T &NTU, const T &Cr) {
+  using std::exp;
+  return (1.0 - exp(-NTU * (1.0 + Cr))) / (1.0 + Cr);
+}
+
+/** ε for 1-shell-pass, 2-tube-pass heat exchanger. */
+template <class T>
+T effectivenessShellTube12(const T &NTU, const T &Cr) {
+  using std::exp;
+  using std::sqrt;
+  const T s = sqrt(1.0 + Cr * Cr);
+  const T e = exp(-NTU * s);
+  const T bracket = (1.0 + Cr) + s * (1.0 + e) / (1.0 - e);
+  return 2.0 / maxOf(bracket, 1e-12);
+}
+
+/** ε for n-shell-pass, 2n-tube-pass (via Kays–London recursion on ε₁). */
+template <class T>
+T effectivenessShellTubeN(int n, const T &NTU, const T &Cr) {
+  using std::abs;
+  using std::pow;
+  const T eps1 = effectivenessShellTube12(T(NTU / static_cast<double>(n)), Cr);
+  if (abs(1.0 - Cr) < 1e-12) {
+    return n * eps1 / (1.0 + (n - 1) * eps1);
+  }
+  const T ratio = (1.0 - eps1 * Cr) / maxOf(T(1.0 - eps1), 1e-12);
+  const T E = pow(ratio, static_cast<double>(n));
+  return (E - 1.0) / maxOf(T(E - Cr), 1e-12);
+}
+
+/** ε of arrangement \p a at \p NTU and capacity ratio \p Cr. */
+template <class T>
+T effectiveness(FlowArrangement a, const T &NTU, const T &Cr) {
+  switch (a) {
+    case FlowArrangement::ParallelFlow:   return effectivenessParallel(NTU, Cr);
+    case FlowArrangement::ShellTube_1_2:  return effectivenessShellTube12(NTU, Cr);
+    case FlowArrangement::ShellTube_2_4:  return effectivenessShellTubeN(2, NTU, Cr);
+    case FlowArrangement::CounterFlow:
+    default:                               return effectivenessCounter(NTU, Cr);
+  }
+}
+
+/** \brief Steady outlets and duty of an ε–NTU rating. */
+template <class T>
+struct SteadyOutlets {
+  T Q      = 0.0;   // [W]
+  T Tc_out = 0.0;   // [C]
+  T Th_out = 0.0;   // [C]
+};
+
+/** ε–NTU outlets for conductance \p UA and capacity rates \p Ch, \p Cc. */
+template <class T>
+SteadyOutlets<T> epsNtuOutlets(FlowArrangement a, const T &UA, const T &Ch, const T &Cc,
+                               double Th_in, double Tc_in) {
+  const T Cmin = minOf(Ch, Cc);
+  const T Cmax = maxOf(Ch, Cc);
+  const T Cr   = Cmin / maxOf(Cmax, 1e-12);
+  const T NTU  = UA / maxOf(Cmin, 1e-12);
+  const T eps  = effectiveness(a, NTU, Cr);
+
+  SteadyOutlets<T> o;
+  o.Q      = eps * Cmin * (Th_in - Tc_in);
+  o.Tc_out = Tc_in + o.Q / maxOf(Cc, 1e-12);
+  o.Th_out = Th_in - o.Q / maxOf(Ch, 1e-12);
+  return o;
+}
+
+// =============================================================================
+// Pressure drop (Hydraulics)
+// =============================================================================
+
+/** Darcy friction factor in a tube: 64/Re laminar, Blasius 0.3164·Re^-0.25 turbulent. */
+template <class T>
+T tubeFrictionFactor(const T &Re) {
+  using std::sqrt;
+  if (Re < 1e-12) return 1.0; // degenerate
+  if (Re < 2300.0) return 64.0 / maxOf(Re, 1.0);
+  // Re^-0.25 == 1/sqrt(sqrt(Re)); two sqrts are meaningfully cheaper than pow().
+  const T inv_fourth = 1.0 / sqrt(sqrt(Re));
+  return 0.3164 * inv_fourth;
+}
+
+/** Shell-side cross-flow friction factor, f = 1.44·Re^-0.15 (Kern-like). */
+template <class T>
+T shellFrictionFactor(const T &Re) {
+  using std::pow;
+  if (Re < 1e-12) return 1.0;
+  return 1.44 * pow(Re, -0.15);
+}
+
+/** Tube-side ΔP: Darcy–Weisbach on the fouled bore plus K_minor velocity heads [Pa]. */
+template <class T, class G>
+T tubePressureDrop(const G &g, const Fluid &hot, const T &m_dot_hot, const T &Rf_tube,
+                   const T &k_deposit, const T &K_minor) {
+  constexpr double PI = 3.14159265358979323846;
+  // Reduce the bore by the deposit thickness ~ Rf · k_deposit.
+  const T t_dep  = maxOf(0.0, Rf_tube) * k_deposit;
+  const T Di_eff = maxOf(1e-6, T(g.Di - 2.0 * t_dep));
+
+  const T A_total = PI * (Di_eff * Di_eff) / 4.0 * maxOf(1, g.nTubes);
+  const T v  = (m_dot_hot / hot.rho) / maxOf(A_total, 1e-12);
+  const T Re = hot.rho * v * Di_eff / std::max(hot.mu, 1e-12);
+  const T f  = tubeFrictionFactor(Re);
+  const T dp_fric  = f * (g.L / Di_eff) * 0.5 * hot.rho * v * v;
+  const T dp_minor = K_minor * 0.5 * hot.rho * v * v;   // entrance / exit / bends
+  return maxOf(0.0, T(dp_fric + dp_minor));
+}
+
+/** Kern-style shell-side ΔP with the deposit narrowing the gap, plus K_turns velocity heads [Pa]. */
+template <class T, class G>
+T kernShellPressureDrop(const G &g, const Fluid &cold, const T &m_dot_cold, const T &Rf_shell,
+                        const T &k_deposit, const T &K_turns) {
+  // Fouling changes the shell-side hydraulic diameter: recalculate Re and velocity.
+  const T delta_shell = maxOf(0.0, Rf_shell) * k_deposit;
+  const T De_clean = maxOf(1e-6, T(g.shellID - g.Do));
+  const T De_eff   = maxOf(1e-6, T(De_clean - 2.0 * delta_shell));   // deposit on both sides of the gap
+
+  // Flow area (Kern) scales with the gap.
+  const T As_clean = (g.shellID / maxOf(g.pitch, 1e-6)) * (g.pitch - g.Do) * g.baffleSpacing;
+  const T As_eff   = As_clean * (De_eff / De_clean);
+  const T v_eff    = (m_dot_cold / cold.rho) / maxOf(As_eff, 1e-12);
+  const T Re_eff   = cold.rho * v_eff * De_eff / std::max(cold.mu, 1e-12);
+  const T f        = shellFrictionFactor(Re_eff);
+
+  const T Leq      = g.nBaffles * maxOf(g.baffleSpacing, 1e-6);
+  const T dp_fric  = f * (Leq / De_eff) * 0.5 * cold.rho * v_eff * v_eff;
+  const T dp_minor = K_turns * 0.5 * cold.rho * v_eff * v_eff;       // turn / baffle losses
+  return maxOf(0.0, T(dp_fric + dp_minor));
+}
+
+/** Shell-side ΔP of either method (Bell–Delaware ignores \p K_turns). */
+template <class T, class G>
+T shellPressureDrop(const G &g, const BasicBellDelaware<T> &bd, ShellSideMethod method,
+                    const Fluid &cold, const T &m_dot_cold, const T &Rf_shell, const T &k_deposit,
+                    const T &K_turns) {
+  if (method == ShellSideMethod::BellDelaware) {
+    return bd.evaluate(cold, m_dot_cold, Rf_shell, k_deposit).dP_shell;
+  }
+  return kernShellPressureDrop(g, cold, m_dot_cold, Rf_shell, k_deposit, K_turns);
+}
+
+} // namespace hx
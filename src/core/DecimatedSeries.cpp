@@ -0,0 +1,113 @@
+#include "DecimatedSeries.hpp"
+
+#include <algorithm>
+
+namespace hx {
+
+void DecimatedSeries::append(double x, double y) {
+  xs_.push_back(x);
+  ys_.push_back(y);
+
+  // Carry completed groups upwards: a level-1 bucket every kFanout samples,
+  // a level-2 bucket every kFanout level-1 buckets, and so on.
+  if (xs_.size() % kFanout != 0) return;
+  Bucket b;
+  const size_t r0 = xs_.size() - kFanout;
+  b.xMin = b.xMax = xs_[r0];
+  b.yMin = b.yMax = ys_[r0];
+  for (size_t i = r0 + 1; i < xs_.size(); ++i) {
+    if (ys_[i] < b.yMin) { b.yMin = ys_[i]; b.xMin = xs_[i]; }
+    if (ys_[i] > b.yMax) { b.yMax = ys_[i]; b.xMax = xs_[i]; }
+  }
+
+  for (size_t l = 0;; ++l) {
+    if (l == levels_.size()) levels_.emplace_back();
+    std::vector<Bucket> &level = levels_[l];
+    level.push_back(b);
+    if (level.size() % kFanout != 0) return;
+
+    const size_t c0 = level.size() - kFanout;
+    b = level[c0];
+    for (size_t i = c0 + 1; i < level.size(); ++i) {
+      if (level[i].yMin < b.yMin) { b.yMin = level[i].yMin; b.xMin = level[i].xMin; }
+      if (level[i].yMax > b.yMax) { b.yMax = level[i].yMax; b.xMax = level[i].xMax; }
+    }
+  }
+}
+
+void DecimatedSeries::clear() {
+  xs_.clear();
+  ys_.clear();
+  levels_.clear();
+}
+
+void DecimatedSeries::reserve(size_t n) {
+  xs_.reserve(n);
+  ys_.reserve(n);
+}
+
+void DecimatedSeries::emitBucket(const Bucket &b, std::vector<SeriesPoint> &out) const {
+  if (b.xMin == b.xMax && b.yMin == b.yMax) {
+    out.push_back({b.xMin, b.yMin});
+  } else if (b.xMin <= b.xMax) {
+    out.push_back({b.xMin, b.yMin});
+    out.push_back({b.xMax, b.yMax});
+  } else {
+    out.push_back({b.xMax, b.yMax});
+    out.push_back({b.xMin, b.yMin});
+  }
+}
+
+void DecimatedSeries::emitRange(size_t level, size_t i0, size_t i1,
+                                std::vector<SeriesPoint> &out) const {
+  if (i0 >= i1) return;
+  if (level == 0) {
+    for (size_t i = i0; i < i1; ++i) out.push_back({xs_[i], ys_[i]});
+    return;
+  }
+
+  size_t span = 1;
+  for (size_t l = 0; l < level; ++l) span *= kFanout;
+
+  // Whole buckets inside [i0, i1); the ragged head and tail (and the bucket
+  // still being filled at the live edge) come from the next finer level.
+  const std::vector<Bucket> &buckets = levels_[level - 1];
+  const size_t b0 = (i0 + span - 1) / span;
+  const size_t b1 = std::min(i1 / span, buckets.size());
+  if (b0 >= b1) {
+    emitRange(level - 1, i0, i1, out);
+    return;
+  }
+  emitRange(level - 1, i0, b0 * span, out);
+  for (size_t b = b0; b < b1; ++b) emitBucket(buckets[b], out);
+  emitRange(level - 1, b1 * span, i1, out);
+}
+
+size_t DecimatedSeries::decimate(double xLo, double xHi, size_t buckets,
+                                 std::vector<SeriesPoint> &out) const {
+  out.clear();
+  if (xs_.empty()) return 0;
+
+  size_t i0 = static_cast<size_t>(std::lower_bound(xs_.begin(), xs_.end(), xLo) - xs_.begin());
+  size_t i1 = static_cast<size_t>(std::upper_bound(xs_.begin(), xs_.end(), xHi) - xs_.begin());
+  if (i0 > 0) --i0;
+  if (i1 < xs_.size()) ++i1;
+  if (i0 >= i1) return 0;
+
+  // Finest level with at most 2 × buckets buckets in range: more than
+  // buckets / 2 of them, at one (flat) or two vertices each.
+  const size_t count = i1 - i0;
+  const size_t limit = 2 * std::max<size_t>(buckets, 1);
+  size_t level = 0;
+  size_t span = 1;
+  while (count / span > limit && level < levels_.size()) {
+    ++level;
+    span *= kFanout;
+  }
+
+  out.reserve(2 * (count / span) + 4 * kFanout * (level + 1));
+  emitRange(level, i0, i1, out);
+  return level;
+}
+
+} // namespace hx
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace hx {
+
+/** \brief One (x, y) vertex of a decimated trace. */
+struct SeriesPoint {
+  double x = 0.0;
+  double y = 0.0;
+};
+
+/**
+ * \brief Append-only time series with an incremental min/max level-of-detail pyramid.
+ *
+ *  The full history is kept as two flat columns (x, y).  Alongside it, level
+ *  l ≥ 1 holds one bucket per kFanout^l consecutive samples with the bucket's
+ *  minimum and maximum and where they occur; a bucket is written the moment
+ *  its last child is complete, so append() is amortised O(1) and the pyramid
+ *  costs about 1/(kFanout−1) of the raw storage.
+ *
+ *  decimate() answers "what should a plot of [xLo, xHi] that is \p buckets
+ *  pixels wide draw": it picks the finest level with at most 2 × \p buckets
+ *  buckets in range — more than \p buckets / 2, since the next finer level
+ *  has kFanout times as many — and emits each bucket's min and max in x
+ *  order (one vertex when the bucket is flat).  The result therefore has
+ *  between about \p buckets / 2 and 4 × \p buckets vertices (plus the
+ *  ragged ends) whatever the history length, and every spike survives
+ *  (min/max rather than LTTB because min/max buckets merge exactly, which is
+ *  what lets the pyramid be built incrementally).  Ranges of at most
+ *  2 × \p buckets samples are returned at full resolution.
+ *
+ *  x must be non-decreasing (simulation time).
+ */
+class DecimatedSeries {
+public:
+  static constexpr size_t kFanout = 4;
+
+  void append(double x, double y);
+  void clear();
+  void reserve(size_t n);
+
+  [[nodiscard]] size_t size() const { return xs_.size(); }
+  [[nodiscard]] bool empty() const { return xs_.empty(); }
+  [[nodiscard]] double firstX() const { return xs_.front(); }
+  [[nodiscard]] double lastX() const { return xs_.back(); }
+  [[nodiscard]] double x(size_t i) const { return xs_[i]; }
+  [[nodiscard]] double y(size_t i) const { return ys_[i]; }
+  /** Number of pyramid levels above the raw samples. */
+  [[nodiscard]] size_t levels() const { return levels_.size(); }
+
+  /**
+   * \brief Points to draw for the x-range [xLo, xHi] at \p buckets horizontal resolution.
+   *  Replaces \p out.  One sample on each side of the range is included so
+   *  the line runs to the plot edges.  Returns the pyramid level used
+   *  (0 = raw samples).
+   */
+  size_t decimate(double xLo, double xHi, size_t buckets, std::vector<SeriesPoint> &out) const;
+
+private:
+  struct Bucket {
+    double xMin = 0.0, yMin = 0.0;  // position and value of the minimum
+    double xMax = 0.0, yMax = 0.0;  // position and value of the maximum
+  };
+
+  void emitBucket(const Bucket &b, std::vector<SeriesPoint> &out) const;
+  /** Emit raw samples [i0, i1) at level \p level, finishing the partial tail one level down. */
+  void emitRange(size_t level, size_t i0, size_t i1, std::vector<SeriesPoint> &out) const;
+
+  // --- Raw columns -------------------------------------------------------------
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+
+  // --- Pyramid: levels_[l-1] has one bucket per kFanout^l samples ----------------
+  std::vector<std::vector<Bucket>> levels_;
+};
+
+} // namespace hx
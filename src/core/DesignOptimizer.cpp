@@ -0,0 +1,528 @@
+#include "DesignOptimizer.hpp"
+
+#include "Correlations.hpp"
+#include "Dual.hpp"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace hx {
+
+namespace {
+
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+/** Design variables, in SweepSettings order. */
+constexpr int kVariables = 8;
+const char *const kVariableNames[kVariables] = {
+  "nTubes", "Do", "Di", "L", "pitch", "shellID", "baffleSpacing", "baffleCutFrac",
+};
+
+/** One derivative lane per design variable. */
+using DesignDual = Dual<kVariables>;
+
+constexpr double kPi = 3.14159265358979323846;
+
+template <class T>
+T &variable(ScalarGeometry<T> &g, int i) {
+  switch (i) {
+    case 0:  return g.nTubes;
+    case 1:  return g.Do;
+    case 2:  return g.Di;
+    case 3:  return g.L;
+    case 4:  return g.pitch;
+    case 5:  return g.shellID;
+    case 6:  return g.baffleSpacing;
+    default: return g.baffleCutFrac;
+  }
+}
+
+const DesignBounds &bounds(const OptimizeSettings &s, int i) {
+  const DesignBounds *b[kVariables] = {&s.nTubes, &s.Do, &s.Di, &s.L, &s.pitch, &s.shellID,
+                                       &s.baffleSpacing, &s.baffleCutFrac};
+  return *b[i];
+}
+
+// -----------------------------------------------------------------------------
+// Model
+// -----------------------------------------------------------------------------
+
+/** Steady rating of one design: the outputs of Thermo::steady() and the Hydraulics members. */
+template <class T>
+struct Rating {
+  T Q = 0.0, U = 0.0, Tc_out = 0.0, Th_out = 0.0;
+  T dP_tube = 0.0, dP_shell = 0.0;
+  T area = 0.0;
+};
+
+/**
+ * Thermo::steady() plus Hydraulics::dP_tube() / dP_shell() on the scalar
+ * type T; at T = double the results are bit-identical to the classes.
+ */
+template <class T>
+Rating<T> rate(const ScalarGeometry<T> &g, const OperatingPoint &op, const Fluid &hot,
+               const Fluid &cold, const OptimizeSettings &s) {
+  const BasicBellDelaware<T> bd(g);
+  const T m_hot  = op.m_dot_hot;
+  const T m_cold = op.m_dot_cold;
+  const T Rf_s = s.Rf_shell, Rf_t = s.Rf_tube, k_dep = s.k_deposit;
+
+  // As Thermo::U(): the clean shell coefficient below 1e-9 m²K/W of fouling.
+  const T hs = (s.Rf_shell > 1e-9)
+                   ? shellCoefficient(g, bd, s.shellMethod, cold, m_cold, Rf_s, k_dep)
+                   : shellCoefficient(g, bd, s.shellMethod, cold, m_cold, T(0.0), T(0.5));
+  const T ht = tubeCoefficient(g, hot, m_hot);
+
+  Rating<T> r;
+  r.U    = overallCoefficient(g, wallResistanceOf<T>(g), ht, maxOf(hs, 1.0), Rf_s, Rf_t);
+  r.area = g.areaOuter();
+  const SteadyOutlets<T> o = epsNtuOutlets(s.arrangement, T(r.U * r.area), T(m_hot * hot.cp),
+                                           T(m_cold * cold.cp), op.Tin_hot, op.Tin_cold);
+  r.Q      = o.Q;
+  r.Tc_out = o.Tc_out;
+  r.Th_out = o.Th_out;
+  r.dP_tube  = tubePressureDrop(g, hot, m_hot, Rf_t, k_dep, g.K_minor_tube);
+  r.dP_shell = shellPressureDrop(g, bd, s.shellMethod, cold, m_cold, Rf_s, k_dep, g.K_turns_shell);
+  return r;
+}
+
+/** Constraints c(x) ≤ 0, each scaled to be O(1). */
+enum class Constraint : int { Duty, TubeDrop, ShellDrop, Area, Wall, Pitch, Baffle, Bundle };
+
+template <class T>
+T constraintValue(Constraint c, const Rating<T> &r, const ScalarGeometry<T> &g,
+                  const OptimizeSettings &s) {
+  switch (c) {
+    case Constraint::Duty:      return 1.0 - r.Q / s.Q_min;
+    case Constraint::TubeDrop:  return r.dP_tube / s.dP_tube_max - 1.0;
+    case Constraint::ShellDrop: return r.dP_shell / s.dP_shell_max - 1.0;
+    case Constraint::Area:      return r.area / s.area_max - 1.0;
+    case Constraint::Wall:      return g.Di / (s.maxDiRatio * g.Do) - 1.0;
+    case Constraint::Pitch:     return 1.0 - g.pitch / (s.minPitchRatio * g.Do);
+    case Constraint::Baffle:    return g.baffleSpacing / g.L - 1.0;
+    case Constraint::Bundle:
+    default: {
+      // Triangular layout: Nt · (√3/2)·pitch² inside the circle of diameter shellID − Do.
+      const T otl = maxOf(T(g.shellID - g.Do), 1e-6);
+      return g.nTubes * 0.8660254037844386 * g.pitch * g.pitch / (0.25 * kPi * otl * otl) - 1.0;
+    }
+  }
+}
+
+template <class T>
+T objectiveValue(DesignObjective o, const Rating<T> &r) {
+  switch (o) {
+    case DesignObjective::MinPressureDrop: return r.dP_tube + r.dP_shell;
+    case DesignObjective::MaxDuty:         return -r.Q;
+    case DesignObjective::MinArea:
+    default:                               return r.area;
+  }
+}
+
+/** Objective, constraints and their gradients at one point of the scaled design space. */
+struct Evaluation {
+  double   f = 0.0;
+  VectorXd g;        // ∇f
+  VectorXd c;        // constraints
+  MatrixXd J;        // ∂c/∂u
+  [[nodiscard]] double violation() const { return c.cwiseMax(0.0).sum(); }
+};
+
+/** The optimisation problem over u ∈ [0, 1]ⁿ, x_i = lo_i + u_i·(hi_i − lo_i). */
+class Problem {
+public:
+  Problem(const OperatingPoint &op, const Fluid &hot, const Fluid &cold, const OptimizeSettings &s)
+      : op_(op), hot_(hot), cold_(cold), s_(s) {
+    bool freed[kVariables];
+    for (int i = 0; i < kVariables; ++i) {
+      freed[i] = bounds(s, i).free();
+      if (freed[i]) free_.push_back(i);
+    }
+    bafflesFollow_ = freed[3] || freed[6];
+    if (s.Q_min > 0.0)        constraints_.push_back(Constraint::Duty);
+    if (s.dP_tube_max > 0.0)  constraints_.push_back(Constraint::TubeDrop);
+    if (s.dP_shell_max > 0.0) constraints_.push_back(Constraint::ShellDrop);
+    if (s.area_max > 0.0)     constraints_.push_back(Constraint::Area);
+    if (freed[2] || freed[1]) constraints_.push_back(Constraint::Wall);
+    if (freed[4] || freed[1]) constraints_.push_back(Constraint::Pitch);
+    if (bafflesFollow_)       constraints_.push_back(Constraint::Baffle);
+    if (freed[0] || freed[1] || freed[4] || freed[5]) constraints_.push_back(Constraint::Bundle);
+  }
+
+  [[nodiscard]] Eigen::Index variables() const { return static_cast<Eigen::Index>(free_.size()); }
+  [[nodiscard]] Eigen::Index constraints() const { return static_cast<Eigen::Index>(constraints_.size()); }
+  [[nodiscard]] int evaluations() const { return evaluations_; }
+
+  /** Scaled start: the base geometry clipped into the bounds. */
+  [[nodiscard]] VectorXd start() const {
+    VectorXd u(variables());
+    ScalarGeometry<double> g = ScalarGeometry<double>::from(s_.base);
+    for (Eigen::Index k = 0; k < u.size(); ++k) {
+      const int i = free_[static_cast<size_t>(k)];
+      const DesignBounds &b = bounds(s_, i);
+      u[k] = std::clamp((variable(g, i) - b.lo) / (b.hi - b.lo), 0.0, 1.0);
+    }
+    return u;
+  }
+
+  /** Geometry at \p u, seeded so lane k carries ∂/∂u_k. */
+  template <class T>
+  [[nodiscard]] ScalarGeometry<T> geometryAt(const VectorXd &u) const {
+    ScalarGeometry<T> g = ScalarGeometry<T>::from(s_.base);
+    for (Eigen::Index k = 0; k < u.size(); ++k) {
+      const int i = free_[static_cast<size_t>(k)];
+      const DesignBounds &b = bounds(s_, i);
+      variable(g, i) = seed<T>(b.lo + u[k] * (b.hi - b.lo), static_cast<int>(k), b.hi - b.lo);
+    }
+    if (bafflesFollow_) g.nBaffles = g.L / g.baffleSpacing;   // relaxed floor(L / spacing)
+    return g;
+  }
+
+  /** Objective (divided by \p fScale), constraints and exact gradients at \p u. */
+  [[nodiscard]] Evaluation evaluate(const VectorXd &u, double fScale = 1.0) {
+    ++evaluations_;
+    const ScalarGeometry<DesignDual> g = geometryAt<DesignDual>(u);
+    const Rating<DesignDual> r = rate(g, op_, hot_, cold_, s_);
+    const DesignDual f = objectiveValue(s_.objective, r);
+
+    Evaluation e;
+    const Eigen::Index n = variables(), m = constraints();
+    e.f = f.value() / fScale;
+    e.g.resize(n);
+    for (Eigen::Index k = 0; k < n; ++k) e.g[k] = f.derivative(static_cast<int>(k)) / fScale;
+    e.c.resize(m);
+    e.J.resize(m, n);
+    for (Eigen::Index j = 0; j < m; ++j) {
+      const DesignDual c = constraintValue(constraints_[static_cast<size_t>(j)], r, g, s_);
+      e.c[j] = c.value();
+      for (Eigen::Index k = 0; k < n; ++k) e.J(j, k) = c.derivative(static_cast<int>(k));
+    }
+    return e;
+  }
+
+  /** The design at \p u made buildable: nTubes rounded up, nBaffles floored as in the sweep. */
+  [[nodiscard]] Geometry rounded(const VectorXd &u) const {
+    const ScalarGeometry<double> x = geometryAt<double>(u);
+    Geometry g = s_.base;
+    g.nTubes = std::max(1, static_cast<int>(std::ceil(x.nTubes - 1e-6)));
+    g.Do = x.Do; g.Di = x.Di; g.L = x.L; g.pitch = x.pitch; g.shellID = x.shellID;
+    g.baffleSpacing = x.baffleSpacing; g.baffleCutFrac = x.baffleCutFrac;
+    if (bafflesFollow_) g.nBaffles = std::max(1, static_cast<int>(std::floor(g.L / g.baffleSpacing + 1e-9)));
+    return g;
+  }
+
+  /** Rating of \p g and the largest scaled constraint value (≤ 0 when feasible). */
+  [[nodiscard]] Rating<double> rateGeometry(const Geometry &g, double *worst) const {
+    const ScalarGeometry<double> x = ScalarGeometry<double>::from(g);
+    const Rating<double> r = rate(x, op_, hot_, cold_, s_);
+    *worst = -1.0;
+    for (Constraint c : constraints_) *worst = std::max(*worst, constraintValue(c, r, x, s_));
+    return r;
+  }
+
+private:
+  template <class T>
+  static T seed(double v, int lane, double scale);
+
+  OperatingPoint          op_;
+  Fluid                   hot_, cold_;
+  const OptimizeSettings &s_;
+  std::vector<int>        free_;          // geometry variable of each optimisation variable
+  std::vector<Constraint> constraints_;
+  bool                    bafflesFollow_ = false;
+  int                     evaluations_ = 0;
+};
+
+template <>
+double Problem::seed<double>(double v, int, double) { return v; }
+
+template <>
+DesignDual Problem::seed<DesignDual>(double v, int lane, double scale) {
+  DesignDual::Derivatives d{};
+  d[static_cast<size_t>(lane)] = scale;   // dx/du = hi − lo
+  return DesignDual(v, d);
+}
+
+// -----------------------------------------------------------------------------
+// QP subproblem
+// -----------------------------------------------------------------------------
+
+/**
+ * min ½·yᵀHy + qᵀy subject to Ay ≤ b, H positive semidefinite and positive
+ * definite on the null space of the active rows.  Mehrotra predictor–
+ * corrector primal-dual interior point from an infeasible start; returns the
+ * multipliers in \p z.  The problems here have ≤ 16 variables, so each
+ * Newton step is one dense Cholesky of H + Aᵀ·diag(z/s)·A.
+ */
+bool solveQp(const MatrixXd &H, const VectorXd &q, const MatrixXd &A, const VectorXd &b,
+             VectorXd &y, VectorXd &z) {
+  const Eigen::Index p = H.rows(), rows = A.rows();
+  y = VectorXd::Zero(p);
+  VectorXd s = (b - A * y).cwiseMax(1.0);
+  z = VectorXd::Ones(rows);
+  const double scale = std::max({1.0, q.lpNorm<Eigen::Infinity>(), b.lpNorm<Eigen::Infinity>()});
+
+  // Largest α ≤ 1 keeping v + α·dv ≥ 0.
+  const auto maxStep = [](const VectorXd &v, const VectorXd &dv) {
+    double a = 1.0;
+    for (Eigen::Index i = 0; i < v.size(); ++i) {
+      if (dv[i] < 0.0) a = std::min(a, -v[i] / dv[i]);
+    }
+    return a;
+  };
+
+  for (int it = 0; it < 100; ++it) {
+    const VectorXd rd = H * y + q + A.transpose() * z;
+    const VectorXd rp = A * y + s - b;
+    const double mu = s.dot(z) / static_cast<double>(rows);
+    if (rd.lpNorm<Eigen::Infinity>() < 1e-10 * scale && rp.lpNorm<Eigen::Infinity>() < 1e-10 * scale &&
+        mu < 1e-12 * scale) {
+      return true;
+    }
+    const VectorXd w = z.cwiseQuotient(s);
+    MatrixXd M = H + A.transpose() * w.asDiagonal() * A;
+    M.diagonal().array() += 1e-12;
+    const Eigen::LDLT<MatrixXd> ldlt(M);
+
+    // Newton direction for the complementarity target rc = s∘z − (…).
+    const auto direction = [&](const VectorXd &rc, VectorXd &dy, VectorXd &dz, VectorXd &ds) {
+      const VectorXd rcs = rc.cwiseQuotient(s);
+      dy = ldlt.solve(-rd - A.transpose() * (w.cwiseProduct(rp) - rcs));
+      dz = w.cwiseProduct(A * dy + rp) - rcs;
+      ds = -rp - A * dy;
+    };
+
+    VectorXd dy, dz, ds;
+    direction(s.cwiseProduct(z), dy, dz, ds);                        // affine predictor
+    const double aff = std::min(maxStep(s, ds), maxStep(z, dz));
+    const double muAff = (s + aff * ds).dot(z + aff * dz) / static_cast<double>(rows);
+    const double sigma = std::pow(muAff / std::max(mu, 1e-300), 3.0);
+    const VectorXd rc = s.cwiseProduct(z) + ds.cwiseProduct(dz) - VectorXd::Constant(rows, sigma * mu);
+    direction(rc, dy, dz, ds);                                       // centred corrector
+
+    const double alpha = std::min(1.0, 0.99 * std::min(maxStep(s, ds), maxStep(z, dz)));
+    y += alpha * dy;
+    z += alpha * dz;
+    s += alpha * ds;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+// SQP
+// -----------------------------------------------------------------------------
+
+/**
+ * Relaxed optimum of \p s (nTubes real), rated after rounding as
+ * Problem::rounded() does; ok when it converged, message the reason when
+ * not.  \p relaxedTubes receives the real tube count.  With no free variable
+ * it only rates the base geometry.
+ */
+OptimizeResult sqp(const OperatingPoint &op, const Fluid &hot, const Fluid &cold,
+                   const OptimizeSettings &s, double *relaxedTubes) {
+  OptimizeResult res;
+  Problem prob(op, hot, cold, s);
+  const Eigen::Index n = prob.variables(), m = prob.constraints();
+
+  VectorXd u = prob.start();
+  Evaluation e = prob.evaluate(u);
+  const double fScale = std::max(std::abs(e.f), 1e-12);   // objective O(1) at the start
+  e.f /= fScale;
+  e.g /= fScale;
+
+  MatrixXd B = MatrixXd::Identity(n, n);   // BFGS Hessian of the Lagrangian (scaled)
+  double nu  = 1.0;      // ℓ1 merit penalty
+  double rho = 100.0;    // elastic penalty of the QP
+
+  // QP in y = (d, t): min ½dᵀBd + gᵀd + ρ·Σt s.t. c + Jd ≤ t, t ≥ 0, 0 ≤ u + d ≤ 1.
+  const Eigen::Index p = n + m, rows = 2 * m + 2 * n;
+  MatrixXd H = MatrixXd::Zero(p, p);
+  VectorXd q(p);
+  MatrixXd A = MatrixXd::Zero(rows, p);
+  VectorXd b(rows);
+  A.block(m, n, m, m) = -MatrixXd::Identity(m, m);
+  A.block(2 * m, 0, n, n) = -MatrixXd::Identity(n, n);
+  A.block(2 * m + n, 0, n, n) = MatrixXd::Identity(n, n);
+
+  bool converged = n == 0;
+  const char *stop = nullptr;
+  int it = 0;
+  while (!converged && it < s.maxIterations) {
+    ++it;
+    H.topLeftCorner(n, n) = B;
+    q << e.g, VectorXd::Constant(m, rho);
+    A.topLeftCorner(m, n) = e.J;
+    A.block(0, n, m, m) = -MatrixXd::Identity(m, m);
+    b << -e.c, VectorXd::Zero(m), u, VectorXd::Ones(n) - u;
+    VectorXd y, z;
+    if (!solveQp(H, q, A, b, y, z)) {
+      stop = "the QP subproblem did not converge";
+      break;
+    }
+    const VectorXd d = y.head(n);
+    const VectorXd lambdaQp = z.head(m);
+    const double slack = m > 0 ? y.tail(m).maxCoeff() : 0.0;
+    const double worst = m > 0 ? e.c.maxCoeff() : -1.0;
+
+    if (d.lpNorm<Eigen::Infinity>() < s.tolerance) {
+      // A zero step with elastic slack left: no direction within the bounds
+      // reduces the violation any further.
+      if (worst <= s.tolerance) converged = true;
+      else stop = "the constraints cannot be met within the bounds";
+      break;
+    }
+    if (slack > s.tolerance) rho = std::min(rho * 10.0, 1e6);   // linearisation infeasible: push harder
+
+    // ℓ1 merit φ = f + ν·Σ max(0, c) and its directional derivative along d.
+    nu = std::max(nu, 1.1 * (m > 0 ? lambdaQp.lpNorm<Eigen::Infinity>() : 0.0));
+    const auto merit = [&](const Evaluation &ev) { return ev.f + nu * ev.violation(); };
+    const double phi0 = merit(e);
+    const double D = std::min(e.g.dot(d) - nu * (e.violation() - (e.c + e.J * d).cwiseMax(0.0).sum()),
+                              -1e-14);
+
+    double alpha = 1.0;
+    VectorXd un;
+    Evaluation en;
+    for (;;) {
+      un = (u + alpha * d).cwiseMax(0.0).cwiseMin(1.0);
+      en = prob.evaluate(un, fScale);
+      if (merit(en) <= phi0 + 1e-4 * alpha * D) break;
+      alpha *= 0.5;
+      if (alpha < 1e-6) break;
+    }
+    if (alpha < 1e-6) {
+      // No decrease along d: a kink of the correlations or the limit of precision.
+      if (worst <= s.tolerance) converged = true;
+      else stop = "the line search stalled";
+      break;
+    }
+
+    // Damped BFGS update (Powell) with the new multipliers.
+    const VectorXd step = un - u;
+    const VectorXd yv = (en.g + en.J.transpose() * lambdaQp) - (e.g + e.J.transpose() * lambdaQp);
+    const VectorXd Bs = B * step;
+    const double sBs = step.dot(Bs);
+    if (sBs > 1e-300) {
+      const double sy = step.dot(yv);
+      const double theta = (sy >= 0.2 * sBs) ? 1.0 : 0.8 * sBs / (sBs - sy);
+      const VectorXd r = theta * yv + (1.0 - theta) * Bs;
+      B += r * r.transpose() / step.dot(r) - Bs * Bs.transpose() / sBs;
+    }
+    u = un;
+    e = en;
+  }
+
+  res.ok          = converged;
+  res.message     = converged ? "" : (stop ? stop : "iteration limit reached");
+  res.iterations  = it;
+  res.evaluations = prob.evaluations();
+  res.continuousObjective = e.f * fScale * (s.objective == DesignObjective::MaxDuty ? -1.0 : 1.0);
+  *relaxedTubes = prob.geometryAt<double>(u).nTubes;
+
+  // Integer counts, then the rating of the design as built.
+  res.geometry = prob.rounded(u);
+  double worst = 0.0;
+  const Rating<double> r = prob.rateGeometry(res.geometry, &worst);
+  res.feasible = worst <= s.tolerance;
+  res.Q = r.Q; res.U = r.U; res.Tc_out = r.Tc_out; res.Th_out = r.Th_out;
+  res.dP_tube = r.dP_tube; res.dP_shell = r.dP_shell; res.area = r.area;
+  return res;
+}
+
+/** Objective value of a rated design (smaller is better). */
+double objectiveOf(DesignObjective o, const OptimizeResult &r) {
+  Rating<double> x;
+  x.Q = r.Q; x.dP_tube = r.dP_tube; x.dP_shell = r.dP_shell; x.area = r.area;
+  return objectiveValue(o, x);
+}
+
+} // namespace
+
+OptimizeResult optimizeDesign(const OperatingPoint   &op,
+                              const Fluid            &hot,
+                              const Fluid            &cold,
+                              const OptimizeSettings &s) {
+  OptimizeResult res;
+  bool anyFree = false;
+  for (int i = 0; i < kVariables; ++i) {
+    const DesignBounds &b = bounds(s, i);
+    if (b.free() && !(b.lo > 0.0)) {
+      res.message = std::string("The lower bound of ") + kVariableNames[i] + " must be positive.";
+      return res;
+    }
+    anyFree = anyFree || b.free();
+  }
+  if (s.baffleCutFrac.free() && !(s.baffleCutFrac.hi < 0.5)) {
+    res.message = "The baffle cut must stay below 0.5.";
+    return res;
+  }
+  if (!anyFree) {
+    res.message = "No free design variable: give at least one range with hi > lo.";
+    return res;
+  }
+
+  double tubes = 0.0;
+  res = sqp(op, hot, cold, s, &tubes);
+
+  // Integer tube count: rounding alone can break an active constraint (the
+  // bundle fit, the duty), so fix nTubes at ⌈x⌉ and ⌊x⌋, re-solve the other
+  // variables from the relaxed optimum and keep the better feasible design.
+  // The result then reports how those re-solves ended.
+  if (res.ok && s.nTubes.free()) {
+    OptimizeResult best;
+    bool have = false;
+    int iterations = res.iterations, evaluations = res.evaluations;
+    const int up = static_cast<int>(std::ceil(tubes - 1e-6));
+    for (const int nt : {up, up - 1}) {
+      if (nt < std::max(1.0, std::ceil(s.nTubes.lo - 1e-6)) || nt > s.nTubes.hi + 1e-6) continue;
+      if (nt == up - 1 && have && best.ok && best.feasible && std::abs(tubes - up) < 1e-6) continue;
+      OptimizeSettings fixed = s;
+      fixed.base = res.geometry;
+      fixed.base.nTubes = nt;
+      fixed.nTubes = DesignBounds{};
+      double ignored = 0.0;
+      OptimizeResult r = sqp(op, hot, cold, fixed, &ignored);
+      iterations  += r.iterations;
+      evaluations += r.evaluations;
+      const bool good = r.ok && r.feasible;
+      const bool better = !have || (good && !(best.ok && best.feasible)) ||
+                          (good && objectiveOf(s.objective, r) < objectiveOf(s.objective, best));
+      if (better) { best = r; have = true; }
+    }
+    if (have) {
+      best.continuousObjective = res.continuousObjective;
+      res = best;
+    }
+    res.iterations  = iterations;
+    res.evaluations = evaluations;
+  }
+
+  // ok: every stage converged and the returned (integer) design is feasible.
+  const bool converged = res.ok;
+  res.ok = converged && res.feasible;
+
+  char buf[320];
+  if (res.ok) {
+    std::snprintf(buf, sizeof(buf),
+                  "Converged in %d iterations (%d model evaluations): area %.2f m², Q %.1f kW, "
+                  "ΔP tube %.0f Pa, shell %.0f Pa.",
+                  res.iterations, res.evaluations, res.area, res.Q / 1000.0, res.dP_tube, res.dP_shell);
+  } else if (converged) {
+    std::snprintf(buf, sizeof(buf),
+                  "Converged in %d iterations (%d model evaluations), but the integer design misses a "
+                  "constraint: area %.2f m², Q %.1f kW, ΔP tube %.0f Pa, shell %.0f Pa.",
+                  res.iterations, res.evaluations, res.area, res.Q / 1000.0, res.dP_tube, res.dP_shell);
+  } else {
+    std::snprintf(buf, sizeof(buf), "Stopped after %d iterations (%d model evaluations): %s.",
+                  res.iterations, res.evaluations, res.message.c_str());
+  }
+  res.message = buf;
+  return res;
+}
+
+} // namespace hx
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Types.hpp"
+#include <string>
+
+namespace hx {
+
+/** \brief Bounds of one design variable; hi > lo frees it, otherwise it keeps the base value. */
+struct DesignBounds {
+  double lo = 0.0;
+  double hi = 0.0;
+
+  [[nodiscard]] bool free() const { return hi > lo; }
+};
+
+/** \brief What optimizeDesign() minimises. */
+enum class DesignObjective : int {
+  MinArea         = 0,   // outer tube area
+  MinPressureDrop = 1,   // dP_tube + dP_shell
+  MaxDuty         = 2,   // Q
+};
+
+/** \brief Constrained design-optimisation settings.
+ *
+ *  The free variables are the geometry fields with free() bounds (at most
+ *  the eight below); nTubes is relaxed to a real number while optimising,
+ *  and nBaffles follows from L / baffleSpacing when either is free, as in
+ *  runDesignSweep().  Designs are rated at one operating point with a
+ *  fouling allowance.  A limit of 0 is no constraint.
+ */
+struct OptimizeSettings {
+  Geometry     base{};
+  DesignBounds nTubes, Do, Di, L, pitch, shellID, baffleSpacing, baffleCutFrac;
+  ShellSideMethod shellMethod = ShellSideMethod::Kern;
+  FlowArrangement arrangement = FlowArrangement::CounterFlow;
+
+  double Rf_shell  = 0.0;    // [m²K/W] design fouling allowance
+  double Rf_tube   = 0.0;    // [m²K/W]
+  double k_deposit = 0.5;    // [W/m/K]
+
+  DesignObjective objective = DesignObjective::MinArea;
+  double Q_min        = 0.0; // [W]  duty target, Q ≥ Q_min
+  double dP_tube_max  = 0.0; // [Pa]
+  double dP_shell_max = 0.0; // [Pa]
+  double area_max     = 0.0; // [m²]
+
+  // Buildability, enforced on the free variables they involve: Di ≤
+  // maxDiRatio·Do, pitch ≥ minPitchRatio·Do, baffleSpacing ≤ L and the
+  // triangular-pitch bundle inside shellID − Do.
+  double maxDiRatio    = 0.9;
+  double minPitchRatio = 1.25;   // TEMA minimum
+
+  int    maxIterations = 100;
+  double tolerance     = 1e-6;   // step and constraint violation, in scaled units
+};
+
+/** \brief Outcome of optimizeDesign(). */
+struct OptimizeResult {
+  bool        ok = false;        // every SQP stage (relaxed and integer re-solves) converged to
+                                 // a KKT point and \c geometry meets every constraint
+  std::string message;
+
+  Geometry geometry{};           // optimum with integer nTubes (better of ⌈x⌉, ⌊x⌋) and nBaffles floored
+  bool     feasible = false;     // the rounded design meets every constraint to \c tolerance
+  double Q = 0.0, U = 0.0, Tc_out = 0.0, Th_out = 0.0;   // rating of \c geometry
+  double dP_tube = 0.0, dP_shell = 0.0;
+  double area = 0.0;             // [m²] outer tube area
+  double continuousObjective = 0.0;   // objective at the relaxed optimum (before rounding)
+
+  int iterations  = 0;           // SQP iterations
+  int evaluations = 0;           // model evaluations, each returning values and exact gradients
+};
+
+/**
+ * \brief Optimise the geometry of \p s under its constraints at \p op.
+ *
+ *  Sequential quadratic programming on the variables scaled to [0, 1]: each
+ *  iteration solves a convex QP (damped-BFGS Hessian of the Lagrangian, the
+ *  linearised constraints made elastic so the QP is always feasible, the
+ *  bounds kept exactly) with a dense primal-dual interior-point method, then
+ *  backtracks on the ℓ1 merit function.  The model — Thermo, Hydraulics and
+ *  Bell–Delaware correlations through an ε–NTU rating, as Thermo::steady()
+ *  and the Hydraulics members compute it — runs on Dual numbers, so one
+ *  evaluation returns the objective, the constraints and their exact
+ *  gradients; a solve takes tens of evaluations.
+ *
+ *  The correlations are piecewise (laminar / turbulent, clamps), so the
+ *  result is a local optimum from \c base; starting from a coarse
+ *  runDesignSweep() optimum is the robust combination.
+ */
+OptimizeResult optimizeDesign(const OperatingPoint   &op,
+                              const Fluid            &hot,
+                              const Fluid            &cold,
+                              const OptimizeSettings &s);
+
+} // namespace hx
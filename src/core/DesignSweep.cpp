@@ -0,0 +1,374 @@
+#include "DesignSweep.hpp"
+#include "Hydraulics.hpp"
+#include "Parallel.hpp"
+#include "Thermo.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <optional>
+
+namespace hx {
+
+namespace {
+
+/** Columns of the results file. */
+enum Column : size_t {
+  kDesign, kNTubes, kDo, kDi, kL, kPitch, kShellID, kBaffleSpacing, kBaffleCut, kNBaffles,
+  kArrangement, kShellMethod, kQ, kU, kTcOut, kThOut, kDPTube, kDPShell, kArea, kVRatio,
+  kVibration, kColumns
+};
+const char *const kColumnNames[kColumns] = {
+  "design", "nTubes", "Do", "Di", "L", "pitch", "shellID", "baffleSpacing", "baffleCutFrac",
+  "nBaffles", "arrangement", "shellMethod", "Q", "U", "Tc_out", "Th_out", "dP_tube", "dP_shell",
+  "area", "V_ratio", "vibration",
+};
+
+constexpr char kMagic[8] = {'H', 'X', 'S', 'W', 'E', 'E', 'P', '1'};
+
+/** Geometries per work item; a function of nothing, so blocks never depend on the thread count. */
+constexpr std::uint64_t kGeometriesPerBlock = 256;
+/** Work items per wave and worker: bounds the results held before they are written. */
+constexpr size_t kBlocksPerWorker = 4;
+/** Front candidates collected across blocks before they are thinned to a front again. */
+constexpr size_t kCandidateLimit = 1u << 16;
+
+constexpr double kPi = 3.14159265358979323846;
+
+/** Number of geometries the eight ranges span. */
+std::uint64_t geometryCount(const SweepSettings &s) {
+  std::uint64_t n = 1;
+  for (const SweepRange *r : {&s.nTubes, &s.Do, &s.Di, &s.L, &s.pitch, &s.shellID,
+                              &s.baffleSpacing, &s.baffleCutFrac}) {
+    n *= r->size();
+  }
+  return n;
+}
+
+/** Geometry \p g of the sweep (mixed radix over the ranges, baffleCutFrac fastest). */
+Geometry sweepGeometry(const SweepSettings &s, std::uint64_t g) {
+  const SweepRange *ranges[] = {&s.nTubes, &s.Do, &s.Di, &s.L, &s.pitch, &s.shellID,
+                                &s.baffleSpacing, &s.baffleCutFrac};
+  double v[8];
+  for (size_t k = 8; k-- > 0;) {
+    v[k] = ranges[k]->at(static_cast<size_t>(g % ranges[k]->size()));
+    g /= ranges[k]->size();
+  }
+  Geometry geom = s.base;
+  if (s.nTubes.swept())        geom.nTubes        = static_cast<int>(std::lround(v[0]));
+  if (s.Do.swept())            geom.Do            = v[1];
+  if (s.Di.swept())            geom.Di            = v[2];
+  if (s.L.swept())             geom.L             = v[3];
+  if (s.pitch.swept())         geom.pitch         = v[4];
+  if (s.shellID.swept())       geom.shellID       = v[5];
+  if (s.baffleSpacing.swept()) geom.baffleSpacing = v[6];
+  if (s.baffleCutFrac.swept()) geom.baffleCutFrac = v[7];
+  if (geom.baffleSpacing > 0.0) {
+    geom.nBaffles = std::max(1, static_cast<int>(std::floor(geom.L / geom.baffleSpacing + 1e-9)));
+  }
+  return geom;
+}
+
+/**
+ * False for geometries that cannot be built: Di ≥ Do, pitch ≤ Do, a baffle
+ * cut outside (0, ½), baffles wider apart than the tubes are long, or more
+ * tubes than a triangular layout (√3/2·pitch² per tube) fits inside the
+ * outer tube limit shellID − Do.
+ */
+bool buildable(const Geometry &g) {
+  if (g.nTubes < 1 || !(g.Di > 0.0) || !(g.Do > g.Di) || !(g.pitch > g.Do)) return false;
+  if (!(g.L > 0.0) || !(g.baffleSpacing > 0.0) || g.baffleSpacing > g.L) return false;
+  if (!(g.baffleCutFrac > 0.0) || !(g.baffleCutFrac < 0.5)) return false;
+  const double otl = g.shellID - g.Do;
+  if (!(otl > 0.0)) return false;
+  return static_cast<double>(g.nTubes) * 0.8660254037844386 * g.pitch * g.pitch <=
+         0.25 * kPi * otl * otl;
+}
+
+/** The ΔP objective: both sides together. */
+double totalDrop(const SweepPoint &p) { return p.dP_tube + p.dP_shell; }
+
+/**
+ * Non-dominated subset of \p pts in (max Q, min ΔP, min area), by
+ * descending Q.  Sorted by Q, a point is dominated exactly when an earlier
+ * one has ΔP and area no larger; the earlier points' (ΔP, area) staircase
+ * answers that in O(log n), so the front costs O(n log n).  Exact
+ * duplicates keep their first (lowest design index) copy.
+ */
+std::vector<SweepPoint> paretoFront(std::vector<SweepPoint> pts) {
+  std::sort(pts.begin(), pts.end(), [](const SweepPoint &a, const SweepPoint &b) {
+    if (a.Q != b.Q) return a.Q > b.Q;
+    if (totalDrop(a) != totalDrop(b)) return totalDrop(a) < totalDrop(b);
+    if (a.area != b.area) return a.area < b.area;
+    return a.design < b.design;
+  });
+  std::vector<SweepPoint> front;
+  std::map<double, double> stair;   // ΔP → smallest area seen at ≤ that ΔP; area falls as ΔP rises
+  for (const SweepPoint &p : pts) {
+    const double dP = totalDrop(p);
+    auto it = stair.upper_bound(dP);
+    if (it != stair.begin() && std::prev(it)->second <= p.area) continue;
+    front.push_back(p);
+    it = stair.lower_bound(dP);
+    while (it != stair.end() && it->second >= p.area) it = stair.erase(it);
+    stair[dP] = p.area;
+  }
+  return front;
+}
+
+/** Feasible designs and counters of one block of geometries. */
+struct Block {
+  std::vector<double>     columns[kColumns];
+  std::vector<SweepPoint> front;
+  std::uint64_t prunedGeometry  = 0;
+  std::uint64_t prunedVibration = 0;
+  std::uint64_t prunedPressure  = 0;
+};
+
+void appendRow(Block &b, const SweepPoint &p) {
+  const Geometry &g = p.geometry;
+  const double row[kColumns] = {
+    static_cast<double>(p.design), static_cast<double>(g.nTubes), g.Do, g.Di, g.L, g.pitch,
+    g.shellID, g.baffleSpacing, g.baffleCutFrac, static_cast<double>(g.nBaffles),
+    static_cast<double>(static_cast<int>(p.arrangement)),
+    static_cast<double>(static_cast<int>(p.shellMethod)),
+    p.Q, p.U, p.Tc_out, p.Th_out, p.dP_tube, p.dP_shell, p.area, p.V_ratio,
+    static_cast<double>(static_cast<int>(p.vibration)),
+  };
+  for (size_t c = 0; c < kColumns; ++c) b.columns[c].push_back(row[c]);
+}
+
+/** Rate geometries [begin, end) into \p b, cheapest checks first; credits ctl.done per geometry. */
+void rateBlock(const OperatingPoint &op, const Fluid &hot, const Fluid &cold,
+               const SweepSettings &s, std::uint64_t begin, std::uint64_t end,
+               Block &b, SweepControl &ctl) {
+  const std::uint64_t M = s.shellMethods.size();
+  const std::uint64_t A = s.arrangements.size();
+  std::vector<SweepPoint> rated;
+  for (std::uint64_t gi = begin; gi < end; ++gi) {
+    ctl.done.fetch_add(M * A, std::memory_order_relaxed);
+    const Geometry geom = sweepGeometry(s, gi);
+    if (!buildable(geom)) {
+      b.prunedGeometry += M * A;
+      continue;
+    }
+    const VibrationResult vib = computeVibration(geom, cold, hot, op.m_dot_cold, s.vibration);
+    if (s.rejectVibrationFail && vib.overall == VibrationResult::Status::Fail) {
+      b.prunedVibration += M * A;
+      continue;
+    }
+    Hydraulics hydro(geom, hot, cold);
+    const double dPt = hydro.dP_tube(op.m_dot_hot, s.Rf_tube, s.k_deposit, geom.K_minor_tube);
+    if (s.dP_tube_max > 0.0 && dPt > s.dP_tube_max) {
+      b.prunedPressure += M * A;
+      continue;
+    }
+    std::optional<Thermo> thermo;   // built for the first method that passes
+    for (std::uint64_t m = 0; m < M; ++m) {
+      const ShellSideMethod method = s.shellMethods[m];
+      hydro.setShellMethod(method);
+      const double dPs = hydro.dP_shell(op.m_dot_cold, s.Rf_shell, s.k_deposit, geom.K_turns_shell);
+      if (s.dP_shell_max > 0.0 && dPs > s.dP_shell_max) {
+        b.prunedPressure += A;
+        continue;
+      }
+      if (!thermo) thermo.emplace(geom, hot, cold);
+      thermo->setShellMethod(method);
+      for (std::uint64_t a = 0; a < A; ++a) {
+        const State st = thermo->steady(op, s.Rf_shell, s.Rf_tube, s.k_deposit, s.arrangements[a]);
+        SweepPoint p;
+        p.design      = (gi * M + m) * A + a;
+        p.geometry    = geom;
+        p.arrangement = s.arrangements[a];
+        p.shellMethod = method;
+        p.Q = st.Q;
+        p.U = st.U;
+        p.Tc_out = st.Tc_out;
+        p.Th_out = st.Th_out;
+        p.dP_tube  = dPt;
+        p.dP_shell = dPs;
+        p.area     = geom.areaOuter();
+        p.V_ratio  = vib.V_ratio;
+        p.vibration = vib.overall;
+        appendRow(b, p);
+        rated.push_back(p);
+      }
+    }
+  }
+  b.front = paretoFront(std::move(rated));
+}
+
+template <class T>
+void writeRaw(std::ofstream &out, const T &v) {
+  out.write(reinterpret_cast<const char *>(&v), sizeof(T));
+}
+
+template <class T>
+bool readRaw(std::ifstream &in, T &v) {
+  return static_cast<bool>(in.read(reinterpret_cast<char *>(&v), sizeof(T)));
+}
+
+} // anonymous namespace
+
+SweepResult runDesignSweep(const OperatingPoint &op,
+                           const Fluid          &hot,
+                           const Fluid          &cold,
+                           const SweepSettings  &s,
+                           SweepControl         *control) {
+  SweepResult r;
+  if (s.shellMethods.empty() || s.arrangements.empty()) {
+    r.message = "Choose at least one shell-side method and one flow arrangement.";
+    return r;
+  }
+  const auto t0 = std::chrono::steady_clock::now();
+  const std::uint64_t geometries = geometryCount(s);
+  r.designs = geometries * s.shellMethods.size() * s.arrangements.size();
+
+  std::ofstream out;
+  if (!s.outputPath.empty()) {
+    out.open(s.outputPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      r.message = "Cannot write " + s.outputPath;
+      return r;
+    }
+    out.write(kMagic, sizeof(kMagic));
+    writeRaw(out, static_cast<std::uint32_t>(kColumns));
+    for (const char *name : kColumnNames) {
+      const auto len = static_cast<std::uint32_t>(std::strlen(name));
+      writeRaw(out, len);
+      out.write(name, len);
+    }
+  }
+
+  SweepControl localControl;
+  SweepControl &ctl = control ? *control : localControl;
+  ctl.done.store(0);
+  ctl.total.store(r.designs);
+
+  // === Waves of blocks: rated in parallel, written and reduced in order ===
+  const unsigned threads = resolveThreadCount(s.threads);
+  const std::uint64_t blocks = (geometries + kGeometriesPerBlock - 1) / kGeometriesPerBlock;
+  const size_t waveSize = kBlocksPerWorker * threads;
+  std::vector<Block> wave(waveSize);
+  std::vector<SweepPoint> candidates;
+  for (std::uint64_t first = 0; first < blocks; first += waveSize) {
+    const size_t n = static_cast<size_t>(std::min<std::uint64_t>(waveSize, blocks - first));
+    auto body = [&](size_t i) {
+      wave[i] = Block{};
+      const std::uint64_t begin = (first + i) * kGeometriesPerBlock;
+      rateBlock(op, hot, cold, s, begin, std::min(geometries, begin + kGeometriesPerBlock),
+                wave[i], ctl);
+    };
+    if (!parallelFor(n, threads, body, &ctl.cancel)) {
+      r.message = "Cancelled.";
+      return r;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      Block &b = wave[i];
+      const std::uint64_t rows = b.columns[0].size();
+      r.feasible        += rows;
+      r.prunedGeometry  += b.prunedGeometry;
+      r.prunedVibration += b.prunedVibration;
+      r.prunedPressure  += b.prunedPressure;
+      if (out.is_open() && rows > 0) {
+        writeRaw(out, rows);
+        for (const std::vector<double> &col : b.columns) {
+          out.write(reinterpret_cast<const char *>(col.data()),
+                    static_cast<std::streamsize>(rows * sizeof(double)));
+        }
+      }
+      candidates.insert(candidates.end(), b.front.begin(), b.front.end());
+    }
+    if (candidates.size() > kCandidateLimit) candidates = paretoFront(std::move(candidates));
+  }
+  r.pareto = paretoFront(std::move(candidates));
+
+  if (out.is_open()) {
+    out.flush();
+    if (!out) {
+      r.message = "Error writing " + s.outputPath;
+      return r;
+    }
+  }
+  r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  r.ok = true;
+  char buf[320];
+  std::snprintf(buf, sizeof(buf),
+                "Swept %llu designs in %.2f s: %llu feasible (pruned %llu unbuildable, %llu for "
+                "vibration, %llu for pressure drop), %zu on the Pareto front.",
+                static_cast<unsigned long long>(r.designs), r.seconds,
+                static_cast<unsigned long long>(r.feasible),
+                static_cast<unsigned long long>(r.prunedGeometry),
+                static_cast<unsigned long long>(r.prunedVibration),
+                static_cast<unsigned long long>(r.prunedPressure), r.pareto.size());
+  r.message = buf;
+  return r;
+}
+
+SweepTable readDesignSweep(const std::string &path) {
+  SweepTable t;
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    t.message = "Cannot open " + path;
+    return t;
+  }
+  char magic[sizeof(kMagic)];
+  std::uint32_t nColumns = 0;
+  if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !readRaw(in, nColumns) || nColumns == 0 || nColumns > 1024) {
+    t.message = path + ": not a design-sweep file";
+    return t;
+  }
+  for (std::uint32_t c = 0; c < nColumns; ++c) {
+    std::uint32_t len = 0;
+    if (!readRaw(in, len) || len > 256) {
+      t.message = path + ": bad column header";
+      return t;
+    }
+    std::string name(len, '\0');
+    if (!in.read(&name[0], len)) {
+      t.message = path + ": bad column header";
+      return t;
+    }
+    t.names.push_back(std::move(name));
+  }
+  t.columns.resize(nColumns);
+
+  // Bytes after the header, so a corrupt row count is rejected before it
+  // sizes an allocation.
+  const std::streamoff dataStart = in.tellg();
+  in.seekg(0, std::ios::end);
+  std::uint64_t remaining = static_cast<std::uint64_t>(in.tellg() - dataStart);
+  in.seekg(dataStart);
+
+  std::uint64_t rows = 0;
+  while (readRaw(in, rows)) {
+    remaining -= std::min<std::uint64_t>(remaining, sizeof(rows));
+    if (rows > remaining / (sizeof(double) * nColumns)) {
+      t.message = path + ": truncated block";
+      t.columns.clear();
+      return t;
+    }
+    remaining -= rows * sizeof(double) * nColumns;
+    for (std::vector<double> &col : t.columns) {
+      const size_t at = col.size();
+      col.resize(at + rows);
+      if (!in.read(reinterpret_cast<char *>(col.data() + at),
+                   static_cast<std::streamsize>(rows * sizeof(double)))) {
+        t.message = path + ": truncated block";
+        t.columns.clear();
+        return t;
+      }
+    }
+  }
+  t.ok = true;
+  t.message = "Read " + std::to_string(t.columns[0].size()) + " designs from " + path;
+  return t;
+}
+
+} // namespace hx
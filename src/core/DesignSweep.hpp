@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Types.hpp"
+#include "VibrationCheck.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hx {
+
+/**
+ * \brief Values of one swept quantity: \c count points evenly spaced over
+ *  [lo, hi]; count 1 is lo alone, count 0 leaves the base geometry's value.
+ */
+struct SweepRange {
+  double lo    = 0.0;
+  double hi    = 0.0;
+  int    count = 0;
+
+  [[nodiscard]] bool   swept() const { return count >= 1; }
+  [[nodiscard]] size_t size() const { return count > 1 ? static_cast<size_t>(count) : 1; }
+  [[nodiscard]] double at(size_t i) const {
+    return count > 1 ? lo + (hi - lo) * static_cast<double>(i) / static_cast<double>(count - 1) : lo;
+  }
+};
+
+/** \brief Design-space sweep settings.
+ *
+ *  Every combination of the ranges, shell-side methods and flow
+ *  arrangements is one design; the unswept geometry fields come from
+ *  \c base, and nBaffles follows from L / baffleSpacing.  Designs are
+ *  rated at one operating point with a fouling allowance, as on a TEMA
+ *  data sheet.
+ */
+struct SweepSettings {
+  Geometry   base{};
+  SweepRange nTubes, Do, Di, L, pitch, shellID, baffleSpacing, baffleCutFrac;
+  std::vector<ShellSideMethod> shellMethods = {ShellSideMethod::Kern};
+  std::vector<FlowArrangement> arrangements = {FlowArrangement::CounterFlow};
+
+  double Rf_shell  = 0.0;    // [m²K/W] design fouling allowance
+  double Rf_tube   = 0.0;    // [m²K/W]
+  double k_deposit = 0.5;    // [W/m/K]
+
+  // Feasibility: designs over a limit (0 = none) or with a vibration Fail
+  // are pruned before the thermal rating.
+  double dP_tube_max  = 0.0; // [Pa]
+  double dP_shell_max = 0.0; // [Pa]
+  bool   rejectVibrationFail = true;
+  VibrationConfig vibration;
+
+  int         threads = 0;   // worker threads; 0 = all hardware threads
+  std::string outputPath;    // columnar results file (see runDesignSweep()); empty = none
+};
+
+/** \brief One rated design. */
+struct SweepPoint {
+  std::uint64_t   design = 0;       // combination index (see runDesignSweep())
+  Geometry        geometry{};
+  FlowArrangement arrangement = FlowArrangement::CounterFlow;
+  ShellSideMethod shellMethod = ShellSideMethod::Kern;
+  double Q = 0.0, U = 0.0, Tc_out = 0.0, Th_out = 0.0;
+  double dP_tube = 0.0, dP_shell = 0.0;
+  double area = 0.0;                // [m²] outer tube area
+  double V_ratio = 0.0;             // fluid-elastic V_cross / V_crit
+  VibrationResult::Status vibration = VibrationResult::Status::Safe;
+};
+
+/** \brief Progress / cancel channel of a running sweep (readable from any thread). */
+struct SweepControl {
+  std::atomic<std::uint64_t> done{0};    // designs decided (rated or pruned)
+  std::atomic<std::uint64_t> total{0};
+  std::atomic<bool>          cancel{false};
+};
+
+/** \brief Outcome of runDesignSweep(). */
+struct SweepResult {
+  bool        ok = false;
+  std::string message;
+
+  std::uint64_t designs         = 0;
+  std::uint64_t feasible        = 0;   // rated and written
+  std::uint64_t prunedGeometry  = 0;   // Di ≥ Do, pitch ≤ Do, bundle not fitting the shell, …
+  std::uint64_t prunedVibration = 0;
+  std::uint64_t prunedPressure  = 0;
+  double        seconds         = 0.0;
+
+  // Non-dominated feasible designs in (max Q, min dP_tube + dP_shell, min
+  // area), by descending Q.
+  std::vector<SweepPoint> pareto;
+};
+
+/**
+ * \brief Rate every design of \p s at \p op and extract the Pareto front.
+ *
+ *  Design index = ((geometry · M) + method) · A + arrangement, the geometry
+ *  index running over nTubes, Do, Di, L, pitch, shellID, baffleSpacing,
+ *  baffleCutFrac with the last fastest.  A work item is a block of
+ *  geometries; per geometry the cheap checks go first — geometric sanity,
+ *  computeVibration() (shell side is the cold stream), Hydraulics dP_tube,
+ *  then dP_shell per method — and only survivors get a Thermo::steady()
+ *  rating per arrangement, all from one Thermo / Hydraulics pair.  Items run
+ *  on \c threads workers in waves; each wave's blocks are written in design
+ *  order, so the file and the front do not depend on the thread count.
+ *
+ *  File: "HXSWEEP1", a uint32 column count and per column a uint32 length
+ *  and its name, then blocks of (uint64 rows, one contiguous column of rows
+ *  doubles per column), host byte order.  Only feasible designs are
+ *  written; readDesignSweep() loads it back.
+ */
+SweepResult runDesignSweep(const OperatingPoint &op,
+                           const Fluid          &hot,
+                           const Fluid          &cold,
+                           const SweepSettings  &s,
+                           SweepControl         *control = nullptr);
+
+/** \brief Columns of a runDesignSweep() file. */
+struct SweepTable {
+  bool        ok = false;
+  std::string message;
+  std::vector<std::string>         names;
+  std::vector<std::vector<double>> columns;   // parallel to names
+};
+
+/** Load a runDesignSweep() file, every block appended column by column. */
+SweepTable readDesignSweep(const std::string &path);
+
+} // namespace hx
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+
+namespace hx {
+
+/**
+ * \brief Forward-mode dual number with \c N derivative lanes.
+ *
+ *  value() + Σ derivatives()[i]·ε_i with ε_i ε_j = 0: one evaluation of a
+ *  templated correlation on Dual<N> returns the value and its exact gradient
+ *  with respect to N seeded inputs.  The derivatives sit in a fixed array,
+ *  so nothing allocates.  The interface (value(), derivatives(), math
+ *  functions found by argument-dependent lookup) mirrors
+ *  Eigen::AutoDiffScalar, so code written for one runs on the other.
+ *
+ *  The value part is computed exactly as the double expression would be, so
+ *  a Dual evaluation reproduces the double result bit for bit.  Comparisons
+ *  look at the value only; branches (laminar / turbulent, clamps) therefore
+ *  pick the derivative of the active piece.
+ */
+template <int N>
+class Dual {
+public:
+  using Derivatives = std::array<double, static_cast<size_t>(N)>;
+
+  Dual(double v = 0.0) : v_(v) { d_.fill(0.0); }   // NOLINT: implicit, like a double literal
+  Dual(double v, const Derivatives &d) : v_(v), d_(d) {}
+
+  /** Independent variable \p i of the gradient, at value \p v. */
+  static Dual variable(double v, int i) {
+    Dual x(v);
+    x.d_[static_cast<size_t>(i)] = 1.0;
+    return x;
+  }
+
+  [[nodiscard]] double value() const { return v_; }
+  [[nodiscard]] const Derivatives &derivatives() const { return d_; }
+  [[nodiscard]] double derivative(int i) const { return d_[static_cast<size_t>(i)]; }
+
+  // --- Arithmetic ------------------------------------------------------------
+  Dual &operator+=(const Dual &b) { v_ += b.v_; for (size_t i = 0; i < d_.size(); ++i) d_[i] += b.d_[i]; return *this; }
+  Dual &operator-=(const Dual &b) { v_ -= b.v_; for (size_t i = 0; i < d_.size(); ++i) d_[i] -= b.d_[i]; return *this; }
+  Dual &operator*=(const Dual &b) {
+    for (size_t i = 0; i < d_.size(); ++i) d_[i] = d_[i] * b.v_ + v_ * b.d_[i];
+    v_ *= b.v_;
+    return *this;
+  }
+  Dual &operator/=(const Dual &b) {
+    const double inv = 1.0 / b.v_;
+    v_ /= b.v_;
+    for (size_t i = 0; i < d_.size(); ++i) d_[i] = (d_[i] - v_ * b.d_[i]) * inv;
+    return *this;
+  }
+  Dual &operator+=(double b) { v_ += b; return *this; }
+  Dual &operator-=(double b) { v_ -= b; return *this; }
+  Dual &operator*=(double b) { v_ *= b; for (double &d : d_) d *= b; return *this; }
+  Dual &operator/=(double b) { v_ /= b; for (double &d : d_) d /= b; return *this; }
+
+  friend Dual operator-(Dual a) { a.v_ = -a.v_; for (double &d : a.d_) d = -d; return a; }
+  friend Dual operator+(const Dual &a) { return a; }
+
+  friend Dual operator+(Dual a, const Dual &b) { return a += b; }
+  friend Dual operator-(Dual a, const Dual &b) { return a -= b; }
+  friend Dual operator*(Dual a, const Dual &b) { return a *= b; }
+  friend Dual operator/(Dual a, const Dual &b) { return a /= b; }
+  friend Dual operator+(Dual a, double b) { return a += b; }
+  friend Dual operator-(Dual a, double b) { return a -= b; }
+  friend Dual operator*(Dual a, double b) { return a *= b; }
+  friend Dual operator/(Dual a, double b) { return a /= b; }
+  friend Dual operator+(double a, Dual b) { return b += a; }
+  friend Dual operator-(double a, const Dual &b) { return -b + a; }
+  friend Dual operator*(double a, Dual b) { return b *= a; }
+  friend Dual operator/(double a, const Dual &b) {
+    const double inv = 1.0 / b.v_;
+    return b.chain(a / b.v_, -a * inv * inv);
+  }
+
+  // --- Comparisons (value only) ------------------------------------------------
+  friend bool operator<(const Dual &a, const Dual &b)  { return a.v_ < b.v_; }
+  friend bool operator>(const Dual &a, const Dual &b)  { return a.v_ > b.v_; }
+  friend bool operator<=(const Dual &a, const Dual &b) { return a.v_ <= b.v_; }
+  friend bool operator>=(const Dual &a, const Dual &b) { return a.v_ >= b.v_; }
+  friend bool operator==(const Dual &a, const Dual &b) { return a.v_ == b.v_; }
+  friend bool operator!=(const Dual &a, const Dual &b) { return a.v_ != b.v_; }
+
+  // --- Elementary functions ----------------------------------------------------
+  friend Dual exp(const Dual &a)  { const double e = std::exp(a.v_); return a.chain(e, e); }
+  friend Dual log(const Dual &a)  { return a.chain(std::log(a.v_), 1.0 / a.v_); }
+  friend Dual sqrt(const Dual &a) { const double r = std::sqrt(a.v_); return a.chain(r, 0.5 / r); }
+  friend Dual sin(const Dual &a)  { return a.chain(std::sin(a.v_), std::cos(a.v_)); }
+  friend Dual cos(const Dual &a)  { return a.chain(std::cos(a.v_), -std::sin(a.v_)); }
+  friend Dual acos(const Dual &a) { return a.chain(std::acos(a.v_), -1.0 / std::sqrt(1.0 - a.v_ * a.v_)); }
+  friend Dual abs(const Dual &a)  { return a.v_ < 0.0 ? -a : a; }
+  friend Dual pow(const Dual &a, double p) {
+    if (a.v_ == 0.0) return a.chain(std::pow(0.0, p), p == 1.0 ? 1.0 : 0.0);
+    const double r = std::pow(a.v_, p);
+    return a.chain(r, p * r / a.v_);
+  }
+  friend Dual pow(const Dual &a, const Dual &b) { return exp(b * log(a)); }
+
+private:
+  /** f(a) with value \p f and derivative \p df at a.value(). */
+  [[nodiscard]] Dual chain(double f, double df) const {
+    Dual r(f);
+    for (size_t i = 0; i < d_.size(); ++i) r.d_[i] = df * d_[i];
+    return r;
+  }
+
+  double      v_;
+  Derivatives d_;
+};
+
+} // namespace hx
@@ -0,0 +1,249 @@
+#include "FluidPropertyTable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+namespace hx {
+
+namespace {
+
+double propOf(const Fluid &f, size_t p) {
+  switch (p) {
+    case 0:  return f.rho;
+    case 1:  return f.mu;
+    case 2:  return f.cp;
+    default: return f.k;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// PCHIP slopes (Fritsch–Carlson with the Fritsch–Butland weighted harmonic
+// mean): zero at local extrema, otherwise a weighted harmonic mean of the
+// neighbouring secants, which keeps every interval monotone.  End slopes use
+// the one-sided three-point formula, limited the same way.
+// -----------------------------------------------------------------------------
+std::vector<double> pchipSlopes(const std::vector<double> &x, const std::vector<double> &y) {
+  const size_t n = x.size();
+  std::vector<double> m(n, 0.0);
+  std::vector<double> h(n - 1), d(n - 1);
+  for (size_t i = 0; i + 1 < n; ++i) {
+    h[i] = x[i + 1] - x[i];
+    d[i] = (y[i + 1] - y[i]) / h[i];
+  }
+  if (n == 2) {
+    m[0] = m[1] = d[0];
+    return m;
+  }
+  for (size_t i = 1; i + 1 < n; ++i) {
+    if (d[i - 1] * d[i] <= 0.0) continue;
+    const double w1 = 2.0 * h[i] + h[i - 1];
+    const double w2 = h[i] + 2.0 * h[i - 1];
+    m[i] = (w1 + w2) / (w1 / d[i - 1] + w2 / d[i]);
+  }
+  auto endSlope = [](double h0, double h1, double d0, double d1) {
+    double s = ((2.0 * h0 + h1) * d0 - h0 * d1) / (h0 + h1);
+    if (s * d0 <= 0.0) {
+      s = 0.0;
+    } else if (d0 * d1 < 0.0 && std::fabs(s) > 3.0 * std::fabs(d0)) {
+      s = 3.0 * d0;
+    }
+    return s;
+  };
+  m[0]     = endSlope(h[0], h[1], d[0], d[1]);
+  m[n - 1] = endSlope(h[n - 2], h[n - 3], d[n - 2], d[n - 3]);
+  return m;
+}
+
+bool parseRow(const std::string &line, double (&v)[5]) {
+  const char *p = line.c_str();
+  for (int c = 0; c < 5; ++c) {
+    while (*p == ' ' || *p == '\t') ++p;
+    char *end = nullptr;
+    v[c] = std::strtod(p, &end);
+    if (end == p || !std::isfinite(v[c])) return false;
+    p = end;
+    while (*p == ' ' || *p == '\t') ++p;
+    if (c < 4) {
+      if (*p != ',' && *p != ';') return false;
+      ++p;
+    }
+  }
+  while (*p == ' ' || *p == '\t' || *p == '\r') ++p;
+  return *p == '\0' || *p == ',' || *p == ';';
+}
+
+}  // namespace
+
+FluidPropertyTable FluidPropertyTable::fromSamples(std::string name,
+                                                   std::vector<double> T,
+                                                   const std::vector<Fluid> &props,
+                                                   Interpolation interp) {
+  FluidPropertyTable t;
+  if (T.size() < 2 || T.size() != props.size()) return t;
+  for (size_t i = 0; i + 1 < T.size(); ++i) {
+    if (!(T[i + 1] > T[i])) return t;
+  }
+
+  t.name_ = std::move(name);
+  t.interp_ = interp;
+  t.T_ = std::move(T);
+  const size_t n = t.T_.size();
+  t.coef_.assign((n - 1) * kProps * 4, 0.0);
+  std::vector<double> y(n);
+  for (size_t p = 0; p < kProps; ++p) {
+    for (size_t i = 0; i < n; ++i) y[i] = propOf(props[i], p);
+    const std::vector<double> m = (interp == Interpolation::MonotoneCubic)
+                                      ? pchipSlopes(t.T_, y) : std::vector<double>();
+    for (size_t i = 0; i + 1 < n; ++i) {
+      double *c = &t.coef_[(i * kProps + p) * 4];
+      const double dy = y[i + 1] - y[i];
+      c[0] = y[i];
+      if (interp == Interpolation::Linear) {
+        c[1] = dy;
+        continue;
+      }
+      // Cubic Hermite in the unit variable: slopes scale by the row spacing.
+      const double h  = t.T_[i + 1] - t.T_[i];
+      const double m0 = m[i] * h, m1 = m[i + 1] * h;
+      c[1] = m0;
+      c[2] = 3.0 * dy - 2.0 * m0 - m1;
+      c[3] = m0 + m1 - 2.0 * dy;
+    }
+  }
+
+  // Uniform grid → the bracketing row is a multiply away.
+  const double dx = (t.T_.back() - t.T_.front()) / static_cast<double>(n - 1);
+  t.uniform_ = true;
+  for (size_t i = 0; i + 1 < n; ++i) {
+    if (std::fabs((t.T_[i + 1] - t.T_[i]) - dx) > 1e-9 * dx) {
+      t.uniform_ = false;
+      break;
+    }
+  }
+  t.invDx_ = 1.0 / dx;
+  return t;
+}
+
+FluidPropertyTable FluidPropertyTable::fromPreset(FluidPreset preset, double step,
+                                                  Interpolation interp) {
+  if (preset == FluidPreset::Custom) return {};
+  const auto catalog = fluidPresetCatalog();
+  const FluidPresetInfo &info = catalog[static_cast<size_t>(preset)];
+  const double span = info.T_max - info.T_min;
+  const size_t n = static_cast<size_t>(std::ceil(span / std::max(step, 1e-3))) + 1;
+  const double dx = span / static_cast<double>(n - 1);
+
+  std::vector<double> T(n);
+  std::vector<Fluid> props(n);
+  for (size_t i = 0; i < n; ++i) {
+    T[i] = (i + 1 == n) ? info.T_max : info.T_min + dx * static_cast<double>(i);
+    props[i] = evaluateFluid(preset, T[i]);
+  }
+  return fromSamples(info.displayName, std::move(T), props, interp);
+}
+
+const FluidPropertyTable *FluidPropertyTable::forPreset(FluidPreset preset) {
+  static const auto tables = [] {
+    std::array<FluidPropertyTable, static_cast<size_t>(FluidPreset::Count)> t;
+    for (size_t i = 0; i < t.size(); ++i) t[i] = fromPreset(static_cast<FluidPreset>(i));
+    return t;
+  }();
+  const auto i = static_cast<size_t>(preset);
+  if (i >= tables.size() || tables[i].empty()) return nullptr;
+  return &tables[i];
+}
+
+size_t FluidPropertyTable::segment(double T) const {
+  const size_t last = T_.size() - 2;
+  const auto it = std::upper_bound(T_.begin(), T_.end(), T);
+  const size_t i = static_cast<size_t>(it - T_.begin());
+  return std::min(i > 0 ? i - 1 : 0, last);
+}
+
+Fluid FluidPropertyTable::lookup(double T_C) const {
+  if (empty()) return Fluid{0.0, 0.0, 0.0, 0.0};
+  // Written so NaN lands on the first row.
+  const double T = (T_C > T_.front()) ? std::min(T_C, T_.back()) : T_.front();
+  size_t i;
+  double s;
+  if (uniform_) {
+    // Row index and local coordinate from one scaled offset, no division.
+    const double u = (T - T_.front()) * invDx_;
+    i = std::min(static_cast<size_t>(u), T_.size() - 2);
+    s = u - static_cast<double>(i);
+  } else {
+    i = segment(T);
+    s = (T - T_[i]) / (T_[i + 1] - T_[i]);
+  }
+
+  const double *c = &coef_[i * kProps * 4];
+  auto horner = [s](const double *q) { return q[0] + s * (q[1] + s * (q[2] + s * q[3])); };
+  return {horner(c), horner(c + 4), horner(c + 8), horner(c + 12)};
+}
+
+void FluidPropertyTable::lookup(const double *T_C, size_t n, Fluid *out) const {
+  for (size_t i = 0; i < n; ++i) out[i] = lookup(T_C[i]);
+}
+
+FluidTableLoadResult loadFluidTableCsv(const std::string &path,
+                                       FluidPropertyTable::Interpolation interp) {
+  FluidTableLoadResult r;
+  std::ifstream in(path);
+  if (!in) {
+    r.message = "Cannot open " + path;
+    return r;
+  }
+
+  std::vector<double> T;
+  std::vector<Fluid> props;
+  std::string line;
+  int lineNo = 0;
+  bool headerSeen = false;
+  while (std::getline(in, line)) {
+    ++lineNo;
+    const size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#') continue;
+
+    double v[5];
+    if (!parseRow(line, v)) {
+      if (T.empty() && !headerSeen) {   // column header
+        headerSeen = true;
+        continue;
+      }
+      r.message = path + ":" + std::to_string(lineNo) +
+                  ": expected 5 numeric columns (T, rho, mu, cp, k)";
+      return r;
+    }
+    if (v[1] <= 0.0 || v[2] <= 0.0 || v[3] <= 0.0 || v[4] <= 0.0) {
+      r.message = path + ":" + std::to_string(lineNo) + ": properties must be positive";
+      return r;
+    }
+    if (!T.empty() && !(v[0] > T.back())) {
+      r.message = path + ":" + std::to_string(lineNo) +
+                  ": temperatures must be strictly increasing";
+      return r;
+    }
+    T.push_back(v[0]);
+    props.push_back({v[1], v[2], v[3], v[4]});
+  }
+  if (T.size() < 2) {
+    r.message = path + ": need at least two data rows";
+    return r;
+  }
+
+  std::string name = path;
+  const size_t slash = name.find_last_of("/\\");
+  if (slash != std::string::npos) name.erase(0, slash + 1);
+  const size_t dot = name.find_last_of('.');
+  if (dot != std::string::npos && dot > 0) name.erase(dot);
+
+  const size_t rows = T.size();
+  r.table = FluidPropertyTable::fromSamples(name, std::move(T), props, interp);
+  r.ok = true;
+  r.message = "Loaded " + std::to_string(rows) + " rows from " + path;
+  return r;
+}
+
+}  // namespace hx
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "FluidLibrary.hpp"
+#include "Types.hpp"
+#include <array>
+#include <string>
+#include <vector>
+
+namespace hx {
+
+/**
+ * \brief Pre-tabulated ρ, μ, cₚ, k against temperature (°C).
+ *
+ *  Built from a FluidLibrary preset (the closed-form correlations sampled on
+ *  a uniform grid over the preset's catalogue range) or from a user table
+ *  (loadFluidTableCsv()).  Lookups clamp to the first / last row — the same
+ *  behaviour as the closed forms outside their range — and interpolate either
+ *  linearly or with a monotone cubic Hermite (Fritsch–Carlson / PCHIP
+ *  slopes), which follows the data without overshooting between rows.  On a
+ *  uniform grid the bracketing row is found in O(1); non-uniform user tables
+ *  fall back to a binary search.
+ */
+class FluidPropertyTable {
+public:
+  enum class Interpolation : int {
+    Linear = 0,
+    MonotoneCubic = 1,
+  };
+
+  FluidPropertyTable() = default;
+
+  /**
+   * \brief Sample \p props at the strictly increasing temperatures \p T.
+   *  Returns an empty table when fewer than two rows are given or T is not
+   *  strictly increasing.
+   */
+  static FluidPropertyTable fromSamples(std::string name,
+                                        std::vector<double> T,
+                                        const std::vector<Fluid> &props,
+                                        Interpolation interp = Interpolation::MonotoneCubic);
+
+  /** Tabulate a preset every \p step kelvin over its catalogue range. */
+  static FluidPropertyTable fromPreset(FluidPreset preset, double step = 0.25,
+                                       Interpolation interp = Interpolation::MonotoneCubic);
+
+  /**
+   * \brief Shared default table for a preset, built on first use.
+   *  Thread-safe; nullptr for FluidPreset::Custom.
+   */
+  static const FluidPropertyTable *forPreset(FluidPreset preset);
+
+  [[nodiscard]] bool empty() const { return T_.size() < 2; }
+  [[nodiscard]] size_t size() const { return T_.size(); }
+  [[nodiscard]] double T_min() const { return T_.empty() ? 0.0 : T_.front(); }
+  [[nodiscard]] double T_max() const { return T_.empty() ? 0.0 : T_.back(); }
+  [[nodiscard]] const std::string &name() const { return name_; }
+  [[nodiscard]] Interpolation interpolation() const { return interp_; }
+
+  /** Properties at T_C; clamped to the table range. */
+  [[nodiscard]] Fluid lookup(double T_C) const;
+
+  /** Batch lookup, e.g. one entry per axial cell: out[i] = lookup(T_C[i]). */
+  void lookup(const double *T_C, size_t n, Fluid *out) const;
+
+private:
+  static constexpr size_t kProps = 4;   // ρ, μ, cₚ, k
+
+  std::string name_;
+  Interpolation interp_ = Interpolation::MonotoneCubic;
+  std::vector<double> T_;
+  // Per segment and property the local cubic a + b·s + c·s² + d·s³ in
+  // s = (T − T_i)/(T_i+1 − T_i), packed [segment][property][a b c d] so one
+  // lookup reads 128 contiguous bytes.  Linear tables have c = d = 0.
+  std::vector<double> coef_;
+  bool uniform_ = false;
+  double invDx_ = 0.0;
+
+  size_t segment(double T) const;   // binary search (non-uniform rows)
+};
+
+/** \brief Result of loadFluidTableCsv(). */
+struct FluidTableLoadResult {
+  bool ok = false;
+  std::string message;
+  FluidPropertyTable table;
+};
+
+/**
+ * \brief Load a user fluid from a CSV file.
+ *
+ *  Expected columns: T [°C], rho [kg/m³], mu [Pa·s], cp [J/kg/K], k [W/m/K].
+ *  Blank lines, lines starting with '#' and a non-numeric header row are
+ *  skipped.  Rows must be sorted by strictly increasing temperature and every
+ *  property must be positive.
+ */
+FluidTableLoadResult loadFluidTableCsv(const std::string &path,
+                                       FluidPropertyTable::Interpolation interp =
+                                           FluidPropertyTable::Interpolation::MonotoneCubic);
+
+}  // namespace hx
@@ -0,0 +1,85 @@
+#include "HeatTransferMemo.hpp"
+
+#include <algorithm>
+
+namespace hx {
+
+double HeatTransferMemo::U(double m_dot_hot, double m_dot_cold, double Rf_shell, double Rf_tube,
+                           double k_deposit) {
+  bool changed = false;
+
+  // --- Tube side: hot flow and hot properties --------------------------------
+  const Fluid &hot = thermo_.hot();
+  if (tubeValid_ && m_dot_hot == tubeMdot_ && same(hot, tubeFluid_)) {
+    ++stats_.tubeHits;
+  } else {
+    ht_ = thermo_.h_tube(m_dot_hot);
+    tubeMdot_ = m_dot_hot;
+    tubeFluid_ = hot;
+    tubeValid_ = true;
+    ++stats_.tubeMisses;
+    changed = true;
+  }
+
+  // --- Shell side: cold flow, cold properties, fouling, method ---------------
+  const Fluid &cold = thermo_.cold();
+  const ShellSideMethod method = thermo_.shellMethod();
+  if (shellValid_ && method == shellMethod_ && m_dot_cold == shellMdot_ && Rf_shell == shellRf_ &&
+      k_deposit == shellKdep_ && same(cold, shellFluid_)) {
+    ++stats_.shellHits;
+  } else {
+    // Same branches as Thermo::U: the clean coefficient at or below 1e-9.
+    const bool fouled = Rf_shell > 1e-9;
+    if (method == ShellSideMethod::BellDelaware) {
+      bd_ = fouled ? thermo_.bellDelawareShell(m_dot_cold, Rf_shell, k_deposit)
+                   : thermo_.bellDelawareShell(m_dot_cold, 0.0, 0.5);
+      // With Rf_shell <= 0 there is no deposit either way, so the clean
+      // evaluation is also the one Hydraulics::dP_shell would make.
+      bdValid_ = fouled || Rf_shell <= 0.0;
+      hs_ = std::max(bd_.h_shell, 1.0);
+    } else {
+      hs_ = fouled ? std::max(thermo_.h_shell_with_fouling(m_dot_cold, Rf_shell, k_deposit), 1.0)
+                   : std::max(thermo_.h_shell(m_dot_cold), 1.0);
+      bdValid_ = false;
+    }
+    shellMethod_ = method;
+    shellMdot_ = m_dot_cold;
+    shellRf_ = Rf_shell;
+    shellKdep_ = k_deposit;
+    shellFluid_ = cold;
+    shellValid_ = true;
+    ++stats_.shellMisses;
+    changed = true;
+  }
+
+  // --- Series network ----------------------------------------------------------
+  if (!changed && uValid_ && Rf_tube == uRfTube_) {
+    ++stats_.uHits;
+    return U_;
+  }
+  U_ = thermo_.U_fromCoefficients(ht_, hs_, Rf_shell, Rf_tube);
+  uRfTube_ = Rf_tube;
+  uValid_ = true;
+  ++stats_.uMisses;
+  return U_;
+}
+
+bool HeatTransferMemo::shellPressureDrop(double m_dot_cold, double Rf_shell, double k_deposit,
+                                         double &dP) const {
+  if (!shellValid_ || !bdValid_ || m_dot_cold != shellMdot_ || Rf_shell != shellRf_ ||
+      k_deposit != shellKdep_ || !same(thermo_.cold(), shellFluid_)) {
+    return false;
+  }
+  dP = bd_.dP_shell;
+  return true;
+}
+
+void HeatTransferMemo::invalidate() {
+  tubeValid_ = false;
+  shellValid_ = false;
+  bdValid_ = false;
+  uValid_ = false;
+  stats_ = HeatTransferMemoStats{};
+}
+
+} // namespace hx
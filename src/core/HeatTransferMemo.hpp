@@ -0,0 +1,86 @@
+#pragma once
+
+#include "BellDelaware.hpp"
+#include "Thermo.hpp"
+#include "Types.hpp"
+
+namespace hx {
+
+/** \brief Hit / miss counters of HeatTransferMemo (since the last invalidate()). */
+struct HeatTransferMemoStats {
+  long long tubeHits = 0;     // h_tube reused
+  long long tubeMisses = 0;   // h_tube recomputed (hot flow or properties changed)
+  long long shellHits = 0;    // h_shell reused
+  long long shellMisses = 0;  // h_shell recomputed (cold flow, properties, Rf_shell or method changed)
+  long long uHits = 0;        // whole U reused
+  long long uMisses = 0;      // series network re-evaluated
+};
+
+/**
+ * \brief Incremental Thermo::U: recomputes only the terms whose inputs changed.
+ *
+ *  Thermo::U is three independent pieces — the tube-side coefficient (hot
+ *  flow, hot properties), the shell-side coefficient (cold flow, cold
+ *  properties, shell fouling, deposit conductivity, shell method) and the
+ *  series network that adds the wall and fouling resistances.  Each piece is
+ *  kept with a fingerprint of exactly those inputs (compared bit-for-bit), so
+ *  a steady run or a stretch between scenario events costs a few compares
+ *  per step, and a fouling run, where only Rf drifts, re-evaluates the shell
+ *  side but never the tube side.  Results are identical to Thermo::U.
+ *
+ *  In Bell–Delaware mode the shell-side term is a full BellDelawareResult,
+ *  so the step's ΔP_shell can be taken from it (shellPressureDrop()).
+ *
+ *  Reads the Thermo's current fluids on every call, so setHot() / setCold()
+ *  need no notification; call invalidate() only to restart the counters.
+ */
+class HeatTransferMemo {
+public:
+  explicit HeatTransferMemo(const Thermo &thermo) : thermo_(thermo) {}
+
+  /** Same as thermo.U(m_dot_hot, m_dot_cold, Rf_shell, Rf_tube, k_deposit). */
+  double U(double m_dot_hot, double m_dot_cold, double Rf_shell, double Rf_tube, double k_deposit);
+
+  /**
+   * \brief Bell–Delaware ΔP_shell of the cached shell-side term.
+   *  True (and \p dP set) when the last shell term was a Bell–Delaware
+   *  evaluation at exactly these arguments and equals
+   *  computeBellDelaware(g, cold, m_dot_cold, Rf_shell, k_deposit).dP_shell.
+   */
+  bool shellPressureDrop(double m_dot_cold, double Rf_shell, double k_deposit, double &dP) const;
+
+  /** Drop every cached term and zero the counters. */
+  void invalidate();
+
+  [[nodiscard]] const HeatTransferMemoStats &stats() const { return stats_; }
+
+private:
+  static bool same(const Fluid &a, const Fluid &b) {
+    return a.rho == b.rho && a.mu == b.mu && a.cp == b.cp && a.k == b.k;
+  }
+
+  const Thermo &thermo_;
+  HeatTransferMemoStats stats_;
+
+  // --- Tube side -------------------------------------------------------------
+  bool tubeValid_ = false;
+  double tubeMdot_ = 0.0;
+  Fluid tubeFluid_{};
+  double ht_ = 0.0;
+
+  // --- Shell side ------------------------------------------------------------
+  bool shellValid_ = false;
+  ShellSideMethod shellMethod_ = ShellSideMethod::Kern;
+  double shellMdot_ = 0.0, shellRf_ = 0.0, shellKdep_ = 0.0;
+  Fluid shellFluid_{};
+  double hs_ = 0.0;
+  bool bdValid_ = false;             // bd_ matches the ΔP_shell Hydraulics would return
+  BellDelawareResult bd_{};
+
+  // --- Series network --------------------------------------------------------
+  bool uValid_ = false;
+  double uRfTube_ = 0.0;
+  double U_ = 0.0;
+};
+
+} // namespace hx
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "BellDelaware.hpp"
 #include "Types.hpp"
 
 namespace hx {
@@ -15,6 +16,10 @@ public:
   /** Shell-side pressure drop (approximate cross-flow model). */
   [[nodiscard]] double dP_shell(double m_dot_cold, double Rf_shell, double k_deposit, double K_turns) const;
 
+  [[nodiscard]] const Fluid& cold() const { return cold_; }
+  void setHot(const Fluid &f)  { hot_  = f; }
+  void setCold(const Fluid &f) { cold_ = f; }
+
   /** Choose shell-side pressure-drop correlation: Kern or Bell–Delaware. */
   void setShellMethod(ShellSideMethod m) { shellMethod_ = m; }
   [[nodiscard]] ShellSideMethod shellMethod() const { return shellMethod_; }
@@ -24,6 +29,7 @@ private:
   Fluid hot_;
   Fluid cold_;
   ShellSideMethod shellMethod_ = ShellSideMethod::Kern;
+  BellDelawarePrecomputed bellDelaware_;   // geometry terms, built once
 };
 
 } // namespace hx
@@ -1,54 +1,387 @@
 #include "MonteCarlo.hpp"
+#include "Parallel.hpp"
+#include "Philox.hpp"
+#include "QuasiRandom.hpp"
+#include "SimulatorBatch.hpp"
+#include "StreamingStats.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
-#include <random>
+#include <map>
+#include <mutex>
 
 namespace hx {
 
 namespace {
 
-/** Run one trial and return the simulator's final State. */
-State runOneTrial(const OperatingPoint &op,
-                  const Geometry       &geom,
-                  const Fluid          &hot,
-                  const Fluid          &cold,
-                  const FoulingParams  &fp,
-                  const SimConfig      &baseCfg,
-                  double                trialSimTime,
-                  double                trialDt,
-                  bool                  foulingEnabled) {
+/** Inputs of one trial: a perturbed copy of the nominal case. */
+struct TrialInput {
+  OperatingPoint op;
+  Fluid          hot;
+  Fluid          cold;
+  FoulingParams  fp;
+};
+
+/** Simulator configuration shared by every trial. */
+SimConfig trialConfig(const SimConfig &baseCfg, const MonteCarloSettings &mc) {
   SimConfig cfg = baseCfg;
-  cfg.dt              = trialDt;
-  cfg.tEnd            = trialSimTime;
+  cfg.dt              = mc.trialDt;
+  cfg.tEnd            = mc.trialSimTime;
   cfg.pid.enabled     = false;                       // exclude control dynamics
   cfg.disturbanceType = SimConfig::DisturbanceType::None;
-  cfg.numAxialCells   = 1;                           // lumped → fast
+  cfg.numAxialCells   = std::max(1, mc.trialCells);  // lumped → fast (by default)
   cfg.scenario.clear();                              // no scripted timeline
+  return cfg;
+}
+
+/** Time steps of a Dynamic trial: ceil(tEnd / dt). */
+int trialStepCount(const SimConfig &cfg) {
+  return std::max(0, static_cast<int>(std::ceil(cfg.tEnd / cfg.dt)));
+}
 
-  Thermo     thermo(geom, hot, cold);
-  Hydraulics hydro (geom, hot, cold);
-  Fouling    foul  (fp);
+/**
+ * Fouling of a Steady / Converged trial: Rf held at the level a Dynamic
+ * trial ends on, i.e. Rf at the start of its last step.
+ */
+FoulingParams frozenFouling(const FoulingParams &fp, const SimConfig &cfg) {
+  FoulingParams frozen = fp;
+  frozen.Rf0   = Fouling(fp).Rf(std::max(0, trialStepCount(cfg) - 1) * cfg.dt);
+  frozen.alpha = 0.0;
+  frozen.model = FoulingParams::Model::Linear;
+  return frozen;
+}
+
+/** Run one trial and return the simulator's final State; adds the steps taken to \p steps. */
+State runOneTrial(const TrialInput &in,
+                  const Geometry   &geom,
+                  const SimConfig  &cfg,
+                  bool              foulingEnabled,
+                  TrialSolver       solver,
+                  double            settleTol,
+                  long long        &steps) {
+  Thermo     thermo(geom, in.hot, in.cold);
+  Hydraulics hydro (geom, in.hot, in.cold);
+  Fouling    foul  (solver == TrialSolver::Dynamic ? in.fp : frozenFouling(in.fp, cfg));
   thermo.setShellMethod(cfg.shellMethod);
   hydro .setShellMethod(cfg.shellMethod);
 
   Simulator sim(thermo, hydro, foul, cfg);
   sim.setSteadyStateMode(false);     // allow dynamics so it settles
   sim.setFoulingEnabled(foulingEnabled);
-  sim.reset(op);
+  sim.reset(in.op);
+
+  // Converged starts from the direct solve too, so integrating only has to
+  // confirm it (or finish the job where the Picard sweeps fell short).
+  if (solver != TrialSolver::Dynamic) {
+    sim.solveSteadyAxial();
+    if (solver == TrialSolver::Steady) return sim.state();
+  }
 
   State last{};
-  const int nSteps = static_cast<int>(std::ceil(trialSimTime / trialDt));
+  const int nSteps = trialStepCount(cfg);
   double t = 0.0;
   for (int k = 0; k < nSteps; ++k) {
+    const double Th = sim.state().Th_out;
+    const double Tc = sim.state().Tc_out;
     last = sim.step(t);
-    t += trialDt;
+    t += cfg.dt;
+    ++steps;
+    if (solver == TrialSolver::Converged &&
+        std::max(std::fabs(last.Th_out - Th), std::fabs(last.Tc_out - Tc)) < settleTol * cfg.dt) {
+      break;
+    }
   }
   return last;
 }
 
-MonteCarloStat computeStats(std::vector<double> v) {
+/** Lanes per SimulatorBatch work item; fixed so the blocking never depends on the thread count. */
+constexpr size_t kLanesPerBlock = 32;
+
+/** True once the workers should wind down: the study was cancelled or stopped. */
+bool halted(const MonteCarloControl &ctl) {
+  return ctl.cancel.load(std::memory_order_relaxed) || ctl.stop.load(std::memory_order_relaxed);
+}
+
+/**
+ * Run trials [begin, end) as the lanes of one SimulatorBatch (same solver
+ * and time grid as runOneTrial), crediting ctl.done as the block advances
+ * and adding the lane-steps taken to \p steps.  With TrialSolver::Converged
+ * the lanes start from solveSteady(), each retires once it settles and the
+ * block ends with its last lane.
+ * Returns false when the study is cancelled or stopped.
+ */
+bool runBlockBatched(const std::vector<TrialInput> &inputs,
+                     size_t begin, size_t end,
+                     const Geometry                &geom,
+                     const SimConfig               &cfg,
+                     bool                           foulingEnabled,
+                     TrialSolver                    solver,
+                     double                         settleTol,
+                     std::vector<State>            &states,
+                     long long                     &steps,
+                     MonteCarloControl             &ctl) {
+  SimulatorBatch batch(geom, cfg, foulingEnabled);
+  batch.reserve(end - begin);
+  for (size_t i = begin; i < end; ++i) {
+    const FoulingParams fp = solver == TrialSolver::Dynamic ? inputs[i].fp
+                                                            : frozenFouling(inputs[i].fp, cfg);
+    batch.addLane(inputs[i].op, inputs[i].hot, inputs[i].cold, fp);
+  }
+  batch.reset();
+
+  const long long lanes = static_cast<long long>(end - begin);
+  if (solver != TrialSolver::Dynamic) {
+    if (halted(ctl)) return false;
+    batch.solveSteady(0.0);
+  }
+  if (solver == TrialSolver::Steady) {
+    for (size_t i = begin; i < end; ++i) states[i] = batch.state(i - begin);
+    ctl.done.fetch_add(static_cast<int>(lanes), std::memory_order_relaxed);
+    return true;
+  }
+
+  const int nSteps = trialStepCount(cfg);
+  const int chunk  = std::max(1, nSteps / 20);
+  const std::vector<double> &rate = batch.rate();
+  long long credited = 0;
+  double t = 0.0;
+  for (int k = 0; k < nSteps; ++k) {
+    batch.step(t);
+    t += cfg.dt;
+    steps += static_cast<long long>(batch.activeCount());
+    bool settled = false;
+    if (solver == TrialSolver::Converged) {
+      for (size_t i = 0; i < batch.size(); ++i) {
+        if (batch.active(i) && rate[i] < settleTol) batch.deactivate(i);
+      }
+      settled = batch.activeCount() == 0;
+    }
+    if ((k + 1) % chunk == 0 || k == nSteps - 1 || settled) {
+      if (halted(ctl)) return false;
+      const long long due = settled ? lanes : lanes * (k + 1) / nSteps;
+      ctl.done.fetch_add(static_cast<int>(due - credited), std::memory_order_relaxed);
+      credited = due;
+    }
+    if (settled) break;
+  }
+  if (nSteps == 0) ctl.done.fetch_add(static_cast<int>(lanes), std::memory_order_relaxed);
+
+  if (nSteps > 0) {
+    for (size_t i = begin; i < end; ++i) states[i] = batch.state(i - begin);
+  }
+  return true;
+}
+
+/** Labels of the perturbed inputs, in sampling order (RfMax last, only with fouling). */
+const char *const kParamNames[] = {
+  "m\u0307 hot", "m\u0307 cold", "T in, hot", "T in, cold",
+  "\u03C1 hot", "\u03BC hot", "c\u209A hot", "k hot",
+  "\u03C1 cold", "\u03BC cold", "c\u209A cold", "k cold",
+  "R\u1D9C f\u2099\u2098\u2090\u2093",
+};
+
+/** Apply the standard-normal perturbations \p z (one per input) to \p in. */
+void applyPerturbation(const MonteCarloSettings &mc, const double *z, TrialInput &in) {
+  OperatingPoint &op = in.op;
+  Fluid &h = in.hot;
+  Fluid &c = in.cold;
+
+  op.m_dot_hot  *= std::max(0.1, 1.0 + mc.frac_mhot  * z[0]);
+  op.m_dot_cold *= std::max(0.1, 1.0 + mc.frac_mcold * z[1]);
+  op.Tin_hot   += mc.abs_Tin_hot  * z[2];
+  op.Tin_cold  += mc.abs_Tin_cold * z[3];
+
+  h.rho *= std::max(0.1, 1.0 + mc.frac_rho * z[4]);
+  h.mu  *= std::max(0.1, 1.0 + mc.frac_mu  * z[5]);
+  h.cp  *= std::max(0.1, 1.0 + mc.frac_cp  * z[6]);
+  h.k   *= std::max(0.1, 1.0 + mc.frac_k   * z[7]);
+
+  c.rho *= std::max(0.1, 1.0 + mc.frac_rho * z[8]);
+  c.mu  *= std::max(0.1, 1.0 + mc.frac_mu  * z[9]);
+  c.cp  *= std::max(0.1, 1.0 + mc.frac_cp  * z[10]);
+  c.k   *= std::max(0.1, 1.0 + mc.frac_k   * z[11]);
+
+  if (mc.includeFouling) {
+    in.fp.RfMax *= std::max(0.1, 1.0 + mc.frac_RfMax * z[12]);
+  }
+}
+
+/** Stream of the Latin-hypercube permutations (key = seed | replicate << 32). */
+constexpr std::uint64_t kLhsStream = 0x1A7E'0000'0000'0000ull;
+/** Key bit that separates the Saltelli B matrix from the ensemble (A). */
+constexpr std::uint64_t kMatrixBKey = 1ull << 63;
+/** Stream of the row shuffle of B. */
+constexpr std::uint64_t kShuffleStream = 0x5F1E'0000'0000'0000ull;
+/** Stream of the bootstrap row draws. */
+constexpr std::uint64_t kBootstrapStream = 0xB007'0000'0000'0000ull;
+
+/**
+ * Standard-normal perturbations of trial k, produced on demand so the
+ * ensemble never has to be materialised.  Plain MC reproduces the
+ * per-trial Philox draws; the designed strategies give trial k point k / R
+ * of replicate k mod R, each replicate an independent randomisation keyed
+ * by (seed, replicate).  Only the Latin hypercube keeps its whole design
+ * (8 bytes per trial and input) — its strata are a property of the set.
+ */
+class TrialSampler {
+public:
+  TrialSampler(SamplingStrategy sampling, std::uint64_t seed, size_t n, size_t dims, size_t replicates)
+      : sampling_(sampling), seed_(seed), dims_(dims), replicates_(std::max<size_t>(1, replicates)) {
+    if (sampling_ == SamplingStrategy::MonteCarlo) return;
+    for (size_t r = 0; r < replicates_; ++r) {
+      const std::uint64_t key = seed | (static_cast<std::uint64_t>(r) << 32);
+      switch (sampling_) {
+        case SamplingStrategy::Sobol:  sobol_.emplace_back(dims, key);  break;
+        case SamplingStrategy::Halton: halton_.emplace_back(dims, key); break;
+        default: {
+          if (lhs_.empty()) lhs_.resize(n * dims);
+          const size_t count = n / replicates_ + (r < n % replicates_ ? 1 : 0);
+          const std::vector<double> design = latinHypercube(count, dims, key, kLhsStream);
+          for (size_t i = 0; i < count; ++i) {
+            std::copy(&design[i * dims], &design[i * dims] + dims, &lhs_[(i * replicates_ + r) * dims]);
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  void normals(size_t k, double *z) const {
+    if (sampling_ == SamplingStrategy::MonteCarlo) {
+      PhiloxRng rng(seed_, static_cast<std::uint64_t>(k));
+      for (size_t d = 0; d < dims_; ++d) z[d] = rng.normal();
+      return;
+    }
+    const size_t r = k % replicates_;
+    const auto idx = static_cast<std::uint32_t>(k / replicates_);
+    for (size_t d = 0; d < dims_; ++d) {
+      double u;
+      switch (sampling_) {
+        case SamplingStrategy::Sobol:  u = sobol_[r].at(idx, d);  break;
+        case SamplingStrategy::Halton: u = halton_[r].at(idx, d); break;
+        default:                       u = lhs_[k * dims_ + d];   break;
+      }
+      z[d] = inverseNormalCdf(u);
+    }
+  }
+
+private:
+  SamplingStrategy sampling_;
+  std::uint64_t seed_;
+  size_t dims_;
+  size_t replicates_;
+  std::vector<SobolSampler>  sobol_;
+  std::vector<HaltonSampler> halton_;
+  std::vector<double>        lhs_;
+};
+
+/** Outputs summarised in MonteCarloStat, in MonteCarloResult order. */
+enum StatOutput : size_t { kStatQ, kStatU, kStatTc, kStatEps, kStatDPt, kStatDPs, kStatOutputs };
+
+/** t-digest compression of the ensemble sketch and of the per-replicate ones (only feed the SEs). */
+constexpr double kEnsembleCompression  = 200.0;
+constexpr double kReplicateCompression = 50.0;
+
+/**
+ * Streaming summary of one output: moments, quantile sketch and histogram
+ * of the whole ensemble, plus per-replicate moments / sketches for the
+ * standard errors.  A few tens of kilobytes whatever the trial count.
+ */
+struct OutputAccumulator {
+  RunningMoments              moments;
+  QuantileSketch              sketch;
+  StreamingHistogram          hist;
+  std::vector<RunningMoments> repMoments;
+  std::vector<QuantileSketch> repSketch;
+
+  explicit OutputAccumulator(size_t replicates)
+      : sketch(kEnsembleCompression),
+        repMoments(replicates),
+        repSketch(replicates, QuantileSketch(kReplicateCompression)) {}
+
+  void add(size_t trial, double x) {
+    moments.add(x);
+    sketch.add(x);
+    hist.add(x);
+    repMoments[trial % repMoments.size()].add(x);
+    repSketch [trial % repSketch.size()].add(x);
+  }
+
+  void merge(const OutputAccumulator &o) {
+    moments.merge(o.moments);
+    sketch.merge(o.sketch);
+    hist.merge(o.hist);
+    for (size_t r = 0; r < repMoments.size(); ++r) {
+      repMoments[r].merge(o.repMoments[r]);
+      repSketch[r].merge(o.repSketch[r]);
+    }
+  }
+};
+
+/** Trials per ensemble work item: a function of the trial count only (≈ 64 items). */
+size_t ensembleChunk(size_t nTrials) {
+  constexpr size_t kMaxChunk = 4096;
+  const size_t blocks = (nTrials / 64 + kLanesPerBlock - 1) / kLanesPerBlock;
+  return std::clamp(blocks * kLanesPerBlock, kLanesPerBlock, kMaxChunk);
+}
+
+/**
+ * Sobol' indices from the rows \p rows of the Saltelli outputs: fA, fB
+ * (N each) and fAB (K × N, row-major).  First order after Saltelli et al.
+ * (2010), total effect after Jansen (1999), both over Var of [fA; fB].
+ */
+void sobolEstimate(const std::vector<double> &fA, const std::vector<double> &fB,
+                   const std::vector<double> &fAB, const std::vector<size_t> &rows,
+                   size_t K, double *first, double *total) {
+  const size_t N = fA.size();
+  const double n = static_cast<double>(rows.size());
+  double sum = 0.0;
+  for (size_t j : rows) sum += fA[j] + fB[j];
+  const double mean = sum / (2.0 * n);
+  double sq = 0.0;
+  for (size_t j : rows) sq += (fA[j] - mean) * (fA[j] - mean) + (fB[j] - mean) * (fB[j] - mean);
+  const double var = sq / (2.0 * n - 1.0);
+
+  for (size_t i = 0; i < K; ++i) {
+    const double *fABi = &fAB[i * N];
+    double s1 = 0.0, st = 0.0;
+    for (size_t j : rows) {
+      s1 += (fB[j] - mean) * (fABi[j] - fA[j]);  // centred: stable when |mean| ≫ σ
+      st += (fA[j] - fABi[j]) * (fA[j] - fABi[j]);
+    }
+    first[i] = var > 0.0 ? s1 / n / var : 0.0;
+    total[i] = var > 0.0 ? st / (2.0 * n) / var : 0.0;
+  }
+}
+
+double percentile(const std::vector<double> &sorted, double p) {
+  if (sorted.size() == 1) return sorted.front();
+  const double idx = p * static_cast<double>(sorted.size() - 1);
+  const size_t lo = static_cast<size_t>(std::floor(idx));
+  const size_t hi = static_cast<size_t>(std::ceil(idx));
+  const double frac = idx - static_cast<double>(lo);
+  return sorted[lo] * (1.0 - frac) + sorted[hi] * frac;
+}
+
+double sampleStddev(const std::vector<double> &v) {
+  if (v.size() < 2) return 0.0;
+  double sum = 0.0;
+  for (double x : v) sum += x;
+  const double mean = sum / static_cast<double>(v.size());
+  double sq = 0.0;
+  for (double x : v) sq += (x - mean) * (x - mean);
+  return std::sqrt(sq / static_cast<double>(v.size() - 1));
+}
+
+/**
+ * Summary statistics of \p v.  The standard errors come from the spread of
+ * the per-replicate estimates (trial k belongs to replicate k mod R),
+ * except the i.i.d. mean, whose s/√n is exact.
+ */
+MonteCarloStat computeStats(const std::vector<double> &v, size_t replicates, bool iid) {
   MonteCarloStat s{};
   if (v.empty()) return s;
   double sum = 0.0;
@@ -58,23 +391,105 @@ MonteCarloStat computeStats(std::vector<double> v) {
   for (double x : v) sq += (x - s.mean) * (x - s.mean);
   s.stddev = (v.size() > 1) ? std::sqrt(sq / static_cast<double>(v.size() - 1)) : 0.0;
 
-  std::sort(v.begin(), v.end());
-  s.minv = v.front();
-  s.maxv = v.back();
-  auto pct = [&](double p) {
-    if (v.size() == 1) return v.front();
-    const double idx = p * static_cast<double>(v.size() - 1);
-    const size_t lo = static_cast<size_t>(std::floor(idx));
-    const size_t hi = static_cast<size_t>(std::ceil(idx));
-    const double frac = idx - static_cast<double>(lo);
-    return v[lo] * (1.0 - frac) + v[hi] * frac;
-  };
-  s.p5  = pct(0.05);
-  s.p50 = pct(0.50);
-  s.p95 = pct(0.95);
+  std::vector<double> sorted = v;
+  std::sort(sorted.begin(), sorted.end());
+  s.minv = sorted.front();
+  s.maxv = sorted.back();
+  s.p5  = percentile(sorted, 0.05);
+  s.p50 = percentile(sorted, 0.50);
+  s.p95 = percentile(sorted, 0.95);
+
+  if (iid) s.seMean = s.stddev / std::sqrt(static_cast<double>(v.size()));
+  if (replicates < 2 || v.size() < 2 * replicates) return s;
+
+  std::vector<double> means, p5s, p95s, rep;
+  means.reserve(replicates);
+  p5s.reserve(replicates);
+  p95s.reserve(replicates);
+  for (size_t r = 0; r < replicates; ++r) {
+    rep.clear();
+    for (size_t k = r; k < v.size(); k += replicates) rep.push_back(v[k]);
+    double repSum = 0.0;
+    for (double x : rep) repSum += x;
+    means.push_back(repSum / static_cast<double>(rep.size()));
+    std::sort(rep.begin(), rep.end());
+    p5s .push_back(percentile(rep, 0.05));
+    p95s.push_back(percentile(rep, 0.95));
+  }
+  const double rootR = std::sqrt(static_cast<double>(replicates));
+  if (!iid) s.seMean = sampleStddev(means) / rootR;
+  s.seP5  = sampleStddev(p5s)  / rootR;
+  s.seP95 = sampleStddev(p95s) / rootR;
+  return s;
+}
+
+void fillHistogram(const StreamingHistogram &h, MonteCarloStat &s) {
+  s.histLo       = h.lowerEdge();
+  s.histBinWidth = h.binWidth();
+  s.histCounts   = h.counts();
+}
+
+/** Summary statistics from a streaming accumulator (quantiles from the t-digest). */
+MonteCarloStat statsFromAccumulator(const OutputAccumulator &a, bool iid) {
+  MonteCarloStat s{};
+  const RunningMoments &m = a.moments;
+  if (m.count() == 0) return s;
+  s.mean   = m.mean();
+  s.stddev = m.stddev();
+  s.minv   = m.min();
+  s.maxv   = m.max();
+  s.p5  = a.sketch.quantile(0.05);
+  s.p50 = a.sketch.quantile(0.50);
+  s.p95 = a.sketch.quantile(0.95);
+  fillHistogram(a.hist, s);
+
+  const size_t replicates = a.repMoments.size();
+  if (iid) s.seMean = s.stddev / std::sqrt(static_cast<double>(m.count()));
+  if (replicates < 2 || m.count() < 2 * replicates) return s;
+
+  std::vector<double> means, p5s, p95s;
+  for (size_t r = 0; r < replicates; ++r) {
+    means.push_back(a.repMoments[r].mean());
+    p5s  .push_back(a.repSketch[r].quantile(0.05));
+    p95s .push_back(a.repSketch[r].quantile(0.95));
+  }
+  const double rootR = std::sqrt(static_cast<double>(replicates));
+  if (!iid) s.seMean = sampleStddev(means) / rootR;
+  s.seP5  = sampleStddev(p5s)  / rootR;
+  s.seP95 = sampleStddev(p95s) / rootR;
   return s;
 }
 
+/** The summary statistics of \p r, indexed like StatOutput. */
+std::vector<MonteCarloStat *> statFields(MonteCarloResult &r) {
+  return {&r.statQ, &r.statU, &r.statTc, &r.statEps, &r.statDPt, &r.statDPs};
+}
+
+/**
+ * Convergence-history entry for the heat-duty accumulator \p q: the subset
+ * of statsFromAccumulator() it needs, one quantile per sketch.
+ */
+MonteCarloConvergence convergencePoint(const OutputAccumulator &q, bool iid) {
+  MonteCarloConvergence c;
+  const RunningMoments &m = q.moments;
+  c.trials = static_cast<int>(m.count());
+  c.meanQ  = m.mean();
+  c.p95Q   = q.sketch.quantile(0.95);
+  if (iid) c.seMeanQ = m.stddev() / std::sqrt(static_cast<double>(m.count()));
+
+  const size_t replicates = q.repMoments.size();
+  if (replicates < 2 || m.count() < 2 * replicates) return c;
+  std::vector<double> means, p95s;
+  for (size_t r = 0; r < replicates; ++r) {
+    means.push_back(q.repMoments[r].mean());
+    p95s .push_back(q.repSketch[r].quantile(0.95));
+  }
+  const double rootR = std::sqrt(static_cast<double>(replicates));
+  if (!iid) c.seMeanQ = sampleStddev(means) / rootR;
+  c.seP95Q = sampleStddev(p95s) / rootR;
+  return c;
+}
+
 double computeEpsilon(const OperatingPoint &op, const Fluid &hot, const Fluid &cold,
                       const State &s) {
   const double Ch   = op.m_dot_hot  * hot.cp;
@@ -94,6 +509,29 @@ double computeNTU(const OperatingPoint &op, const Fluid &hot, const Fluid &cold,
 
 } // anonymous namespace
 
+size_t perturbedInputCount(const MonteCarloSettings &mc) { return mc.includeFouling ? 13 : 12; }
+
+const char *perturbedInputName(size_t i) {
+  return i < sizeof(kParamNames) / sizeof(kParamNames[0]) ? kParamNames[i] : "";
+}
+
+double perturbedInputSigma(const MonteCarloSettings &mc, size_t i) {
+  const double sigma[] = {mc.frac_mhot, mc.frac_mcold, mc.abs_Tin_hot, mc.abs_Tin_cold,
+                          mc.frac_rho,  mc.frac_mu,    mc.frac_cp,     mc.frac_k,
+                          mc.frac_rho,  mc.frac_mu,    mc.frac_cp,     mc.frac_k,
+                          mc.frac_RfMax};
+  return i < perturbedInputCount(mc) ? sigma[i] : 0.0;
+}
+
+const char *trialSolverName(TrialSolver solver) {
+  switch (solver) {
+    case TrialSolver::Converged: return "integrated to convergence";
+    case TrialSolver::Dynamic:   return "full dynamic horizon";
+    case TrialSolver::Steady:
+    default:                     return "steady solve";
+  }
+}
+
 MonteCarloResult runMonteCarlo(const OperatingPoint &op0,
                                const Geometry       &geom,
                                const Fluid          &hot,
@@ -101,171 +539,367 @@ MonteCarloResult runMonteCarlo(const OperatingPoint &op0,
                                const FoulingParams  &fp,
                                const SimConfig      &baseCfg,
                                const MonteCarloSettings &mc,
-                               MonteCarloProgress   progress) {
+                               MonteCarloProgress   progress,
+                               MonteCarloControl   *control) {
   MonteCarloResult out;
+  out.includeFouling = mc.includeFouling;
   if (mc.nTrials < 2) {
     out.ok = false;
     out.message = "Monte-Carlo needs at least 2 trials.";
     return out;
   }
 
-  // Baseline (nominal) trial.
-  const State sBase = runOneTrial(op0, geom, hot, cold, fp, baseCfg,
-                                  mc.trialSimTime, mc.trialDt, mc.includeFouling);
-  out.baselineQ = sBase.Q;
-  out.baselineU = sBase.U;
-
-  out.Q       .reserve(static_cast<size_t>(mc.nTrials));
-  out.U       .reserve(static_cast<size_t>(mc.nTrials));
-  out.Tc_out  .reserve(static_cast<size_t>(mc.nTrials));
-  out.Th_out  .reserve(static_cast<size_t>(mc.nTrials));
-  out.dP_tube .reserve(static_cast<size_t>(mc.nTrials));
-  out.dP_shell.reserve(static_cast<size_t>(mc.nTrials));
-  out.eps     .reserve(static_cast<size_t>(mc.nTrials));
-  out.NTU     .reserve(static_cast<size_t>(mc.nTrials));
-
-  std::mt19937 rng(mc.seed);
-  std::normal_distribution<double> nd(0.0, 1.0);
-
-  const int totalWork = mc.nTrials + 22;  // 2 trials per tornado parameter (~11)
-  int done = 0;
+  const SimConfig cfg = trialConfig(baseCfg, mc);
+
+  // The ensemble is generated, run and summarised chunk by chunk; only the
+  // Saltelli matrices B and A_B^(i) are built up front (the first N ensemble
+  // trials double as matrix A).
+  const size_t nTrials = static_cast<size_t>(mc.nTrials);
+  const size_t dims = perturbedInputCount(mc);
+  const size_t replicates = static_cast<size_t>(std::clamp(mc.replicates, 1, mc.nTrials));
+  const size_t nSobol = static_cast<size_t>(std::clamp(mc.sobolSamples, 0, mc.nTrials));
+  const TrialSampler sampler(mc.sampling, mc.seed, nTrials, dims, replicates);
+
+  const bool iid = (mc.sampling == SamplingStrategy::MonteCarlo);
+
+  std::vector<TrialInput> fixed;
+  fixed.reserve(nSobol * (dims + 1));
+
+  // === Saltelli matrices: B, then A with column i taken from B ===
+  std::vector<double> zA(nSobol * dims);
+  for (size_t j = 0; j < nSobol; ++j) sampler.normals(j, &zA[j * dims]);
+  if (nSobol > 0) {
+    // B is an independent randomisation of the same design.  Its rows are
+    // shuffled: row j of two scrambles of one net is the same underlying
+    // point, and pairing them would correlate A and B and bias the indices.
+    const TrialSampler samplerB(mc.sampling, mc.seed | kMatrixBKey, nSobol, dims,
+                                std::min(replicates, nSobol));
+    std::vector<size_t> order(nSobol);
+    for (size_t j = 0; j < nSobol; ++j) order[j] = j;
+    PhiloxRng shuffle(mc.seed | kMatrixBKey, kShuffleStream);
+    for (size_t j = nSobol - 1; j > 0; --j) {
+      std::swap(order[j], order[std::min(j, static_cast<size_t>(shuffle.uniform() * static_cast<double>(j + 1)))]);
+    }
+    std::vector<double> zB(nSobol * dims);
+    for (size_t j = 0; j < nSobol; ++j) {
+      samplerB.normals(order[j], &zB[j * dims]);
+      TrialInput in{op0, hot, cold, fp};
+      applyPerturbation(mc, &zB[j * dims], in);
+      fixed.push_back(in);
+    }
+    std::vector<double> zi(dims);
+    for (size_t i = 0; i < dims; ++i) {
+      for (size_t j = 0; j < nSobol; ++j) {
+        std::copy(&zA[j * dims], &zA[j * dims] + dims, zi.begin());
+        zi[i] = zB[j * dims + i];
+        TrialInput in{op0, hot, cold, fp};
+        applyPerturbation(mc, zi.data(), in);
+        fixed.push_back(in);
+      }
+    }
+  }
+
+  const int totalWork = static_cast<int>(1 + nTrials + fixed.size());
+  MonteCarloControl localControl;
+  MonteCarloControl &ctl = control ? *control : localControl;
+  ctl.done.store(0);
+  ctl.total.store(totalWork);
   if (progress && !progress(0, totalWork, "Running Monte-Carlo trials")) {
+    ctl.cancel.store(true);
+  }
+  if (ctl.cancel.load()) {
     out.ok = false;
     out.message = "Cancelled.";
     return out;
   }
 
-  // === Full Monte-Carlo ensemble: perturb everything ===
-  for (int k = 0; k < mc.nTrials; ++k) {
-    OperatingPoint op = op0;
-    Fluid h = hot;
-    Fluid c = cold;
-    FoulingParams fpk = fp;
-
-    op.m_dot_hot  *= std::max(0.1, 1.0 + mc.frac_mhot  * nd(rng));
-    op.m_dot_cold *= std::max(0.1, 1.0 + mc.frac_mcold * nd(rng));
-    op.Tin_hot   += mc.abs_Tin_hot  * nd(rng);
-    op.Tin_cold  += mc.abs_Tin_cold * nd(rng);
-
-    h.rho *= std::max(0.1, 1.0 + mc.frac_rho * nd(rng));
-    h.mu  *= std::max(0.1, 1.0 + mc.frac_mu  * nd(rng));
-    h.cp  *= std::max(0.1, 1.0 + mc.frac_cp  * nd(rng));
-    h.k   *= std::max(0.1, 1.0 + mc.frac_k   * nd(rng));
-
-    c.rho *= std::max(0.1, 1.0 + mc.frac_rho * nd(rng));
-    c.mu  *= std::max(0.1, 1.0 + mc.frac_mu  * nd(rng));
-    c.cp  *= std::max(0.1, 1.0 + mc.frac_cp  * nd(rng));
-    c.k   *= std::max(0.1, 1.0 + mc.frac_k   * nd(rng));
-
-    if (mc.includeFouling) {
-      fpk.RfMax *= std::max(0.1, 1.0 + mc.frac_RfMax * nd(rng));
+  if (mc.keepTrials) {
+    for (auto *v : {&out.Q, &out.U, &out.Tc_out, &out.Th_out, &out.dP_tube, &out.dP_shell,
+                    &out.eps, &out.NTU}) {
+      v->assign(nTrials, 0.0);
+    }
+  }
+  std::vector<State> statesA(nSobol, State{});
+  std::vector<State> fixedStates(fixed.size(), State{});
+
+  // Chunk summaries are folded into `summary` strictly in chunk order, so the
+  // floating-point result does not depend on which worker finished first.
+  // Workers claim chunks in increasing order, so only about one chunk per
+  // thread ever waits in `pending`.
+  std::vector<OutputAccumulator> summary(kStatOutputs, OutputAccumulator(replicates));
+  std::map<size_t, std::vector<OutputAccumulator>> pending;
+  size_t nextChunk = 0;
+  std::mutex summaryMutex;
+
+  // Also under summaryMutex: the convergence history of a live study,
+  // recorded whenever the merged prefix has grown by a fifth (so at trial
+  // counts that depend only on nTrials), and the rate limit of its snapshots.
+  const bool live = mc.snapshotIntervalMs > 0;
+  std::vector<MonteCarloConvergence> convergence;
+  size_t nextCheckpoint = 0;
+  const auto snapshotInterval = std::chrono::milliseconds(std::max(0, mc.snapshotIntervalMs));
+  auto lastSnapshot = std::chrono::steady_clock::now();
+
+  // Work items: ensemble chunks first, then the fixed trials in blocks of
+  // SimulatorBatch lanes (or singly).  Every item writes only its own slots.
+  const bool batched = SimulatorBatch::supports(cfg);
+  const size_t itemSize = batched ? kLanesPerBlock : 1;
+  const size_t chunk = ensembleChunk(nTrials);
+  const size_t nChunks = (nTrials + chunk - 1) / chunk;
+  const size_t nItems = nChunks + (fixed.size() + itemSize - 1) / itemSize;
+
+  std::atomic<long long> stepsTaken{0};
+  std::atomic<size_t> fixedDone{0};
+  auto runTrials = [&](std::vector<TrialInput> &inputs, size_t begin, size_t end,
+                       std::vector<State> &states) {
+    long long steps = 0;
+    for (size_t b = begin; b < end; b += itemSize) {
+      const size_t e = std::min(end, b + itemSize);
+      if (batched) {
+        if (!runBlockBatched(inputs, b, e, geom, cfg, mc.includeFouling, mc.solver, mc.settleTol,
+                             states, steps, ctl)) {
+          return false;
+        }
+      } else {
+        if (halted(ctl)) return false;
+        states[b] = runOneTrial(inputs[b], geom, cfg, mc.includeFouling, mc.solver, mc.settleTol,
+                                steps);
+        ctl.done.fetch_add(1, std::memory_order_relaxed);
+      }
     }
+    stepsTaken.fetch_add(steps, std::memory_order_relaxed);
+    return true;
+  };
+
+  // Baseline (nominal) trial first, so a study stopped early still reports it.
+  std::vector<TrialInput> nominal(1, TrialInput{op0, hot, cold, fp});
+  std::vector<State> baseline(1, State{});
+  runTrials(nominal, 0, 1, baseline);
+  out.baselineQ = baseline[0].Q;
+  out.baselineU = baseline[0].U;
+  out.paramNames.assign(kParamNames, kParamNames + dims);
+
+  // Partial result over the first `merged` trials; no per-trial vectors.
+  auto makeSnapshot = [&](size_t merged) {
+    auto snap = std::make_shared<MonteCarloResult>();
+    snap->ok             = true;
+    snap->partial        = true;
+    snap->nTrials        = static_cast<int>(merged);
+    snap->nTrialsPlanned = static_cast<int>(nTrials);
+    snap->sampling       = mc.sampling;
+    snap->replicates     = static_cast<int>(replicates);
+    snap->solver         = mc.solver;
+    snap->includeFouling = mc.includeFouling;
+    snap->paramNames     = out.paramNames;
+    snap->baselineQ      = out.baselineQ;
+    snap->baselineU      = out.baselineU;
+    snap->convergence    = convergence;
+    const std::vector<MonteCarloStat *> stats = statFields(*snap);
+    for (size_t o = 0; o < kStatOutputs; ++o) *stats[o] = statsFromAccumulator(summary[o], iid);
+    char buf[96];
+    std::snprintf(buf, sizeof(buf), "Running: %zu of %zu trials.", merged, nTrials);
+    snap->message = buf;
+    return std::shared_ptr<const MonteCarloResult>(std::move(snap));
+  };
 
-    const State s = runOneTrial(op, geom, h, c, fpk, baseCfg,
-                                mc.trialSimTime, mc.trialDt, mc.includeFouling);
-
-    out.Q       .push_back(s.Q);
-    out.U       .push_back(s.U);
-    out.Tc_out  .push_back(s.Tc_out);
-    out.Th_out  .push_back(s.Th_out);
-    out.dP_tube .push_back(s.dP_tube);
-    out.dP_shell.push_back(s.dP_shell);
-    out.eps     .push_back(computeEpsilon(op, h, c, s));
-    out.NTU     .push_back(computeNTU    (op, h, c, geom, s));
-
-    ++done;
-    if (progress && (k % 5 == 0 || k == mc.nTrials - 1)) {
-      if (!progress(done, totalWork, "Running Monte-Carlo trials")) {
-        out.ok = false;
-        out.message = "Cancelled.";
-        return out;
+  auto runChunk = [&](size_t c) {
+    if (halted(ctl)) return;
+    const size_t begin = c * chunk;
+    const size_t n = std::min(nTrials, begin + chunk) - begin;
+    std::vector<TrialInput> inputs(n, TrialInput{op0, hot, cold, fp});
+    std::vector<State> states(n, State{});
+    double z[SobolSampler::kMaxDims];
+    for (size_t i = 0; i < n; ++i) {
+      sampler.normals(begin + i, z);
+      applyPerturbation(mc, z, inputs[i]);
+    }
+    if (!runTrials(inputs, 0, n, states)) return;
+
+    std::vector<OutputAccumulator> acc(kStatOutputs, OutputAccumulator(replicates));
+    for (size_t i = 0; i < n; ++i) {
+      const size_t k = begin + i;
+      const TrialInput &in = inputs[i];
+      const State &st = states[i];
+      const double eps = computeEpsilon(in.op, in.hot, in.cold, st);
+      acc[kStatQ]  .add(k, st.Q);
+      acc[kStatU]  .add(k, st.U);
+      acc[kStatTc] .add(k, st.Tc_out);
+      acc[kStatEps].add(k, eps);
+      acc[kStatDPt].add(k, st.dP_tube);
+      acc[kStatDPs].add(k, st.dP_shell);
+      if (mc.keepTrials) {
+        out.Q[k]        = st.Q;
+        out.U[k]        = st.U;
+        out.Tc_out[k]   = st.Tc_out;
+        out.Th_out[k]   = st.Th_out;
+        out.dP_tube[k]  = st.dP_tube;
+        out.dP_shell[k] = st.dP_shell;
+        out.eps[k]      = eps;
+        out.NTU[k]      = computeNTU(in.op, in.hot, in.cold, geom, st);
       }
+      if (k < nSobol) statesA[k] = st;
     }
-  }
-  out.nTrials = static_cast<int>(out.Q.size());
 
-  // === Tornado analysis: ±1σ per parameter, all others nominal ===
-  struct ParamPerturb {
-    const char *name;
-    // delta applied in place; returns perturbed copies of op/hot/cold/fp
-    std::function<void(OperatingPoint&, Fluid&, Fluid&, FoulingParams&, double /*sign*/)> apply;
+    std::lock_guard<std::mutex> lock(summaryMutex);
+    pending.emplace(c, std::move(acc));
+    size_t merged = 0;
+    while (!pending.empty() && pending.begin()->first == nextChunk) {
+      for (size_t o = 0; o < kStatOutputs; ++o) summary[o].merge(pending.begin()->second[o]);
+      pending.erase(pending.begin());
+      ++nextChunk;
+      merged = std::min(nTrials, nextChunk * chunk);
+      if (live && (merged >= nextCheckpoint || merged == nTrials)) {
+        convergence.push_back(convergencePoint(summary[kStatQ], iid));
+        nextCheckpoint = merged + merged / 5;
+      }
+    }
+    if (merged > 0 && live) {
+      const auto now = std::chrono::steady_clock::now();
+      if (merged == nTrials || now - lastSnapshot >= snapshotInterval) {
+        lastSnapshot = now;
+        ctl.publish(makeSnapshot(merged));
+      }
+    }
   };
 
-  std::vector<ParamPerturb> params = {
-    {"m\u0307 hot",   [&](OperatingPoint &o, Fluid&, Fluid&, FoulingParams&, double s) {
-        o.m_dot_hot  *= std::max(0.1, 1.0 + s * mc.frac_mhot);
-    }},
-    {"m\u0307 cold",  [&](OperatingPoint &o, Fluid&, Fluid&, FoulingParams&, double s) {
-        o.m_dot_cold *= std::max(0.1, 1.0 + s * mc.frac_mcold);
-    }},
-    {"T in, hot",    [&](OperatingPoint &o, Fluid&, Fluid&, FoulingParams&, double s) {
-        o.Tin_hot   += s * mc.abs_Tin_hot;
-    }},
-    {"T in, cold",   [&](OperatingPoint &o, Fluid&, Fluid&, FoulingParams&, double s) {
-        o.Tin_cold  += s * mc.abs_Tin_cold;
-    }},
-    {"\u03C1 hot",   [&](OperatingPoint&, Fluid &h, Fluid&, FoulingParams&, double s) {
-        h.rho *= std::max(0.1, 1.0 + s * mc.frac_rho);
-    }},
-    {"\u03BC hot",   [&](OperatingPoint&, Fluid &h, Fluid&, FoulingParams&, double s) {
-        h.mu  *= std::max(0.1, 1.0 + s * mc.frac_mu);
-    }},
-    {"c\u209A hot",  [&](OperatingPoint&, Fluid &h, Fluid&, FoulingParams&, double s) {
-        h.cp  *= std::max(0.1, 1.0 + s * mc.frac_cp);
-    }},
-    {"k hot",        [&](OperatingPoint&, Fluid &h, Fluid&, FoulingParams&, double s) {
-        h.k   *= std::max(0.1, 1.0 + s * mc.frac_k);
-    }},
-    {"\u03C1 cold",  [&](OperatingPoint&, Fluid&, Fluid &c, FoulingParams&, double s) {
-        c.rho *= std::max(0.1, 1.0 + s * mc.frac_rho);
-    }},
-    {"\u03BC cold",  [&](OperatingPoint&, Fluid&, Fluid &c, FoulingParams&, double s) {
-        c.mu  *= std::max(0.1, 1.0 + s * mc.frac_mu);
-    }},
-    {"c\u209A cold", [&](OperatingPoint&, Fluid&, Fluid &c, FoulingParams&, double s) {
-        c.cp  *= std::max(0.1, 1.0 + s * mc.frac_cp);
-    }},
-    {"k cold",       [&](OperatingPoint&, Fluid&, Fluid &c, FoulingParams&, double s) {
-        c.k   *= std::max(0.1, 1.0 + s * mc.frac_k);
-    }},
+  auto body = [&](size_t item) {
+    if (item < nChunks) {
+      runChunk(item);
+    } else {
+      const size_t begin = (item - nChunks) * itemSize;
+      const size_t end = std::min(fixed.size(), begin + itemSize);
+      if (runTrials(fixed, begin, end, fixedStates)) fixedDone.fetch_add(end - begin);
+    }
   };
-  if (mc.includeFouling) {
-    params.push_back({"R\u1D9C f\u2099\u2098\u2090\u2093",
-      [&](OperatingPoint&, Fluid&, Fluid&, FoulingParams &f, double s) {
-        f.RfMax *= std::max(0.1, 1.0 + s * mc.frac_RfMax);
-    }});
+  std::function<void()> poll;
+  if (progress) {
+    poll = [&]() {
+      const char *phase = batched ? "Running Monte-Carlo trials (batched)"
+                                  : "Running Monte-Carlo trials";
+      if (!progress(ctl.done.load(std::memory_order_relaxed), totalWork, phase)) {
+        ctl.cancel.store(true);
+      }
+    };
   }
-
-  out.tornado.reserve(params.size());
-  if (progress && !progress(done, totalWork, "Tornado sensitivity")) {
+  const bool finished = parallelFor(nItems, resolveThreadCount(mc.threads), body,
+                                    &ctl.cancel, poll) &&
+                        !ctl.cancel.load();
+  if (!finished) {
     out.ok = false;
     out.message = "Cancelled.";
     return out;
   }
 
-  for (const auto &p : params) {
-    OperatingPoint op_p = op0;  Fluid h_p = hot; Fluid c_p = cold; FoulingParams fp_p = fp;
-    OperatingPoint op_m = op0;  Fluid h_m = hot; Fluid c_m = cold; FoulingParams fp_m = fp;
-    p.apply(op_p, h_p, c_p, fp_p, +1.0);
-    p.apply(op_m, h_m, c_m, fp_m, -1.0);
-
-    const State sPlus  = runOneTrial(op_p, geom, h_p, c_p, fp_p, baseCfg,
-                                     mc.trialSimTime, mc.trialDt, mc.includeFouling);
-    const State sMinus = runOneTrial(op_m, geom, h_m, c_m, fp_m, baseCfg,
-                                     mc.trialSimTime, mc.trialDt, mc.includeFouling);
-
-    TornadoEntry e;
-    e.name        = p.name;
-    e.deltaPlus   = sPlus.Q  - out.baselineQ;
-    e.deltaMinus  = sMinus.Q - out.baselineQ;
-    e.sensitivity = std::max(std::fabs(e.deltaPlus), std::fabs(e.deltaMinus));
-    out.tornado.push_back(e);
-
-    done += 2;
-    if (progress && !progress(done, totalWork, "Tornado sensitivity")) {
-      out.ok = false;
-      out.message = "Cancelled.";
-      return out;
+  // A stop leaves the ensemble prefix merged so far (whole chunks) and, if
+  // it came before the Saltelli trials finished, no sensitivity analysis.
+  const size_t nDone = std::min(nTrials, nextChunk * chunk);
+  const bool complete = nDone == nTrials && fixedDone.load() == fixed.size();
+  if (nDone < 2) {
+    out.ok = false;
+    out.message = "Stopped before any trials finished.";
+    return out;
+  }
+  if (complete && progress) progress(totalWork, totalWork, "Running Monte-Carlo trials");
+
+  out.nTrials = static_cast<int>(nDone);
+  out.nTrialsPlanned = static_cast<int>(nTrials);
+  out.partial = !complete;
+  out.solver = mc.solver;
+  out.meanSteps = static_cast<double>(stepsTaken.load()) /
+                  static_cast<double>(std::max(1, ctl.done.load()));
+  out.convergence = std::move(convergence);
+  if (live && (out.convergence.empty() || out.convergence.back().trials != out.nTrials)) {
+    out.convergence.push_back(convergencePoint(summary[kStatQ], iid));
+  }
+
+  out.sobolSamples = complete ? static_cast<int>(nSobol) : 0;
+  if (nSobol > 0 && complete) {
+    struct OutputDef {
+      const char *name;
+      double State::*field;
+    };
+    const OutputDef outputs[] = {{"Q", &State::Q},
+                                 {"U", &State::U},
+                                 {"Tc_out", &State::Tc_out},
+                                 {"dP_tube", &State::dP_tube},
+                                 {"dP_shell", &State::dP_shell}};
+    const size_t nOutputs = sizeof(outputs) / sizeof(outputs[0]);
+    const size_t nBoot = static_cast<size_t>(std::max(0, mc.bootstrapResamples));
+    out.bootstrapResamples = static_cast<int>(nBoot);
+    out.sobol.resize(nOutputs);
+
+    // One work item per output: point estimates, then the bootstrap, whose
+    // row draws come from Philox stream (seed, kBootstrapStream + b) and so
+    // are shared by all outputs.
+    auto estimate = [&](size_t o) {
+      const double State::*field = outputs[o].field;
+      std::vector<double> fA(nSobol), fB(nSobol), fAB(dims * nSobol);
+      for (size_t j = 0; j < nSobol; ++j) {
+        fA[j] = statesA[j].*field;
+        fB[j] = fixedStates[j].*field;
+      }
+      for (size_t i = 0; i < dims * nSobol; ++i) fAB[i] = fixedStates[nSobol + i].*field;
+
+      std::vector<size_t> rows(nSobol);
+      for (size_t j = 0; j < nSobol; ++j) rows[j] = j;
+      std::vector<double> first(dims), total(dims);
+      sobolEstimate(fA, fB, fAB, rows, dims, first.data(), total.data());
+
+      SobolIndices &si = out.sobol[o];
+      si.output = outputs[o].name;
+      si.index.resize(dims);
+      std::vector<double> pooled(fA);
+      pooled.insert(pooled.end(), fB.begin(), fB.end());
+      const double sd = sampleStddev(pooled);
+      si.variance = sd * sd;
+      for (size_t i = 0; i < dims; ++i) {
+        SobolIndex &x = si.index[i];
+        x.first = x.firstLo = x.firstHi = first[i];
+        x.total = x.totalLo = x.totalHi = total[i];
+      }
+      if (nBoot == 0) return;
+
+      std::vector<double> bootFirst(nBoot * dims), bootTotal(nBoot * dims);
+      for (size_t b = 0; b < nBoot; ++b) {
+        PhiloxRng rng(mc.seed, kBootstrapStream + b);
+        for (size_t j = 0; j < nSobol; ++j) {
+          rows[j] = std::min(nSobol - 1, static_cast<size_t>(rng.uniform() * static_cast<double>(nSobol)));
+        }
+        sobolEstimate(fA, fB, fAB, rows, dims, first.data(), total.data());
+        for (size_t i = 0; i < dims; ++i) {
+          bootFirst[i * nBoot + b] = first[i];
+          bootTotal[i * nBoot + b] = total[i];
+        }
+      }
+      std::vector<double> sorted(nBoot);
+      for (size_t i = 0; i < dims; ++i) {
+        SobolIndex &x = si.index[i];
+        sorted.assign(&bootFirst[i * nBoot], &bootFirst[i * nBoot] + nBoot);
+        std::sort(sorted.begin(), sorted.end());
+        x.firstLo = percentile(sorted, 0.025);
+        x.firstHi = percentile(sorted, 0.975);
+        sorted.assign(&bootTotal[i * nBoot], &bootTotal[i * nBoot] + nBoot);
+        std::sort(sorted.begin(), sorted.end());
+        x.totalLo = percentile(sorted, 0.025);
+        x.totalHi = percentile(sorted, 0.975);
+      }
+    };
+    parallelFor(nOutputs, resolveThreadCount(mc.threads), estimate);
+
+    // Tornado bars from the total effects on Q, signed by each input's
+    // correlation with Q over the A rows.
+    const SobolIndices &sq = out.sobol[0];
+    const double sigmaQ = std::sqrt(sq.variance);
+    out.tornado.reserve(dims);
+    for (size_t i = 0; i < dims; ++i) {
+      double cov = 0.0;
+      for (size_t j = 0; j < nSobol; ++j) cov += zA[j * dims + i] * (statesA[j].Q - out.baselineQ);
+      TornadoEntry e;
+      e.name        = kParamNames[i];
+      e.sensitivity = sigmaQ * std::sqrt(std::max(0.0, sq.index[i].total));
+      e.deltaPlus   = cov < 0.0 ? -e.sensitivity : e.sensitivity;
+      e.deltaMinus  = -e.deltaPlus;
+      out.tornado.push_back(e);
     }
   }
 
@@ -275,22 +909,86 @@ MonteCarloResult runMonteCarlo(const OperatingPoint &op0,
               return a.sensitivity > b.sensitivity;
             });
 
-  out.statQ   = computeStats(out.Q);
-  out.statU   = computeStats(out.U);
-  out.statTc  = computeStats(out.Tc_out);
-  out.statEps = computeStats(out.eps);
-  out.statDPt = computeStats(out.dP_tube);
-  out.statDPs = computeStats(out.dP_shell);
+  out.sampling   = mc.sampling;
+  out.replicates = static_cast<int>(replicates);
+  const std::vector<MonteCarloStat *> stats = statFields(out);
+  if (mc.keepTrials) {
+    // Exact order statistics from the kept vectors (cut to the merged prefix).
+    for (auto *v : {&out.Q, &out.U, &out.Tc_out, &out.Th_out, &out.dP_tube, &out.dP_shell,
+                    &out.eps, &out.NTU}) {
+      v->resize(nDone);
+    }
+    const std::vector<double> *data[kStatOutputs] = {&out.Q, &out.U, &out.Tc_out,
+                                                     &out.eps, &out.dP_tube, &out.dP_shell};
+    for (size_t o = 0; o < kStatOutputs; ++o) {
+      *stats[o] = computeStats(*data[o], replicates, iid);
+      fillHistogram(summary[o].hist, *stats[o]);
+    }
+  } else {
+    for (size_t o = 0; o < kStatOutputs; ++o) *stats[o] = statsFromAccumulator(summary[o], iid);
+  }
 
   out.ok = true;
   char buf[256];
-  std::snprintf(buf, sizeof(buf),
-                "Monte-Carlo complete: %d trials, %zu tornado params. "
-                "Q = %.1f ± %.1f W (p5..p95: %.1f..%.1f).",
-                out.nTrials, out.tornado.size(),
-                out.statQ.mean, out.statQ.stddev, out.statQ.p5, out.statQ.p95);
+  if (complete) {
+    std::snprintf(buf, sizeof(buf),
+                  "Monte-Carlo complete: %d trials (%s, %s), Sobol' indices from N = %d. "
+                  "Q = %.1f ± %.1f W (SE %.2f; p5..p95: %.1f..%.1f).",
+                  out.nTrials, samplingStrategyName(mc.sampling), trialSolverName(mc.solver),
+                  out.sobolSamples,
+                  out.statQ.mean, out.statQ.stddev, out.statQ.seMean,
+                  out.statQ.p5, out.statQ.p95);
+  } else {
+    std::snprintf(buf, sizeof(buf),
+                  "Monte-Carlo stopped after %d of %d trials (%s, %s), no Sobol' indices. "
+                  "Q = %.1f ± %.1f W (SE %.2f; p5..p95: %.1f..%.1f).",
+                  out.nTrials, out.nTrialsPlanned, samplingStrategyName(mc.sampling),
+                  trialSolverName(mc.solver),
+                  out.statQ.mean, out.statQ.stddev, out.statQ.seMean,
+                  out.statQ.p5, out.statQ.p95);
+  }
   out.message = buf;
   return out;
 }
 
+std::vector<State> evaluatePerturbations(const OperatingPoint &op0,
+                                         const Geometry       &geom,
+                                         const Fluid          &hot,
+                                         const Fluid          &cold,
+                                         const FoulingParams  &fp,
+                                         const SimConfig      &baseCfg,
+                                         const MonteCarloSettings &mc,
+                                         const std::vector<double> &z,
+                                         MonteCarloControl    *control) {
+  const SimConfig cfg = trialConfig(baseCfg, mc);
+  const size_t dims = perturbedInputCount(mc);
+  const size_t n = z.size() / dims;
+  std::vector<TrialInput> inputs(n, TrialInput{op0, hot, cold, fp});
+  for (size_t i = 0; i < n; ++i) applyPerturbation(mc, &z[i * dims], inputs[i]);
+
+  MonteCarloControl localControl;
+  MonteCarloControl &ctl = control ? *control : localControl;
+  const bool batched = SimulatorBatch::supports(cfg);
+  const size_t itemSize = batched ? kLanesPerBlock : 1;
+  std::vector<State> states(n, State{});
+  auto body = [&](size_t item) {
+    const size_t begin = item * itemSize;
+    const size_t end = std::min(n, begin + itemSize);
+    long long steps = 0;
+    if (batched) {
+      runBlockBatched(inputs, begin, end, geom, cfg, mc.includeFouling, mc.solver, mc.settleTol,
+                      states, steps, ctl);
+    } else if (!halted(ctl)) {
+      states[begin] = runOneTrial(inputs[begin], geom, cfg, mc.includeFouling, mc.solver,
+                                  mc.settleTol, steps);
+      ctl.done.fetch_add(1, std::memory_order_relaxed);
+    }
+  };
+  const bool finished = parallelFor((n + itemSize - 1) / itemSize, resolveThreadCount(mc.threads),
+                                    body, &ctl.cancel) &&
+                        !halted(ctl);
+  if (!finished) states.clear();
+  return states;
+}
+
 } // namespace hx
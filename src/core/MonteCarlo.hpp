@@ -4,14 +4,28 @@
 #include "Thermo.hpp"
 #include "Hydraulics.hpp"
 #include "Fouling.hpp"
+#include "QuasiRandom.hpp"
 #include "Types.hpp"
+#include <atomic>
 #include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace hx {
 
+/** \brief How a Monte-Carlo trial turns its perturbed inputs into outputs. */
+enum class TrialSolver {
+  Steady,     // direct steady solve of the lumped balance at Rf(trialSimTime)
+  Converged,  // start from the steady solve, integrate at Rf(trialSimTime) until max |dT/dt| < settleTol
+  Dynamic,    // integrate the full trialSimTime horizon, fouling evolving
+};
+
+/** Human-readable name of a trial solver. */
+const char *trialSolverName(TrialSolver solver);
+
 /** \brief Monte-Carlo / sensitivity analysis settings.
  *
  *  Each trial perturbs a chosen subset of the plant inputs (flows, inlet
@@ -19,15 +33,52 @@ namespace hx {
  *  noise with the σ values below.  Fractional σ multiplies the nominal
  *  value; absolute σ is in kelvin for the inlet temperatures.
  *
- *  The simulator is run in a clean, disturbance-free dynamic mode for
- *  \c trialSimTime seconds (lumped, 1-cell — fast enough to do hundreds
- *  of trials interactively).
+ *  Trials use a clean, disturbance-free lumped (1-cell) model, or the
+ *  axial model with \c trialCells > 1, and report its state at
+ *  \c trialSimTime.  Without disturbances, PID or scenario
+ *  that is a steady state at the fouling level of that moment, so by
+ *  default (TrialSolver::Steady) it is solved directly instead of
+ *  integrated; Converged starts from that solve and integrates with the
+ *  fouling held at that level until the outlets settle — usually a single
+ *  step that confirms it — and Dynamic integrates the whole
+ *  horizon with \c trialDt steps while Rf grows (the original behaviour,
+ *  for outputs that depend on the transient).
+ *
+ *  \c sampling chooses how the Gaussian perturbations are drawn: i.i.d.
+ *  (plain Monte-Carlo), or a Latin-hypercube / scrambled Sobol' / shifted
+ *  Halton design over the (up to) 13 perturbed inputs mapped through Φ⁻¹.
+ *  Trials are dealt round-robin to \c replicates independent
+ *  randomisations (trial k → replicate k mod R); the spread between the
+ *  replicate estimates gives the standard errors in MonteCarloStat.  Sobol'
+ *  designs balance best when nTrials / replicates is a power of two.
  */
 struct MonteCarloSettings {
   int      nTrials      = 200;      // total MC trial count
   double   trialSimTime = 60.0;     // [s] per-trial simulated horizon
   double   trialDt      = 0.5;      // [s] per-trial time step
+  TrialSolver solver    = TrialSolver::Steady;
+  double   settleTol    = 1e-3;     // [K/s] Converged: max |dT/dt| that counts as settled
+  int      trialCells   = 1;        // axial cells of the trial model; 1 = lumped
   uint32_t seed         = 42;
+  int      threads      = 0;        // worker threads; 0 = all hardware threads
+  SamplingStrategy sampling = SamplingStrategy::MonteCarlo;
+  int      replicates   = 8;        // independent randomisations (≥ 2 for SEs)
+
+  // Variance-based sensitivity (Saltelli / Jansen Sobol' indices): base
+  // sample count N, capped at nTrials; costs N·(k+1) extra trials because
+  // the first N ensemble trials double as matrix A.  0 = skip.
+  int      sobolSamples = 64;
+  int      bootstrapResamples = 0;  // > 0: 95 % bootstrap CIs on the indices
+
+  // Keep the per-trial output vectors of MonteCarloResult (exact
+  // percentiles, CSV export).  Off: the ensemble is summarised on the fly by
+  // streaming accumulators and memory no longer grows with nTrials.
+  bool     keepTrials   = false;
+
+  // > 0: publish a partial MonteCarloResult to MonteCarloControl::snapshot()
+  // at most this often while the ensemble runs (a live view of the study),
+  // and record MonteCarloResult::convergence.
+  int      snapshotIntervalMs = 0;
 
   // Fractional σ (multiplied by nominal value)
   double frac_mhot    = 0.05;
@@ -53,17 +104,73 @@ struct MonteCarloStat {
   double p95    = 0.0;
   double minv   = 0.0;
   double maxv   = 0.0;
+  // Standard errors of the estimates above (0 when they cannot be estimated).
+  double seMean = 0.0;
+  double seP5   = 0.0;
+  double seP95  = 0.0;
+  // Histogram: bin i covers [histLo + i·histBinWidth, histLo + (i+1)·histBinWidth).
+  double                     histLo       = 0.0;
+  double                     histBinWidth = 0.0;
+  std::vector<std::uint64_t> histCounts;
 };
 
+/** \brief Tornado bar of one input, derived from its total-effect index on Q.
+ *
+ *  sensitivity = σ_Q·√S_T is the part of σ_Q the input accounts for
+ *  (interactions included); for a linear response it equals the ±1σ
+ *  one-at-a-time swing, so the bars read like the classic tornado.
+ */
 struct TornadoEntry {
   std::string name;           // human-readable parameter label
-  double deltaPlus  = 0.0;    // Q(baseline + 1σ) - Q(baseline)  [W]
-  double deltaMinus = 0.0;    // Q(baseline - 1σ) - Q(baseline)  [W]
-  double sensitivity = 0.0;   // max(|deltaPlus|, |deltaMinus|)  [W]
+  double deltaPlus  = 0.0;    // +sensitivity, signed by the input's correlation with Q  [W]
+  double deltaMinus = 0.0;    // −deltaPlus  [W]
+  double sensitivity = 0.0;   // σ_Q·√S_T  [W]
+};
+
+/** First-order and total-effect Sobol' index of one input (with 95 % CIs). */
+struct SobolIndex {
+  double first   = 0.0;       // S_i  (Saltelli 2010)
+  double total   = 0.0;       // S_Ti (Jansen 1999)
+  double firstLo = 0.0, firstHi = 0.0;   // bootstrap CI; = first without bootstrap
+  double totalLo = 0.0, totalHi = 0.0;   // bootstrap CI; = total without bootstrap
+};
+
+/** Sobol' indices of one output, one entry per perturbed input. */
+struct SobolIndices {
+  std::string             output;      // "Q", "U", "Tc_out", "dP_tube", "dP_shell"
+  double                  variance = 0.0;
+  std::vector<SobolIndex> index;       // parallel to MonteCarloResult::paramNames
+};
+
+/** Running estimate of the heat duty after the first \c trials ensemble trials. */
+struct MonteCarloConvergence {
+  int    trials  = 0;
+  double meanQ   = 0.0;
+  double seMeanQ = 0.0;
+  double p95Q    = 0.0;
+  double seP95Q  = 0.0;
 };
 
+/** \brief Outcome of runMonteCarlo().
+ *
+ *  The per-trial vectors are filled only with MonteCarloSettings::keepTrials;
+ *  the statistics (and their histograms) are always present.  Without the
+ *  vectors the percentiles come from a t-digest (well under 0.1 % rank
+ *  error at p5 / p95), mean and σ from Welford accumulators.
+ *
+ *  A \c partial result covers only the first nTrials of nTrialsPlanned
+ *  ensemble trials: a live snapshot (no per-trial vectors, no Sobol'
+ *  indices yet) or a study stopped early through MonteCarloControl::stop.
+ */
 struct MonteCarloResult {
   int                 nTrials = 0;
+  int                 nTrialsPlanned = 0;
+  bool                partial = false;
+  SamplingStrategy    sampling   = SamplingStrategy::MonteCarlo;
+  int                 replicates = 1;
+  TrialSolver         solver     = TrialSolver::Steady;
+  bool                includeFouling = false;   // the fouling asymptote was perturbed
+  double              meanSteps  = 0.0;  // time steps per trial (0 with TrialSolver::Steady)
   std::vector<double> Q;         // [W]    per-trial steady heat duty
   std::vector<double> U;         // [W/m²K]
   std::vector<double> Tc_out;    // [°C]
@@ -80,7 +187,12 @@ struct MonteCarloResult {
   MonteCarloStat statDPt;
   MonteCarloStat statDPs;
 
+  std::vector<std::string>  paramNames;  // perturbed inputs, in sampling order
+  std::vector<SobolIndices> sobol;       // Q, U, Tc_out, dP_tube, dP_shell (empty if skipped)
+  int                       sobolSamples = 0;
+  int                       bootstrapResamples = 0;
   std::vector<TornadoEntry> tornado;  // sorted descending by sensitivity
+  std::vector<MonteCarloConvergence> convergence;  // live studies; roughly geometric trial counts
   double baselineQ = 0.0;
   double baselineU = 0.0;
 
@@ -88,14 +200,73 @@ struct MonteCarloResult {
   std::string message;
 };
 
-/** Progress callback: (current, total, phase). Return false to cancel. */
+/** Progress callback: (current, total, phase). Return false to cancel.
+ *  Invoked on the thread that called runMonteCarlo(), about every 50 ms. */
 using MonteCarloProgress = std::function<bool(int, int, const char*)>;
 
-/** \brief Execute nTrials + 2·K sensitivity trials of the digital twin.
+/** \brief Progress / cancel / snapshot channel of a running study.
+ *
+ *  Readable from any thread while runMonteCarlo() runs: \c done counts
+ *  finished trials out of \c total; setting \c cancel stops the workers at
+ *  the next trial (or, in batched mode, the next few time steps) and the
+ *  study fails.  Setting \c stop halts it the same way but returns the
+ *  trials summarised so far as a partial result.  With
+ *  MonteCarloSettings::snapshotIntervalMs the study publishes partial
+ *  results; \c snapshotSerial changes with every one.
+ */
+struct MonteCarloControl {
+  std::atomic<int>  done{0};
+  std::atomic<int>  total{0};
+  std::atomic<bool> cancel{false};
+  std::atomic<bool> stop{false};
+  std::atomic<int>  snapshotSerial{0};
+
+  /** Latest published partial result; null before the first one. */
+  [[nodiscard]] std::shared_ptr<const MonteCarloResult> snapshot() const {
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    return snapshot_;
+  }
+  void publish(std::shared_ptr<const MonteCarloResult> r) {
+    {
+      std::lock_guard<std::mutex> lock(snapshotMutex_);
+      snapshot_ = std::move(r);
+    }
+    snapshotSerial.fetch_add(1, std::memory_order_release);
+  }
+
+private:
+  mutable std::mutex snapshotMutex_;
+  std::shared_ptr<const MonteCarloResult> snapshot_;
+};
+
+/** \brief Execute nTrials + N·(K+1) Sobol' sensitivity trials of the digital twin.
  *
- *  The function is self-contained: it builds a throw-away Thermo /
- *  Hydraulics / Fouling / Simulator for each trial and does not touch
- *  any live simulator.  A baseline (nominal) trial is always run first.
+ *  The function is self-contained and does not touch any live simulator.
+ *  A baseline (nominal) trial is always included.  With plain Monte-Carlo
+ *  sampling trial k draws its perturbations from PhiloxRng(mc.seed, k);
+ *  the other strategies build their whole design up front from mc.seed.
+ *  The trials are spread over mc.threads workers.  When the configuration
+ *  is inside SimulatorBatch::supports() (Custom fluids, explicit Euler)
+ *  they run in fixed blocks of lanes of a SimulatorBatch, which is
+ *  bit-identical to running them one by one when integrating (and agrees
+ *  to rounding for the steady solve); otherwise each trial gets a throw-away
+ *  Thermo / Hydraulics / Fouling / Simulator.  Either way the result is
+ *  bit-identical for every thread count.
+ *
+ *  The ensemble runs in chunks whose size depends only on nTrials; each
+ *  chunk is folded into streaming accumulators, merged in chunk order, so
+ *  snapshots, the convergence history and a stopped study all describe a
+ *  prefix of the ensemble that does not depend on the thread count.  The
+ *  baseline runs first, then the ensemble, then the Saltelli trials.
+ *
+ *  Sensitivity: the first N = mc.sobolSamples ensemble trials form the
+ *  Saltelli matrix A, an independent design of the same strategy forms B,
+ *  and the K matrices A_B^(i) (A with column i from B) are run alongside the
+ *  ensemble, so the whole study is one parallel batch.
+ *
+ *  \p control, if given, is updated as trials finish and may be cancelled
+ *  from another thread; \p progress is the polling alternative for callers
+ *  that block on this function.
  */
 MonteCarloResult runMonteCarlo(const OperatingPoint &op0,
                                const Geometry       &geom,
@@ -104,6 +275,35 @@ MonteCarloResult runMonteCarlo(const OperatingPoint &op0,
                                const FoulingParams  &fp,
                                const SimConfig      &baseCfg,
                                const MonteCarloSettings &mc,
-                               MonteCarloProgress   progress = {});
+                               MonteCarloProgress   progress = {},
+                               MonteCarloControl   *control  = nullptr);
+
+// --- Trials at chosen perturbations ------------------------------------------
+
+/** Number of standard-normal inputs a trial perturbs (12, or 13 with fouling). */
+size_t perturbedInputCount(const MonteCarloSettings &mc);
+/** Label of perturbed input \p i, in sampling order. */
+const char *perturbedInputName(size_t i);
+/** σ of perturbed input \p i: a fraction of nominal, or kelvin for the inlet temperatures. */
+double perturbedInputSigma(const MonteCarloSettings &mc, size_t i);
+
+/** \brief Outputs of the trials at caller-chosen perturbations.
+ *
+ *  Row i of \p z (perturbedInputCount(mc) standard normals, row-major)
+ *  perturbs the nominal case exactly as in runMonteCarlo(), and the trials
+ *  run on the same solver, horizon, SimulatorBatch blocks and mc.threads
+ *  workers.  For estimators that place their own samples (rare-event
+ *  studies).  Credits \p control->done per trial; returns an empty vector
+ *  when \p control is cancelled or stopped.
+ */
+std::vector<State> evaluatePerturbations(const OperatingPoint &op0,
+                                         const Geometry       &geom,
+                                         const Fluid          &hot,
+                                         const Fluid          &cold,
+                                         const FoulingParams  &fp,
+                                         const SimConfig      &baseCfg,
+                                         const MonteCarloSettings &mc,
+                                         const std::vector<double> &z,
+                                         MonteCarloControl    *control = nullptr);
 
 } // namespace hx
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "MonteCarlo.hpp"
+#include "Types.hpp"
+#include <string>
+#include <vector>
+
+namespace hx {
+
+/** \brief Multi-fidelity Monte-Carlo settings.
+ *
+ *  The high-fidelity model is the axial trial model with
+ *  \c highFidelityCells cells, the low-fidelity one the lumped trial of
+ *  runMonteCarlo().  \c budget is the total cost in high-fidelity trials;
+ *  how it is split between the models follows from the cost ratio and the
+ *  correlation measured on the pilot.
+ */
+struct MultiFidelitySettings {
+  int    highFidelityCells = 0;        // axial cells of the reference model; 0 = baseCfg.numAxialCells
+  int    pilotTrials       = 32;       // paired trials that measure correlation and cost
+  double budget            = 200.0;    // total cost, in high-fidelity trials (at least the pilot)
+  int    maxLowFidelityTrials = 1000000;
+  double costRatio         = 0.0;      // lumped / axial cost per trial; 0 = time it on the pilot
+};
+
+/** \brief Multi-fidelity estimate of one output of the high-fidelity model. */
+struct MultiFidelityStat {
+  std::string output;                  // "Q", "U", "Tc_out", "Th_out", "dP_tube", "dP_shell"
+  double mean        = 0.0;            // control-variate estimate of the axial mean
+  double stddev      = 0.0;            // control-variate estimate of the axial σ
+  double seMean      = 0.0;            // standard error of \c mean
+  double lowMean     = 0.0;            // lumped mean over every low-fidelity trial
+  double correlation = 0.0;            // ρ between the models over the paired trials
+  double weight      = 0.0;            // control-variate weight α = cov / var_lumped
+  double equivalentTrials = 0.0;       // axial-only trials with the same SE of the mean
+};
+
+/** \brief Outcome of runMultiFidelity(). */
+struct MultiFidelityResult {
+  bool        ok = false;
+  std::string message;
+
+  int    highFidelityCells  = 0;
+  int    highFidelityTrials = 0;       // n: trials run on both models
+  int    lowFidelityTrials  = 0;       // m ≥ n: lumped trials, the first n shared
+  double costRatio          = 0.0;     // lumped / axial cost per trial used for the allocation
+  double cost               = 0.0;     // n + m·costRatio, in high-fidelity trials
+
+  std::vector<MultiFidelityStat> stats;   // Q, U, Tc_out, Th_out, dP_tube, dP_shell
+};
+
+/**
+ * \brief Mean and σ of the axial-model outputs at about lumped-model cost.
+ *
+ *  Two-model multi-fidelity Monte-Carlo (Peherstorfer, Willcox & Gunzburger
+ *  2016): trial k perturbs the nominal case with the i.i.d. draws of
+ *  PhiloxRng(mc.seed, k), as plain Monte-Carlo trial k of runMonteCarlo()
+ *  does.  The first n trials run on both models, the first m ≥ n on the
+ *  lumped one, and every output is estimated as
+ *
+ *      ȳ_axial(n) + α·(ȳ_lumped(m) − ȳ_lumped(n)),
+ *
+ *  the lumped model acting as a control variate; σ is estimated the same way
+ *  from the sample variances.  Its variance is σ²/n·(1 − (1 − n/m)·ρ²), so
+ *  the ratio m/n = √(ρ²/(w·(1 − ρ²))) minimises it for the budget (w the
+ *  cost ratio); the allocation uses the least-correlated output.  α is
+ *  estimated from the same n paired trials, which leaves an O(1/n) bias.
+ *
+ *  The pilot (\c pilotTrials paired trials, and a few lumped blocks) runs on
+ *  one thread to time the models; the rest runs on mc.threads workers.  The
+ *  trial solver, horizon and perturbation σ's come from \p mc (its sampling,
+ *  Sobol' and trial-count settings are ignored).  With a measured cost
+ *  ratio n and m, and so the estimate, vary slightly from run to run; set
+ *  \c costRatio to make it reproducible.  \p control reports trials done
+ *  and may cancel.
+ */
+MultiFidelityResult runMultiFidelity(const OperatingPoint &op0,
+                                     const Geometry       &geom,
+                                     const Fluid          &hot,
+                                     const Fluid          &cold,
+                                     const FoulingParams  &fp,
+                                     const SimConfig      &baseCfg,
+                                     const MonteCarloSettings    &mc,
+                                     const MultiFidelitySettings &mf,
+                                     MonteCarloControl    *control = nullptr);
+
+} // namespace hx
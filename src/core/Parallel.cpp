@@ -0,0 +1,69 @@
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hx {
+
+unsigned resolveThreadCount(int requested) {
+  if (requested > 0) return static_cast<unsigned>(requested);
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+bool parallelFor(size_t count, unsigned threads, const std::function<void(size_t)> &body,
+                 std::atomic<bool> *cancel, const std::function<void()> &poll) {
+  auto cancelled = [cancel]() { return cancel && cancel->load(std::memory_order_relaxed); };
+  if (count == 0) return !cancelled();
+
+  const size_t nWorkers = std::max<size_t>(1, std::min<size_t>(threads, count));
+  if (nWorkers == 1 && !poll) {
+    for (size_t i = 0; i < count; ++i) {
+      if (cancelled()) return false;
+      body(i);
+    }
+    return true;
+  }
+
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> completed{0};
+  std::mutex m;
+  std::condition_variable cv;
+  size_t running = nWorkers;
+
+  auto worker = [&]() {
+    for (;;) {
+      if (cancelled()) break;
+      const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+      if (i >= count) break;
+      body(i);
+      completed.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lk(m);
+    if (--running == 0) cv.notify_all();
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(nWorkers);
+  for (size_t w = 0; w < nWorkers; ++w) pool.emplace_back(worker);
+
+  {
+    std::unique_lock<std::mutex> lk(m);
+    while (running > 0) {
+      cv.wait_for(lk, std::chrono::milliseconds(50), [&]() { return running == 0; });
+      if (poll && running > 0) {
+        lk.unlock();
+        poll();
+        lk.lock();
+      }
+    }
+  }
+  for (std::thread &t : pool) t.join();
+
+  return completed.load() == count;
+}
+
+} // namespace hx
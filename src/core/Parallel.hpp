@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+namespace hx {
+
+/** \brief Worker count for a requested thread count: \p requested if > 0, else the hardware concurrency (at least 1). */
+unsigned resolveThreadCount(int requested);
+
+/**
+ * \brief Run \p body(i) for every i in [0, count) on up to \p threads workers.
+ *
+ *  Items are claimed one at a time from a shared atomic index, so which
+ *  thread runs an item varies from run to run: a body must depend only on
+ *  its item index and write only to that item's outputs for the result to be
+ *  independent of the thread count.
+ *
+ *  Workers stop claiming items once \p cancel is set.  While they run, the
+ *  calling thread invokes \p poll about every 50 ms (it may set \p cancel);
+ *  with one thread and no \p poll the items simply run on the caller.
+ *  Returns false when cancelled before every item ran.
+ */
+bool parallelFor(size_t count, unsigned threads, const std::function<void(size_t)> &body,
+                 std::atomic<bool> *cancel = nullptr, const std::function<void()> &poll = {});
+
+} // namespace hx
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace hx {
+
+/**
+ * \brief Philox-4x32-10 counter-based generator (Salmon et al., SC'11).
+ *
+ *  The output is a pure function of (key, counter): key = \p seed, the upper
+ *  half of the counter = \p stream, the lower half counts 128-bit blocks.  A
+ *  Monte-Carlo trial that draws from PhiloxRng(seed, trialIndex) therefore
+ *  sees the same numbers no matter which thread runs it or in what order,
+ *  and streams never overlap (2^64 blocks each).
+ *
+ *  uniform() gives 53-bit doubles in [0, 1); normal() uses Box–Muller and
+ *  returns the two variates of each pair in turn.
+ */
+class PhiloxRng {
+public:
+  PhiloxRng(std::uint64_t seed, std::uint64_t stream)
+      : key_{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+        ctr_{0u, 0u, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)} {}
+
+  /** One Philox-4x32-10 block (exposed for known-answer checks). */
+  static std::array<std::uint32_t, 4> block(std::array<std::uint32_t, 4> ctr,
+                                            std::array<std::uint32_t, 2> key) {
+    constexpr std::uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+    constexpr std::uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+    for (int r = 0; r < 10; ++r) {
+      const std::uint64_t p0 = static_cast<std::uint64_t>(M0) * ctr[0];
+      const std::uint64_t p1 = static_cast<std::uint64_t>(M1) * ctr[2];
+      ctr = {static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<std::uint32_t>(p1),
+             static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<std::uint32_t>(p0)};
+      key[0] += W0;
+      key[1] += W1;
+    }
+    return ctr;
+  }
+
+  std::uint32_t nextU32() {
+    if (idx_ == 4) {
+      buf_ = block(ctr_, key_);
+      if (++ctr_[0] == 0) ++ctr_[1];
+      idx_ = 0;
+    }
+    return buf_[idx_++];
+  }
+
+  /** Uniform double in [0, 1) with 53 random bits. */
+  double uniform() {
+    const std::uint32_t a = nextU32() >> 5;  // 27 bits
+    const std::uint32_t b = nextU32() >> 6;  // 26 bits
+    return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+  }
+
+  /** Standard normal variate. */
+  double normal() {
+    if (hasSpare_) {
+      hasSpare_ = false;
+      return spare_;
+    }
+    constexpr double kTwoPi = 6.283185307179586476925;
+    const double u1 = 1.0 - uniform();  // (0, 1]: log() stays finite
+    const double u2 = uniform();
+    const double r = std::sqrt(-2.0 * std::log(u1));
+    spare_ = r * std::sin(kTwoPi * u2);
+    hasSpare_ = true;
+    return r * std::cos(kTwoPi * u2);
+  }
+
+private:
+  std::array<std::uint32_t, 2> key_;
+  std::array<std::uint32_t, 4> ctr_;
+  std::array<std::uint32_t, 4> buf_{};
+  size_t idx_ = 4;
+  double spare_ = 0.0;
+  bool hasSpare_ = false;
+};
+
+} // namespace hx
@@ -0,0 +1,189 @@
+#include "QuasiRandom.hpp"
+#include "Philox.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace hx {
+
+namespace {
+
+// Streams of the per-dimension randomisations; far away from the per-trial
+// streams 0..nTrials-1 used by plain Monte-Carlo.
+constexpr std::uint64_t kScrambleStream = 0x5C8A'0000'0000'0000ull;
+constexpr std::uint64_t kShiftStream    = 0x4A17'0000'0000'0000ull;
+
+// Joe & Kuo (2008), new-joe-kuo-6.21201, dimensions 2..13: degree s, the
+// primitive polynomial's interior coefficients a, and initial m_1..m_s.
+struct SobolPoly {
+  unsigned s;
+  unsigned a;
+  unsigned m[5];
+};
+constexpr SobolPoly kJoeKuo[SobolSampler::kMaxDims - 1] = {
+  {1, 0,  {1}},
+  {2, 1,  {1, 3}},
+  {3, 1,  {1, 3, 1}},
+  {3, 2,  {1, 1, 1}},
+  {4, 1,  {1, 1, 3, 3}},
+  {4, 4,  {1, 3, 5, 13}},
+  {5, 2,  {1, 1, 5, 5, 17}},
+  {5, 4,  {1, 1, 5, 5, 5}},
+  {5, 7,  {1, 1, 7, 11, 19}},
+  {5, 11, {1, 1, 5, 1, 1}},
+  {5, 13, {1, 1, 1, 3, 11}},
+  {5, 14, {1, 3, 5, 5, 31}},
+};
+
+constexpr unsigned kPrimes[HaltonSampler::kMaxDims] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41};
+
+std::uint32_t reverseBits(std::uint32_t x) {
+  x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+  x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+  x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+  x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+  return (x >> 16) | (x << 16);
+}
+
+// Laine–Karras style hash: on bit-reversed input it flips each bit by a
+// pseudo-random function of the bits above it — an Owen nested scramble.
+std::uint32_t nestedUniformScramble(std::uint32_t x, std::uint32_t seed) {
+  x = reverseBits(x);
+  x += seed;
+  x ^= x * 0x6c50b47cu;
+  x ^= x * 0xb82f1e52u;
+  x ^= x * 0xc7afe638u;
+  x ^= x * 0x8d22f6e6u;
+  return reverseBits(x);
+}
+
+} // anonymous namespace
+
+const char *samplingStrategyName(SamplingStrategy s) {
+  switch (s) {
+    case SamplingStrategy::LatinHypercube: return "Latin hypercube";
+    case SamplingStrategy::Sobol:          return "Sobol' (scrambled)";
+    case SamplingStrategy::Halton:         return "Halton (shifted)";
+    case SamplingStrategy::MonteCarlo:
+    default:                               return "Monte-Carlo";
+  }
+}
+
+double inverseNormalCdf(double p) {
+  // Acklam's rational approximation (|rel err| < 1.2e-9) ...
+  static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                             1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+  static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                             6.680131188771972e+01, -1.328068155288572e+01};
+  static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                             -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+  static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                             3.754408661907416e+00};
+  if (!(p > 0.0)) return -HUGE_VAL;
+  if (!(p < 1.0)) return HUGE_VAL;
+
+  constexpr double pLow = 0.02425;
+  double x;
+  if (p < pLow) {
+    const double q = std::sqrt(-2.0 * std::log(p));
+    x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+        ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+  } else if (p <= 1.0 - pLow) {
+    const double q = p - 0.5;
+    const double r = q * q;
+    x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+        (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+  } else {
+    const double q = std::sqrt(-2.0 * std::log1p(-p));
+    x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+        ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+  }
+
+  // ... polished to full double precision by one Halley step on Φ(x) − p.
+  constexpr double kSqrt2Pi = 2.50662827463100050242;
+  const double e = 0.5 * std::erfc(-x / std::sqrt(2.0)) - p;
+  const double u = e * kSqrt2Pi * std::exp(0.5 * x * x);
+  return x - u / (1.0 + 0.5 * x * u);
+}
+
+// --- Sobol' ------------------------------------------------------------------
+
+SobolSampler::SobolSampler(size_t dims, std::uint64_t seed)
+    : dims_(std::min(dims, kMaxDims)) {
+  // Dimension 0: van der Corput (all m_i = 1).
+  for (unsigned i = 0; i < 32; ++i) v_[0][i] = 1u << (31 - i);
+
+  for (size_t j = 1; j < dims_; ++j) {
+    const SobolPoly &p = kJoeKuo[j - 1];
+    std::uint32_t m[32];
+    for (unsigned i = 0; i < p.s; ++i) m[i] = p.m[i];
+    for (unsigned i = p.s; i < 32; ++i) {
+      // m_i = 2 a_1 m_{i-1} ⊕ 4 a_2 m_{i-2} ⊕ … ⊕ 2^s m_{i-s} ⊕ m_{i-s}
+      std::uint32_t mi = m[i - p.s] ^ (m[i - p.s] << p.s);
+      for (unsigned k = 1; k < p.s; ++k) {
+        if ((p.a >> (p.s - 1 - k)) & 1u) mi ^= m[i - k] << k;
+      }
+      m[i] = mi;
+    }
+    for (unsigned i = 0; i < 32; ++i) v_[j][i] = m[i] << (31 - i);
+  }
+
+  for (size_t j = 0; j < dims_; ++j) {
+    scramble_[j] = PhiloxRng(seed, kScrambleStream + j).nextU32();
+  }
+}
+
+double SobolSampler::at(std::uint32_t index, size_t dim) const {
+  std::uint32_t x = 0;
+  for (unsigned bit = 0; index != 0; ++bit, index >>= 1) {
+    if (index & 1u) x ^= v_[dim][bit];
+  }
+  x = nestedUniformScramble(x, scramble_[dim]);
+  return (static_cast<double>(x) + 0.5) * (1.0 / 4294967296.0);  // centre of the 2^-32 cell
+}
+
+// --- Halton ------------------------------------------------------------------
+
+HaltonSampler::HaltonSampler(size_t dims, std::uint64_t seed)
+    : dims_(std::min(dims, kMaxDims)) {
+  for (size_t j = 0; j < dims_; ++j) shift_[j] = PhiloxRng(seed, kShiftStream + j).uniform();
+}
+
+double HaltonSampler::at(std::uint32_t index, size_t dim) const {
+  const unsigned base = kPrimes[dim];
+  const double invBase = 1.0 / base;
+  double f = invBase;
+  double x = 0.0;
+  for (std::uint32_t i = index + 1; i != 0; i /= base) {  // skip the all-zero point
+    x += f * static_cast<double>(i % base);
+    f *= invBase;
+  }
+  x += shift_[dim];
+  if (x >= 1.0) x -= 1.0;
+  return std::clamp(x, 0x1p-53, 1.0 - 0x1p-53);
+}
+
+// --- Latin hypercube ---------------------------------------------------------
+
+std::vector<double> latinHypercube(size_t n, size_t dims, std::uint64_t seed, std::uint64_t stream) {
+  std::vector<double> out(n * dims);
+  if (n == 0) return out;
+  PhiloxRng rng(seed, stream);
+  std::vector<size_t> perm(n);
+  const double inv = 1.0 / static_cast<double>(n);
+  for (size_t j = 0; j < dims; ++j) {
+    std::iota(perm.begin(), perm.end(), size_t{0});
+    for (size_t i = n - 1; i > 0; --i) {  // Fisher–Yates
+      const size_t k = static_cast<size_t>(rng.uniform() * static_cast<double>(i + 1));
+      std::swap(perm[i], perm[std::min(k, i)]);
+    }
+    for (size_t i = 0; i < n; ++i) {
+      const double u = (static_cast<double>(perm[i]) + rng.uniform()) * inv;
+      out[i * dims + j] = std::clamp(u, 0x1p-53, 1.0 - 0x1p-53);
+    }
+  }
+  return out;
+}
+
+} // namespace hx
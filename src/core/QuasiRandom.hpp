@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hx {
+
+/** \brief How a Monte-Carlo study places its trials in the input space. */
+enum class SamplingStrategy : int {
+  MonteCarlo     = 0,  ///< i.i.d. Gaussian draws (Philox stream per trial)
+  LatinHypercube = 1,  ///< one stratum per trial in every input
+  Sobol          = 2,  ///< Owen-scrambled Sobol' sequence (Joe–Kuo directions)
+  Halton         = 3,  ///< randomly shifted Halton sequence
+};
+
+/** Display name of \p s ("Monte-Carlo", "Latin hypercube", …). */
+const char *samplingStrategyName(SamplingStrategy s);
+
+/** \brief Standard normal quantile Φ⁻¹(p) for p in (0, 1), to ~1e-15 relative. */
+double inverseNormalCdf(double p);
+
+/**
+ * \brief Owen-scrambled Sobol' points in (0, 1)^dims, dims ≤ kMaxDims.
+ *
+ *  Direction numbers are Joe & Kuo's new-joe-kuo-6.21201 set; each
+ *  dimension is scrambled with the hash-based nested uniform scramble of
+ *  Burley (2020) keyed by \p seed, so different seeds give independent
+ *  randomisations of the same low-discrepancy net.  Balance is best when
+ *  the number of points used is a power of two.
+ */
+class SobolSampler {
+public:
+  static constexpr size_t kMaxDims = 13;
+  SobolSampler(size_t dims, std::uint64_t seed);
+  [[nodiscard]] size_t dims() const { return dims_; }
+  /** Coordinate \p dim of point \p index. */
+  [[nodiscard]] double at(std::uint32_t index, size_t dim) const;
+
+private:
+  size_t dims_;
+  std::uint32_t v_[kMaxDims][32];
+  std::uint32_t scramble_[kMaxDims];
+};
+
+/**
+ * \brief Halton points in (0, 1)^dims (first primes as bases) with a random
+ *  Cranley–Patterson shift per dimension keyed by \p seed.
+ */
+class HaltonSampler {
+public:
+  static constexpr size_t kMaxDims = 13;
+  HaltonSampler(size_t dims, std::uint64_t seed);
+  [[nodiscard]] size_t dims() const { return dims_; }
+  [[nodiscard]] double at(std::uint32_t index, size_t dim) const;
+
+private:
+  size_t dims_;
+  double shift_[kMaxDims];
+};
+
+/**
+ * \brief Latin-hypercube design of \p n points in (0, 1)^dims, row-major.
+ *  Every dimension has exactly one point in each of the n equal strata,
+ *  jittered uniformly inside it; (\p seed, \p stream) select the design.
+ */
+std::vector<double> latinHypercube(size_t n, size_t dims, std::uint64_t seed, std::uint64_t stream);
+
+} // namespace hx
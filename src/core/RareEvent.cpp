@@ -0,0 +1,283 @@
+#include "RareEvent.hpp"
+#include "Philox.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <numeric>
+
+namespace hx {
+
+namespace {
+
+/** Stream of the level-0 samples; sample i draws from (seed, kLevelZeroStream + i). */
+constexpr std::uint64_t kLevelZeroStream = 0x5B5E'0000'0000'0000ull;
+/** Streams of the Markov chains: chain c of level j draws from (seed, kChainStream | j << 32 | c). */
+constexpr std::uint64_t kChainStream = 0xC4A1'0000'0000'0000ull;
+
+double outputValue(const State &s, LimitOutput output) {
+  switch (output) {
+    case LimitOutput::Q:        return s.Q;
+    case LimitOutput::U:        return s.U;
+    case LimitOutput::Tc_out:   return s.Tc_out;
+    case LimitOutput::Th_out:   return s.Th_out;
+    case LimitOutput::dP_tube:  return s.dP_tube;
+    case LimitOutput::dP_shell:
+    default:                    return s.dP_shell;
+  }
+}
+
+/**
+ * Normalised margin of \p s: the largest ±(y − t) / |t| over the
+ * conditions; > 0 means a limit is missed.  Non-finite outputs never count
+ * as failures.
+ */
+double limitMargin(const State &s, const std::vector<LimitCondition> &conditions) {
+  double g = -std::numeric_limits<double>::infinity();
+  for (const LimitCondition &c : conditions) {
+    const double y = outputValue(s, c.output);
+    if (!std::isfinite(y)) continue;
+    const double scale = std::fabs(c.threshold) > 0.0 ? std::fabs(c.threshold) : 1.0;
+    g = std::max(g, (c.above ? y - c.threshold : c.threshold - y) / scale);
+  }
+  return g;
+}
+
+/**
+ * Squared CoV of one level's estimate p from nChains chains of chainLen
+ * samples each (sample l of chain c at c·chainLen + l), failure meaning
+ * g > b.  γ accounts for the correlation along the chains (Au & Beck 2001,
+ * eq. 29); independent samples are chains of length 1.
+ */
+double levelCov2(const std::vector<double> &g, size_t nChains, size_t chainLen, double b, double p) {
+  const size_t n = nChains * chainLen;
+  if (p <= 0.0 || p >= 1.0) return 0.0;
+  double gamma = 0.0;
+  const double r0 = p * (1.0 - p);
+  for (size_t k = 1; k < chainLen; ++k) {
+    double sum = 0.0;
+    for (size_t c = 0; c < nChains; ++c) {
+      for (size_t l = 0; l + k < chainLen; ++l) {
+        sum += (g[c * chainLen + l] > b && g[c * chainLen + l + k] > b) ? 1.0 : 0.0;
+      }
+    }
+    const double rk = sum / static_cast<double>(n - k * nChains) - p * p;
+    gamma += 2.0 * (1.0 - static_cast<double>(k) / static_cast<double>(chainLen)) * rk / r0;
+  }
+  return (1.0 - p) / (static_cast<double>(n) * p) * (1.0 + std::max(0.0, gamma));
+}
+
+} // anonymous namespace
+
+const char *limitOutputName(LimitOutput output) {
+  switch (output) {
+    case LimitOutput::Q:        return "Q";
+    case LimitOutput::U:        return "U";
+    case LimitOutput::Tc_out:   return "Tc_out";
+    case LimitOutput::Th_out:   return "Th_out";
+    case LimitOutput::dP_tube:  return "dP_tube";
+    case LimitOutput::dP_shell:
+    default:                    return "dP_shell";
+  }
+}
+
+std::vector<LimitCondition> pressureDropConditions(const Limits &limits) {
+  std::vector<LimitCondition> out;
+  if (limits.dP_tube_max  > 0.0) out.push_back({LimitOutput::dP_tube,  limits.dP_tube_max,  true});
+  if (limits.dP_shell_max > 0.0) out.push_back({LimitOutput::dP_shell, limits.dP_shell_max, true});
+  return out;
+}
+
+ExceedanceResult estimateExceedance(const OperatingPoint &op0,
+                                    const Geometry       &geom,
+                                    const Fluid          &hot,
+                                    const Fluid          &cold,
+                                    const FoulingParams  &fp,
+                                    const SimConfig      &baseCfg,
+                                    const MonteCarloSettings &mc,
+                                    const ExceedanceSettings &ex,
+                                    MonteCarloControl    *control) {
+  ExceedanceResult out;
+  if (ex.conditions.empty()) {
+    out.message = "No limit conditions given.";
+    return out;
+  }
+  const double p0 = std::clamp(ex.levelProbability, 0.01, 0.5);
+  const size_t nSeeds = static_cast<size_t>(
+      std::max(1.0, std::round(p0 * static_cast<double>(std::max(ex.samplesPerLevel, 10)))));
+  const size_t chainLen = std::max<size_t>(2, static_cast<size_t>(std::round(1.0 / p0)));
+  const size_t n = nSeeds * chainLen;   // samples per level (≈ samplesPerLevel)
+  const size_t dims = perturbedInputCount(mc);
+  for (size_t i = 0; i < dims; ++i) out.paramNames.emplace_back(perturbedInputName(i));
+
+  MonteCarloControl localControl;
+  MonteCarloControl &ctl = control ? *control : localControl;
+  ctl.done.store(0);
+  ctl.total.store(static_cast<int>(2 * n));
+
+  auto evaluate = [&](const std::vector<double> &z, std::vector<double> &g) {
+    const std::vector<State> states =
+        evaluatePerturbations(op0, geom, hot, cold, fp, baseCfg, mc, z, &ctl);
+    if (states.empty()) return false;
+    g.resize(states.size());
+    for (size_t i = 0; i < states.size(); ++i) g[i] = limitMargin(states[i], ex.conditions);
+    out.trials += static_cast<int>(states.size());
+    return true;
+  };
+
+  // The most probable failure sample seen so far.
+  double bestNorm2 = std::numeric_limits<double>::infinity();
+  auto noteFailures = [&](const std::vector<double> &z, const std::vector<double> &g) {
+    for (size_t i = 0; i < g.size(); ++i) {
+      if (!(g[i] > 0.0)) continue;
+      double r2 = 0.0;
+      for (size_t d = 0; d < dims; ++d) r2 += z[i * dims + d] * z[i * dims + d];
+      if (r2 < bestNorm2) {
+        bestNorm2 = r2;
+        out.designPoint.assign(&z[i * dims], &z[i * dims] + dims);
+      }
+    }
+  };
+
+  // === Level 0: plain Monte-Carlo, i.i.d. samples (chains of length 1) ===
+  std::vector<double> z(n * dims), g;
+  for (size_t i = 0; i < n; ++i) {
+    PhiloxRng rng(mc.seed, kLevelZeroStream + i);
+    for (size_t d = 0; d < dims; ++d) z[i * dims + d] = rng.normal();
+  }
+  if (!evaluate(z, g)) {
+    out.message = "Cancelled.";
+    return out;
+  }
+  noteFailures(z, g);
+  size_t nChains = n;
+  size_t levelLen = 1;
+
+  double logP = 0.0;     // log of the product of the finished levels' probabilities
+  double cov2 = 0.0;     // Σ δ_j², levels uncorrelated
+  double covSum = 0.0;   // Σ δ_j, levels fully correlated
+  std::vector<size_t> order(n);
+  std::vector<double> seedZ(nSeeds * dims), seedG(nSeeds);
+  for (int level = 0;; ++level) {
+    // Threshold b of the next level: midway between the nSeeds-th and the
+    // next sample in descending margin, so exactly nSeeds lie above it.
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(nSeeds + 1),
+                      order.end(), [&](size_t a, size_t b) { return g[a] > g[b]; });
+    const double b = 0.5 * (g[order[nSeeds - 1]] + g[order[nSeeds]]);
+    const bool last = b >= 0.0 || level == ex.maxLevels || !std::isfinite(b);
+    if (last) {
+      size_t failures = 0;
+      for (double x : g) failures += x > 0.0 ? 1 : 0;
+      const double p = static_cast<double>(failures) / static_cast<double>(n);
+      const double d2 = levelCov2(g, nChains, levelLen, 0.0, p);
+      cov2 += d2;
+      covSum += std::sqrt(d2);
+      out.levels = level;
+      out.probability = failures > 0 ? std::exp(logP) * p : 0.0;
+      break;
+    }
+    {
+      const double d2 = levelCov2(g, nChains, levelLen, b, p0);
+      cov2 += d2;
+      covSum += std::sqrt(d2);
+    }
+    logP += std::log(static_cast<double>(nSeeds) / static_cast<double>(n));
+    out.thresholds.push_back(b);
+
+    // === Conditional level: nSeeds chains from the samples above b ===
+    // Adaptive conditional sampling: component k moves as
+    //   v_k = ρ_k·z_k + σ_k·ξ_k,  σ_k = min(1, λ·s_k),  ρ_k = √(1 − σ_k²),
+    // which leaves the standard normal invariant, so a candidate is accepted
+    // exactly when it stays above b.  s_k is the seeds' spread; λ is tuned
+    // after every lock-step towards the target acceptance rate.
+    for (size_t c = 0; c < nSeeds; ++c) {
+      std::copy(&z[order[c] * dims], &z[order[c] * dims] + dims, &seedZ[c * dims]);
+      seedG[c] = g[order[c]];
+    }
+    std::vector<double> spread(dims, 0.0);
+    for (size_t d = 0; d < dims; ++d) {
+      double mean = 0.0, m2 = 0.0;
+      for (size_t c = 0; c < nSeeds; ++c) mean += seedZ[c * dims + d];
+      mean /= static_cast<double>(nSeeds);
+      for (size_t c = 0; c < nSeeds; ++c) m2 += (seedZ[c * dims + d] - mean) * (seedZ[c * dims + d] - mean);
+      spread[d] = nSeeds > 1 ? std::sqrt(m2 / static_cast<double>(nSeeds - 1)) : 1.0;
+    }
+
+    ctl.total.store(static_cast<int>(static_cast<size_t>(level + 3) * n));
+    std::vector<PhiloxRng> rngs;
+    rngs.reserve(nSeeds);
+    for (size_t c = 0; c < nSeeds; ++c) {
+      rngs.emplace_back(mc.seed, kChainStream | static_cast<std::uint64_t>(level + 1) << 32 | c);
+    }
+    std::vector<double> chainZ(n * dims), chainG(n);
+    for (size_t c = 0; c < nSeeds; ++c) {
+      std::copy(&seedZ[c * dims], &seedZ[c * dims] + dims, &chainZ[c * chainLen * dims]);
+      chainG[c * chainLen] = seedG[c];
+    }
+    double lambda = 0.6;
+    size_t accepted = 0;
+    std::vector<double> cand(nSeeds * dims), candG, sigma(dims), rho(dims);
+    for (size_t l = 1; l < chainLen; ++l) {
+      for (size_t d = 0; d < dims; ++d) {
+        sigma[d] = std::min(1.0, lambda * spread[d]);
+        rho[d] = std::sqrt(1.0 - sigma[d] * sigma[d]);
+      }
+      for (size_t c = 0; c < nSeeds; ++c) {
+        const double *cur = &chainZ[(c * chainLen + l - 1) * dims];
+        for (size_t d = 0; d < dims; ++d) {
+          cand[c * dims + d] = rho[d] * cur[d] + sigma[d] * rngs[c].normal();
+        }
+      }
+      if (!evaluate(cand, candG)) {
+        out.message = "Cancelled.";
+        return out;
+      }
+      noteFailures(cand, candG);
+      size_t stepAccepted = 0;
+      for (size_t c = 0; c < nSeeds; ++c) {
+        const size_t prev = c * chainLen + l - 1;
+        const size_t next = prev + 1;
+        const bool accept = candG[c] > b;
+        const double *src = accept ? &cand[c * dims] : &chainZ[prev * dims];
+        std::copy(src, src + dims, &chainZ[next * dims]);
+        chainG[next] = accept ? candG[c] : chainG[prev];
+        stepAccepted += accept ? 1 : 0;
+      }
+      accepted += stepAccepted;
+      const double rate = static_cast<double>(stepAccepted) / static_cast<double>(nSeeds);
+      lambda *= std::exp((rate - ex.targetAcceptance) / std::sqrt(static_cast<double>(l)));
+    }
+    out.acceptance.push_back(static_cast<double>(accepted) /
+                             static_cast<double>(nSeeds * (chainLen - 1)));
+    z.swap(chainZ);
+    g.swap(chainG);
+    nChains = nSeeds;
+    levelLen = chainLen;
+  }
+
+  out.cov = std::sqrt(cov2);
+  out.covUpper = covSum;
+  out.ok = true;
+  char buf[320];
+  if (out.probability > 0.0) {
+    out.equivalentTrials = (1.0 - out.probability) / (out.probability * covSum * covSum);
+    std::snprintf(buf, sizeof(buf),
+                  "P(limit missed) = %.3g (CoV %.2f, at most %.2f) from %d trials over %d "
+                  "conditional level(s); plain Monte-Carlo needs at least %.3g trials for "
+                  "that CoV.",
+                  out.probability, out.cov, out.covUpper, out.trials, out.levels,
+                  out.equivalentTrials);
+  } else {
+    std::snprintf(buf, sizeof(buf),
+                  "No limit was missed in %d trials over %d conditional level(s): "
+                  "P(limit missed) is below about %.1g.",
+                  out.trials, out.levels,
+                  std::exp(logP) / static_cast<double>(n));
+  }
+  out.message = buf;
+  return out;
+}
+
+} // namespace hx
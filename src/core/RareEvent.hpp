@@ -0,0 +1,98 @@
+#pragma once
+
+#include "MonteCarlo.hpp"
+#include "Types.hpp"
+#include <string>
+#include <vector>
+
+namespace hx {
+
+/** \brief Trial output a limit condition watches. */
+enum class LimitOutput { Q, U, Tc_out, Th_out, dP_tube, dP_shell };
+
+/** Short name of a limit output ("dP_shell", ...). */
+const char *limitOutputName(LimitOutput output);
+
+/** \brief One way to miss a limit: an output above (or below) a threshold. */
+struct LimitCondition {
+  LimitOutput output    = LimitOutput::dP_shell;
+  double      threshold = 0.0;
+  bool        above     = true;   // failure when output > threshold; false: output < threshold
+};
+
+/** Conditions for the pressure-drop limits of \p limits (the ones that are set, > 0). */
+std::vector<LimitCondition> pressureDropConditions(const Limits &limits);
+
+/** \brief Subset-simulation settings.
+ *
+ *  Level 0 is plain Monte-Carlo with \c samplesPerLevel trials.  Every
+ *  further level keeps the fraction \c levelProbability of samples closest
+ *  to failure as seeds and grows Markov chains from them, conditioned on
+ *  staying at least that close, until a level reaches the limit itself.  A
+ *  probability P = p0^m then costs about N·(1 + (1 − p0)·(m − 1)) trials.
+ */
+struct ExceedanceSettings {
+  std::vector<LimitCondition> conditions;   // failure: any condition met
+  int    samplesPerLevel  = 1000;           // N
+  double levelProbability = 0.1;            // p0, the conditional probability of each level
+  int    maxLevels        = 10;             // conditional levels; resolves P down to ~p0^maxLevels
+  double targetAcceptance = 0.44;           // of the adaptive conditional-sampling proposals
+};
+
+/** \brief Outcome of estimateExceedance().
+ *
+ *  \c cov is the coefficient of variation of \c probability in Au & Beck's
+ *  estimate: correlation along the Markov chains included, levels assumed
+ *  uncorrelated, which understates it (0.29 against 0.39 observed at
+ *  P = 1e-4, N = 1000).  \c covUpper treats the levels as fully correlated
+ *  and bounds it from above.  \c equivalentTrials, (1 − P) / (P·covUpper²),
+ *  is the smallest plain Monte-Carlo run that would match it.
+ */
+struct ExceedanceResult {
+  bool        ok = false;
+  std::string message;
+
+  double probability      = 0.0;
+  double cov              = 0.0;
+  double covUpper         = 0.0;
+  double equivalentTrials = 0.0;
+  int    trials           = 0;     // model evaluations
+  int    levels           = 0;     // conditional levels run (0: level 0 settled it)
+
+  // Per conditional level: threshold of the normalised margin (ascending
+  // towards 0, the limit) and the acceptance rate of its Markov chains.
+  std::vector<double> thresholds;
+  std::vector<double> acceptance;
+
+  // Most probable failure sample found (smallest |z|), in σ per input.
+  std::vector<double>      designPoint;
+  std::vector<std::string> paramNames;
+};
+
+/**
+ * \brief Probability that a trial misses any of \p ex.conditions.
+ *
+ *  Subset simulation (Au & Beck 2001) in the standard-normal space of the
+ *  runMonteCarlo() perturbation model, with adaptive conditional sampling
+ *  (Papaioannou et al. 2015) for the Markov chains.  Conditions are compared
+ *  through the normalised margin max_c ±(y_c − t_c) / |t_c|, so mixed
+ *  failure modes (ΔP and Tc,out, say) form one limit state.
+ *
+ *  Trials use the perturbation σ's, solver, horizon and thread count of
+ *  \p mc (its sampling / Sobol' settings are ignored) and run through
+ *  evaluatePerturbations(), the chains of a level in lock-step.  Sample
+ *  draws come from Philox streams keyed by mc.seed and the level, so the
+ *  result does not depend on the thread count.  \p control reports trials
+ *  done and may cancel.
+ */
+ExceedanceResult estimateExceedance(const OperatingPoint &op0,
+                                    const Geometry       &geom,
+                                    const Fluid          &hot,
+                                    const Fluid          &cold,
+                                    const FoulingParams  &fp,
+                                    const SimConfig      &baseCfg,
+                                    const MonteCarloSettings &mc,
+                                    const ExceedanceSettings &ex,
+                                    MonteCarloControl    *control = nullptr);
+
+} // namespace hx
@@ -156,6 +156,36 @@ RunRecord RunLog::makeRecord(const SimConfig      &cfg,
 
 qint64 RunLog::saveRun(const RunRecord              &rec,
                         const std::vector<RunSample> &samples) {
+  return insertRun(rec, [&samples](const std::function<bool(const RunSample &)> &put) {
+    for (const auto &s : samples) {
+      if (!put(s)) return false;
+    }
+    return true;
+  });
+}
+
+qint64 RunLog::saveRun(const RunRecord &rec, const TraceRecorder &trace) {
+  return insertRun(rec, [&trace](const std::function<bool(const RunSample &)> &put) {
+    bool ok = true;
+    trace.forEach([&](double t, const State &s) {
+      if (!ok) return;
+      RunSample rs;
+      rs.t        = t;
+      rs.Tc_out   = s.Tc_out;
+      rs.Th_out   = s.Th_out;
+      rs.Q        = s.Q;
+      rs.U        = s.U;
+      rs.Rf       = s.Rf;
+      rs.dP_tube  = s.dP_tube;
+      rs.dP_shell = s.dP_shell;
+      rs.pid_cmd  = s.pidColdFlow;        // NaN when PID disabled
+      ok = put(rs);
+    });
+    return ok;
+  });
+}
+
+qint64 RunLog::insertRun(const RunRecord &rec, const SampleSource &samples) {
   if (!schemaReady_) return -1;
 
   QSqlQuery q(db_);
@@ -214,7 +244,7 @@ qint64 RunLog::saveRun(const RunRecord              &rec,
   q.prepare(QStringLiteral(
       "INSERT INTO samples (run_id, t, Tc_out, Th_out, Q, U, Rf, dP_tube, dP_shell, pid_cmd) "
       "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"));
-  for (const auto &s : samples) {
+  const bool samplesOk = samples([&](const RunSample &s) {
     q.bindValue(0, runId);
     q.bindValue(1, s.t);
     q.bindValue(2, s.Tc_out);
@@ -227,9 +257,13 @@ qint64 RunLog::saveRun(const RunRecord              &rec,
     q.bindValue(9, s.pid_cmd);
     if (!q.exec()) {
       qWarning() << "[RunLog] sample insert failed:" << q.lastError().text();
-      db_.rollback();
-      return -1;
+      return false;
     }
+    return true;
+  });
+  if (!samplesOk) {
+    db_.rollback();
+    return -1;
   }
 
   if (!db_.commit()) {
@@ -3,10 +3,12 @@
 #include <QString>
 #include <QDateTime>
 #include <QSqlDatabase>
+#include <functional>
 #include <vector>
 
 #include "core/Types.hpp"
 #include "core/Simulator.hpp"
+#include "core/TraceRecorder.hpp"
 
 namespace hx {
 
@@ -80,6 +82,8 @@ public:
   /** Persist one run + all its samples.  Returns the new row id (or -1). */
   qint64 saveRun(const RunRecord               &rec,
                   const std::vector<RunSample> &samples);
+  /** Same, streaming the samples from a recorder chunk by chunk (no full copy). */
+  qint64 saveRun(const RunRecord &rec, const TraceRecorder &trace);
 
   /** Fetch all runs, most recent first. */
   std::vector<RunRecord> listRuns();
@@ -114,6 +118,10 @@ private:
 
   bool ensureSchema();
 
+  /** Calls its argument once per sample, in order; false as soon as a call fails. */
+  using SampleSource = std::function<bool(const std::function<bool(const RunSample &)> &)>;
+  qint64 insertRun(const RunRecord &rec, const SampleSource &samples);
+
   QSqlDatabase db_;
   QString      dbPath_;
   bool         schemaReady_{false};
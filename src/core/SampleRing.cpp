@@ -0,0 +1,100 @@
+#include "SampleRing.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace hx {
+
+namespace {
+
+size_t roundUpPow2(size_t n) {
+  size_t p = 2;
+  while (p < n) p <<= 1;
+  return p;
+}
+
+// Back-off while the consumer (a ~60 Hz GUI timer) catches up.
+void waitForConsumer() { std::this_thread::sleep_for(std::chrono::microseconds(200)); }
+
+} // anonymous namespace
+
+SampleRing::SampleRing(size_t capacity, OverflowPolicy policy)
+    : slots_(roundUpPow2(capacity)), mask_(slots_.size() - 1), policy_(policy) {}
+
+bool SampleRing::tryEnqueue(const SampleRecord &rec) {
+  const size_t head = head_.load(std::memory_order_relaxed);
+  if (head - tailCache_ >= slots_.size()) {
+    tailCache_ = tail_.load(std::memory_order_acquire);
+    if (head - tailCache_ >= slots_.size()) return false;
+  }
+  SampleRecord &slot = slots_[head & mask_];
+  slot = rec;
+  head_.store(head + 1, std::memory_order_release);
+  pushed_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool SampleRing::push(const SampleRecord &rec) {
+  if (closed()) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  switch (policy_) {
+    case OverflowPolicy::Drop:
+      if (tryEnqueue(rec)) return true;
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+
+    case OverflowPolicy::Decimate:
+      // The held-back sample goes first so records stay in time order.
+      if (hasPending_) {
+        if (!tryEnqueue(pending_)) {
+          pending_ = rec;
+          coalesced_.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+        hasPending_ = false;
+      }
+      if (!tryEnqueue(rec)) {
+        pending_ = rec;
+        hasPending_ = true;
+      }
+      return true;
+
+    case OverflowPolicy::Block:
+    default:
+      while (!tryEnqueue(rec)) {
+        if (closed()) {
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+        waitForConsumer();
+      }
+      return true;
+  }
+}
+
+void SampleRing::flush() {
+  while (hasPending_) {
+    if (tryEnqueue(pending_)) {
+      hasPending_ = false;
+    } else if (closed()) {
+      hasPending_ = false;
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      waitForConsumer();
+    }
+  }
+}
+
+SampleRingStats SampleRing::stats() const {
+  SampleRingStats s;
+  s.pushed    = pushed_.load(std::memory_order_relaxed);
+  s.drained   = drained_.load(std::memory_order_relaxed);
+  s.dropped   = dropped_.load(std::memory_order_relaxed);
+  s.coalesced = coalesced_.load(std::memory_order_relaxed);
+  return s;
+}
+
+} // namespace hx
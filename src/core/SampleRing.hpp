@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Types.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hx {
+
+/** \brief One simulator sample as it crosses the worker → UI boundary. */
+struct SampleRecord {
+  double t = 0.0;
+  State state{};
+};
+
+/** \brief What SampleRing::push() does when the consumer has fallen behind. */
+enum class OverflowPolicy : int {
+  Drop = 0,      ///< discard the new sample (counted as dropped)
+  Decimate = 1,  ///< hold back the newest sample, replacing it until a slot frees (counted as coalesced)
+  Block = 2,     ///< wait for the consumer; the simulator runs at the drain rate
+};
+
+/** \brief Counters of a SampleRing (monotonic over its lifetime). */
+struct SampleRingStats {
+  std::uint64_t pushed = 0;     // records that entered the ring
+  std::uint64_t drained = 0;    // records handed to the consumer
+  std::uint64_t dropped = 0;    // lost under OverflowPolicy::Drop (or after close())
+  std::uint64_t coalesced = 0;  // superseded by a newer sample under OverflowPolicy::Decimate
+};
+
+/**
+ * \brief Bounded single-producer / single-consumer queue of SampleRecords.
+ *
+ *  Lock-free and allocation-free after construction: the producer (the
+ *  simulation thread) publishes with a release store of its write index, the
+ *  consumer (the GUI, once per frame) reads with an acquire load, and each
+ *  side keeps a cached copy of the other's index so the shared cache lines
+ *  are only touched when the ring looks full / empty.
+ *
+ *  push(), flush() belong to the producer thread; drain() to the consumer.
+ *  close(), stats() and the policy are safe from either.
+ */
+class SampleRing {
+public:
+  /** \p capacity is rounded up to a power of two (minimum 2). */
+  explicit SampleRing(size_t capacity = 8192, OverflowPolicy policy = OverflowPolicy::Decimate);
+
+  SampleRing(const SampleRing &) = delete;
+  SampleRing &operator=(const SampleRing &) = delete;
+
+  [[nodiscard]] size_t capacity() const { return slots_.size(); }
+  [[nodiscard]] OverflowPolicy policy() const { return policy_; }
+
+  // --- Producer ----------------------------------------------------------------
+  /** Enqueue one record, applying the overflow policy; false if it was dropped. */
+  bool push(const SampleRecord &rec);
+  /** Deliver a held-back Decimate sample, waiting for a slot unless the ring is closed. */
+  void flush();
+
+  // --- Consumer ----------------------------------------------------------------
+  /** Hand up to \p maxRecords queued records, oldest first, to \p fn. */
+  template <class F>
+  size_t drain(F &&fn, size_t maxRecords = static_cast<size_t>(-1)) {
+    const size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t n = std::min(head - tail, maxRecords);
+    for (size_t i = 0; i < n; ++i, ++tail) fn(slots_[tail & mask_]);
+    tail_.store(tail, std::memory_order_release);
+    drained_.fetch_add(n, std::memory_order_relaxed);
+    return n;
+  }
+  [[nodiscard]] size_t size() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  /** Stop accepting records and release a producer blocked in push() / flush(). */
+  void close() { closed_.store(true, std::memory_order_release); }
+  [[nodiscard]] bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+  [[nodiscard]] SampleRingStats stats() const;
+
+private:
+  bool tryEnqueue(const SampleRecord &rec);
+
+  std::vector<SampleRecord> slots_;
+  size_t mask_ = 0;
+  OverflowPolicy policy_;
+
+  // Producer-owned.
+  alignas(64) std::atomic<size_t> head_{0};
+  size_t tailCache_ = 0;
+  SampleRecord pending_{};
+  bool hasPending_ = false;
+
+  // Consumer-owned.
+  alignas(64) std::atomic<size_t> tail_{0};
+
+  alignas(64) std::atomic<std::uint64_t> pushed_{0};
+  std::atomic<std::uint64_t> drained_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<std::uint64_t> coalesced_{0};
+  std::atomic<bool> closed_{false};
+};
+
+} // namespace hx
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+namespace hx {
+
+/**
+ * \brief Scalar helpers for the correlations templated on their number type.
+ *
+ *  The correlations run on double and on forward-mode AD types (hx::Dual,
+ *  Eigen::AutoDiffScalar).  std::max / std::min / std::clamp need both
+ *  arguments of one type and std::cbrt has no AD overload, so the templates
+ *  use these instead; every helper makes the same comparison, in the same
+ *  order, as the std function it replaces, so double results are unchanged.
+ *  Math functions are called unqualified after `using std::exp;` etc. so
+ *  argument-dependent lookup finds the AD overloads.
+ */
+
+/** Value part of \p x: x itself for double, x.value() for AD types. */
+inline double valueOf(double x) { return x; }
+template <class T>
+auto valueOf(const T &x) -> decltype(x.value()) {
+  return x.value();
+}
+
+/** std::max(a, b) for mixed scalar / double arguments. */
+template <class A, class B>
+std::common_type_t<A, B> maxOf(const A &a, const B &b) {
+  using R = std::common_type_t<A, B>;
+  return (a < b) ? R(b) : R(a);
+}
+
+/** std::min(a, b) for mixed scalar / double arguments. */
+template <class A, class B>
+std::common_type_t<A, B> minOf(const A &a, const B &b) {
+  using R = std::common_type_t<A, B>;
+  return (b < a) ? R(b) : R(a);
+}
+
+/** std::clamp(v, lo, hi) with constant bounds. */
+template <class T>
+T clampTo(const T &v, double lo, double hi) {
+  return (v < lo) ? T(lo) : (hi < v) ? T(hi) : v;
+}
+
+/** Cube root: std::cbrt for double, x^(1/3) for AD types (x ≥ 0; zero slope at 0). */
+inline double cbrtOf(double x) { return std::cbrt(x); }
+template <class T>
+T cbrtOf(const T &x) {
+  using std::pow;
+  if (!(x > 0.0)) return T(0.0);
+  return pow(x, 1.0 / 3.0);
+}
+
+} // namespace hx
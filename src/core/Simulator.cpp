@@ -1,9 +1,12 @@
 #include "Simulator.hpp"
 
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <algorithm>
 
+#include <Eigen/Dense>
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -11,14 +14,47 @@
 namespace hx {
 
 Simulator::Simulator(Thermo &thermo, const Hydraulics &hydro, const Fouling &foul, const SimConfig &cfg)
-    : thermo_(thermo), hydro_(hydro), foul_(foul), cfg_(cfg) {}
+    : thermo_(thermo), hydro_(hydro), foul_(foul), cfg_(cfg), htMemo_(thermo) {
+  auto resolve = [&](const std::shared_ptr<const FluidPropertyTable> &user, FluidPreset preset) {
+    if (user && !user->empty()) return user.get();
+    return cfg_.tabulatedFluids ? FluidPropertyTable::forPreset(preset) : nullptr;
+  };
+  hotTable_  = resolve(cfg_.hotTable,  cfg_.hotPreset);
+  coldTable_ = resolve(cfg_.coldTable, cfg_.coldPreset);
+  hotVariable_  = hotTable_  || cfg_.hotPreset  != FluidPreset::Custom;
+  coldVariable_ = coldTable_ || cfg_.coldPreset != FluidPreset::Custom;
+}
+
+// Re-evaluate ρ/μ/cₚ/k at the mean film temperatures of each variable side.
+void Simulator::updateFluidProperties(double ThMean, double TcMean) {
+  if (hotVariable_) {
+    thermo_.setHot(hotTable_ ? hotTable_->lookup(ThMean)
+                             : evaluateFluid(cfg_.hotPreset, ThMean, cfg_.hotCustom));
+  }
+  if (coldVariable_) {
+    thermo_.setCold(coldTable_ ? coldTable_->lookup(TcMean)
+                               : evaluateFluid(cfg_.coldPreset, TcMean, cfg_.coldCustom));
+  }
+}
+
+double Simulator::overallU(const OperatingPoint &op, double Rf_shell, double Rf_tube, double k_deposit) {
+  return htMemo_.U(op.m_dot_hot, op.m_dot_cold, Rf_shell, Rf_tube, k_deposit);
+}
+
+double Simulator::shellPressureDrop(double m_dot_cold, double Rf_shell, double k_deposit) const {
+  double dP = 0.0;
+  if (shareShellSide_ && htMemo_.shellPressureDrop(m_dot_cold, Rf_shell, k_deposit, dP)) return dP;
+  return hydro_.dP_shell(m_dot_cold, Rf_shell, k_deposit, thermo_.geometry().K_turns_shell);
+}
 
 void Simulator::setSteadyStateMode(bool enabled) {
   steadyStateMode_ = enabled;
+  rk_.valid = false;
 }
 
 void Simulator::setFoulingEnabled(bool enabled) {
   foulingEnabled_ = enabled;
+  rk_.valid = false;
   if (!foulingEnabled_) {
     state_.Rf = 0.0;
   }
@@ -74,6 +110,7 @@ void Simulator::initAxialProfile() {
   const int N = std::max(1, cfg_.numAxialCells);
   Th_cell_.assign(static_cast<size_t>(N), 0.0);
   Tc_cell_.assign(static_cast<size_t>(N), 0.0);
+  axialWork_.assign(static_cast<size_t>(4 * N), 0.0);
 
   // Seed with a linear interpolation between inlet and steady outlet for each
   // side.  This gives the UI a textbook-looking profile on the very first
@@ -96,22 +133,24 @@ void Simulator::initAxialProfile() {
       Tc_cell_[static_cast<size_t>(i)] = TcIn + (TcOut - TcIn) * xi;
     }
   }
-
-  state_.Th_axial = Th_cell_;
-  state_.Tc_axial = Tc_cell_;
 }
 
 void Simulator::reset(const OperatingPoint &op0) {
   op_ = op0;
+  const Fluid &tc = thermo_.cold(), &hc = hydro_.cold();
+  shareShellSide_ = thermo_.shellMethod() == ShellSideMethod::BellDelaware &&
+                    hydro_.shellMethod() == ShellSideMethod::BellDelaware && !coldVariable_ &&
+                    tc.rho == hc.rho && tc.mu == hc.mu && tc.cp == hc.cp && tc.k == hc.k;
+  htMemo_.invalidate();
   // Pass k_deposit to steady state calculation
   state_ = thermo_.steady(op_, 0.0, 0.0, foul_.params().k_deposit, cfg_.arrangement);
   // Initialize with small deterministic perturbations for consistency
   state_.Tc_out += 0.1; // +0.1°C initial variation
   state_.Th_out -= 0.1; // -0.1°C initial variation
 
-  // (Re)allocate PID controller with current gains.
+  // (Re)create PID controller with current gains.
   if (cfg_.pid.enabled) {
-    pid_ = std::make_unique<ControllerPID>(
+    pid_.emplace(
         cfg_.pid.kp, cfg_.pid.ki, cfg_.pid.kd,
         cfg_.pid.u_min, cfg_.pid.u_max, cfg_.pid.rate_limit);
     state_.pidSetpoint = cfg_.pid.setpoint_Tc_out;
@@ -137,13 +176,14 @@ void Simulator::reset(const OperatingPoint &op0) {
     state_.pidColdFlowActual = std::numeric_limits<double>::quiet_NaN();
   }
 
+  rk_ = LumpedRK{};
+  rkStats_ = IntegratorStats{};
+
   if (cfg_.numAxialCells > 1) {
     initAxialProfile();
   } else {
     Th_cell_.clear();
     Tc_cell_.clear();
-    state_.Th_axial.clear();
-    state_.Tc_axial.clear();
   }
 }
 
@@ -167,7 +207,7 @@ void Simulator::applyScenarioEvents(double t) {
       case ScenarioEvent::Action::SetPidEnabled:
         cfg_.pid.enabled = ev.boolValue;
         if (ev.boolValue && !pid_) {
-          pid_ = std::make_unique<ControllerPID>(
+          pid_.emplace(
               cfg_.pid.kp, cfg_.pid.ki, cfg_.pid.kd,
               cfg_.pid.u_min, cfg_.pid.u_max, cfg_.pid.rate_limit);
           state_.pidSetpoint = cfg_.pid.setpoint_Tc_out;
@@ -187,6 +227,7 @@ void Simulator::applyScenarioEvents(double t) {
         break;
     }
     ev.fired = true;
+    rk_.valid = false;
   }
 }
 
@@ -197,16 +238,10 @@ const State &Simulator::step(double t) {
   // of the step sees the updated operating point / controller state.
   applyScenarioEvents(t);
 
-  // Update temperature-dependent fluid properties if either side uses a preset.
-  // Mean film temperature = ((T_in + T_out) / 2).
-  if (cfg_.hotPreset != FluidPreset::Custom) {
-    const double Tmean = 0.5 * (op_.Tin_hot + state_.Th_out);
-    thermo_.setHot(evaluateFluid(cfg_.hotPreset, Tmean, cfg_.hotCustom));
-  }
-  if (cfg_.coldPreset != FluidPreset::Custom) {
-    const double Tmean = 0.5 * (op_.Tin_cold + state_.Tc_out);
-    thermo_.setCold(evaluateFluid(cfg_.coldPreset, Tmean, cfg_.coldCustom));
-  }
+  // Update temperature-dependent fluid properties if either side uses a preset
+  // or a user table.  Mean film temperature = ((T_in + T_out) / 2).
+  updateFluidProperties(0.5 * (op_.Tin_hot + state_.Th_out),
+                        0.5 * (op_.Tin_cold + state_.Tc_out));
 
   if (cfg_.numAxialCells > 1) {
     stepAxial(t, dt);
@@ -217,25 +252,11 @@ const State &Simulator::step(double t) {
 }
 
 // -----------------------------------------------------------------------------
-// Legacy lumped-parameter path (two ODEs, single hot/cold outlet temperature).
-// Kept intact so the widget/KPI code doesn't regress and to serve as a baseline
-// to compare against the finite-volume model in the report.
+// Inlet disturbance profile applied on top of the nominal operating point.
+// A pure function of t, so the adaptive integrator can sample it at any
+// stage time.
 // -----------------------------------------------------------------------------
-void Simulator::stepLumped(double t, double dt) {
-  double Rf_shell = 0.0;
-  double Rf_tube = 0.0;
-  const double k_deposit = foul_.params().k_deposit;
-  const double split_ratio = foul_.params().split_ratio;
-
-  if (foulingEnabled_) {
-    state_.Rf = foul_.Rf(t);
-    state_.Rf = std::max(0.0, std::min(state_.Rf, 0.01));
-    Rf_shell = state_.Rf * split_ratio;
-    Rf_tube = state_.Rf * (1.0 - split_ratio);
-  } else {
-    state_.Rf = 0.0;
-  }
-
+OperatingPoint Simulator::disturbedOperatingPoint(double t) const {
   OperatingPoint dynamic_op = op_;
   if (!steadyStateMode_) {
     switch (cfg_.disturbanceType) {
@@ -266,6 +287,30 @@ void Simulator::stepLumped(double t, double dt) {
         break;
     }
   }
+  return dynamic_op;
+}
+
+// -----------------------------------------------------------------------------
+// Legacy lumped-parameter path (two ODEs, single hot/cold outlet temperature).
+// Kept intact so the widget/KPI code doesn't regress and to serve as a baseline
+// to compare against the finite-volume model in the report.
+// -----------------------------------------------------------------------------
+void Simulator::stepLumped(double t, double dt) {
+  double Rf_shell = 0.0;
+  double Rf_tube = 0.0;
+  const double k_deposit = foul_.params().k_deposit;
+  const double split_ratio = foul_.params().split_ratio;
+
+  if (foulingEnabled_) {
+    state_.Rf = foul_.Rf(t);
+    state_.Rf = std::max(0.0, std::min(state_.Rf, 0.01));
+    Rf_shell = state_.Rf * split_ratio;
+    Rf_tube = state_.Rf * (1.0 - split_ratio);
+  } else {
+    state_.Rf = 0.0;
+  }
+
+  OperatingPoint dynamic_op = disturbedOperatingPoint(t);
 
   if (cfg_.pid.enabled && pid_) {
     const double u_fb = pid_->update(cfg_.pid.setpoint_Tc_out, state_.Tc_out, dt);
@@ -294,11 +339,20 @@ void Simulator::stepLumped(double t, double dt) {
                                                 : std::numeric_limits<double>::quiet_NaN();
   }
 
+  if (cfg_.lumpedIntegrator == LumpedIntegrator::DormandPrince45) {
+    rkHeldColdFlow_ = (cfg_.pid.enabled && pid_) ? dynamic_op.m_dot_cold
+                                                 : std::numeric_limits<double>::quiet_NaN();
+    advanceLumpedAdaptive(t, dt);
+    state_.dP_tube = hydro_.dP_tube(dynamic_op.m_dot_hot, Rf_tube, k_deposit, thermo_.geometry().K_minor_tube);
+    state_.dP_shell = shellPressureDrop(dynamic_op.m_dot_cold, Rf_shell, k_deposit);
+    return;
+  }
+
   // (Historical note: a steady-state snapshot used to be computed here
   // for diagnostics but was never consumed; removed to save one full
   // Thermo::steady() call per dynamic step.)
 
-  const double Ut = thermo_.U(dynamic_op.m_dot_hot, dynamic_op.m_dot_cold, Rf_shell, Rf_tube, k_deposit);
+  const double Ut = overallU(dynamic_op, Rf_shell, Rf_tube, k_deposit);
   const double A = thermo_.geometry().areaOuter();
 
   double F = 1.0;
@@ -337,7 +391,251 @@ void Simulator::stepLumped(double t, double dt) {
   state_.Q = std::max(0.0, std::min(1e6, state_.Q));
 
   state_.dP_tube = hydro_.dP_tube(dynamic_op.m_dot_hot, Rf_tube, k_deposit, thermo_.geometry().K_minor_tube);
-  state_.dP_shell = hydro_.dP_shell(dynamic_op.m_dot_cold, Rf_shell, k_deposit, thermo_.geometry().K_turns_shell);
+  state_.dP_shell = shellPressureDrop(dynamic_op.m_dot_cold, Rf_shell, k_deposit);
+}
+
+// -----------------------------------------------------------------------------
+// Adaptive lumped path: Dormand–Prince 5(4) with FSAL, standard I-controller
+// step selection and Hairer's 4th-order continuous extension for dense output
+// (E. Hairer, S. Nørsett, G. Wanner, "Solving ODEs I", §II.5–6).
+//
+// The right-hand side is the same energy balance stepLumped() integrates with
+// explicit Euler, but every stage re-evaluates the disturbance profile, Rf(t),
+// the preset fluid properties and the arrangement F factor at its own (t, y).
+// Inputs that are only defined on the caller's grid — the discrete PID output
+// and pending scenario events — are held for the macro step, and the solver is
+// then not allowed to run past t + dt.  Otherwise it may step well beyond the
+// grid and later step() calls just evaluate the dense-output polynomial.
+// Disturbance discontinuities (step time, ramp start/end) are always landed on
+// exactly so no step straddles a jump.
+// -----------------------------------------------------------------------------
+namespace {
+// Butcher tableau.
+constexpr double kC2 = 1.0 / 5.0, kC3 = 3.0 / 10.0, kC4 = 4.0 / 5.0, kC5 = 8.0 / 9.0;
+constexpr double kA21 = 1.0 / 5.0;
+constexpr double kA31 = 3.0 / 40.0, kA32 = 9.0 / 40.0;
+constexpr double kA41 = 44.0 / 45.0, kA42 = -56.0 / 15.0, kA43 = 32.0 / 9.0;
+constexpr double kA51 = 19372.0 / 6561.0, kA52 = -25360.0 / 2187.0,
+                 kA53 = 64448.0 / 6561.0, kA54 = -212.0 / 729.0;
+constexpr double kA61 = 9017.0 / 3168.0, kA62 = -355.0 / 33.0, kA63 = 46732.0 / 5247.0,
+                 kA64 = 49.0 / 176.0, kA65 = -5103.0 / 18656.0;
+constexpr double kA71 = 35.0 / 384.0, kA73 = 500.0 / 1113.0, kA74 = 125.0 / 192.0,
+                 kA75 = -2187.0 / 6784.0, kA76 = 11.0 / 84.0;
+// 5th − 4th order weights (local error estimate).
+constexpr double kE1 = 71.0 / 57600.0, kE3 = -71.0 / 16695.0, kE4 = 71.0 / 1920.0,
+                 kE5 = -17253.0 / 339200.0, kE6 = 22.0 / 525.0, kE7 = -1.0 / 40.0;
+// Dense-output weights.
+constexpr double kD1 = -12715105075.0 / 11282082432.0, kD3 = 87487479700.0 / 32700410799.0,
+                 kD4 = -10690763975.0 / 1880347072.0, kD5 = 701980252875.0 / 199316789632.0,
+                 kD6 = -1453857185.0 / 822651844.0, kD7 = 69997945.0 / 29380423.0;
+} // anonymous namespace
+
+void Simulator::lumpedRhs(double t, const double y[2], double dydt[2], double *Q, double *U) {
+  ++rkStats_.rhsEvals;
+  OperatingPoint op = disturbedOperatingPoint(t);
+  if (std::isfinite(rkHeldColdFlow_)) op.m_dot_cold = rkHeldColdFlow_;
+  const double Th = y[0];
+  const double Tc = y[1];
+
+  double Rf_shell = 0.0;
+  double Rf_tube = 0.0;
+  const double k_deposit = foul_.params().k_deposit;
+  if (foulingEnabled_) {
+    const double Rf = std::max(0.0, std::min(foul_.Rf(t), 0.01));
+    Rf_shell = Rf * foul_.params().split_ratio;
+    Rf_tube = Rf * (1.0 - foul_.params().split_ratio);
+  }
+
+  updateFluidProperties(0.5 * (op_.Tin_hot + Th), 0.5 * (op_.Tin_cold + Tc));
+
+  const double Ut = overallU(op, Rf_shell, Rf_tube, k_deposit);
+  const double A = thermo_.geometry().areaOuter();
+
+  double F = 1.0;
+  if (cfg_.arrangement == FlowArrangement::ShellTube_1_2 ||
+      cfg_.arrangement == FlowArrangement::ShellTube_2_4) {
+    const double dT_in = op.Tin_hot - op.Tin_cold;
+    if (dT_in > 1e-3) {
+      const double dTc = std::max(Tc - op.Tin_cold, 1e-6);
+      const double R   = (op.Tin_hot - Th) / dTc;
+      const double P   = (Tc - op.Tin_cold) / dT_in;
+      F = Thermo::lmtdCorrectionF(cfg_.arrangement, R, P);
+    }
+  } else if (cfg_.arrangement == FlowArrangement::ParallelFlow) {
+    const double dT_in = std::max(op.Tin_hot - op.Tin_cold, 1e-6);
+    F = std::clamp((Th - Tc) / dT_in, 0.0, 1.0);
+    F = std::max(F, 0.5);
+  }
+  const double Qt = Ut * A * (Th - Tc) * F;
+
+  const double Ch = op.m_dot_hot * thermo_.hot().cp;
+  const double Cc = op.m_dot_cold * thermo_.cold().cp;
+  const double Cth_h = cfg_.Mh * thermo_.hot().cp;
+  const double Cth_c = cfg_.Mc * thermo_.cold().cp;
+
+  dydt[0] = (Ch * (op.Tin_hot - Th) - Qt) / std::max(Cth_h, 1e-12);
+  dydt[1] = (Cc * (op.Tin_cold - Tc) + Qt) / std::max(Cth_c, 1e-12);
+  if (Q) *Q = Qt;
+  if (U) *U = Ut;
+}
+
+double Simulator::nextLumpedBreakpoint(double t) const {
+  double tb = std::numeric_limits<double>::infinity();
+  if (steadyStateMode_) return tb;
+  auto consider = [&](double x) { if (x > t) tb = std::min(tb, x); };
+  switch (cfg_.disturbanceType) {
+    case SimConfig::DisturbanceType::StepChange:
+      consider(cfg_.dist_step_time);
+      break;
+    case SimConfig::DisturbanceType::Ramp:
+      consider(cfg_.dist_ramp_start);
+      consider(cfg_.dist_ramp_start + std::max(1.0, cfg_.dist_ramp_duration));
+      break;
+    default:
+      break;
+  }
+  return tb;
+}
+
+void Simulator::advanceLumpedAdaptive(double t, double dt) {
+  const double target = t + dt;
+  const bool pendingEvents = std::any_of(cfg_.scenario.begin(), cfg_.scenario.end(),
+                                         [](const ScenarioEvent &ev) { return !ev.fired; });
+  const bool held = std::isfinite(rkHeldColdFlow_) || pendingEvents;
+  const double eps = 1e-12 * std::max(1.0, std::abs(target));
+
+  // Restart from state_ when the caller's clock is not where we left off, or
+  // when held inputs apply from t but the solver has already run past it.
+  const bool restart = !rk_.valid
+                    || std::abs(t - rk_.tOut) > 1e-9 * std::max(1.0, std::abs(t))
+                    || (held && std::abs(rk_.t - t) > eps);
+  if (restart) {
+    rk_.valid = true;
+    rk_.t = rk_.t0 = t;
+    rk_.hLast = 0.0;
+    rk_.y[0] = state_.Th_out;
+    rk_.y[1] = state_.Tc_out;
+    if (!(rk_.h > 0.0)) rk_.h = dt;
+  }
+  // Held inputs may have changed since the last FSAL stage was evaluated.
+  if (restart || held) lumpedRhs(rk_.t, rk_.y, rk_.k1);
+
+  // Step-size floor.  The right-hand side is not smooth everywhere in the
+  // state (e.g. h_tube jumps at the Re = 2300 laminar/turbulent switch, and a
+  // run can slide along that surface); without a floor the error controller
+  // grinds to femtosecond steps there.  10⁻⁶ dt bounds the work; a step that
+  // still fails the error test at the floor is accepted and counted in
+  // IntegratorStats::forced so the caller can see the tolerance was missed.
+  const double hMin = std::max(1e-10 * std::max(1.0, std::abs(target)), 1e-6 * dt);
+  bool lastRejected = false;
+  while (rk_.t < target - eps) {
+    const double bp = nextLumpedBreakpoint(rk_.t);
+    const double limit = held ? std::min(target, bp) : bp;
+    const double hWanted = std::max(rk_.h, hMin);
+    double h = hWanted;
+    bool land = false;
+    if (rk_.t + h >= limit - eps) {
+      h = limit - rk_.t;
+      land = true;
+    }
+
+    const double t0 = rk_.t;
+    const double *y0 = rk_.y;
+    const double *k1 = rk_.k1;
+    double k2[2], k3[2], k4[2], k5[2], k6[2], k7[2], ys[2], y5[2];
+    for (int i = 0; i < 2; ++i) ys[i] = y0[i] + h * kA21 * k1[i];
+    lumpedRhs(t0 + kC2 * h, ys, k2);
+    for (int i = 0; i < 2; ++i) ys[i] = y0[i] + h * (kA31 * k1[i] + kA32 * k2[i]);
+    lumpedRhs(t0 + kC3 * h, ys, k3);
+    for (int i = 0; i < 2; ++i) ys[i] = y0[i] + h * (kA41 * k1[i] + kA42 * k2[i] + kA43 * k3[i]);
+    lumpedRhs(t0 + kC4 * h, ys, k4);
+    for (int i = 0; i < 2; ++i)
+      ys[i] = y0[i] + h * (kA51 * k1[i] + kA52 * k2[i] + kA53 * k3[i] + kA54 * k4[i]);
+    lumpedRhs(t0 + kC5 * h, ys, k5);
+    for (int i = 0; i < 2; ++i)
+      ys[i] = y0[i] + h * (kA61 * k1[i] + kA62 * k2[i] + kA63 * k3[i] + kA64 * k4[i] + kA65 * k5[i]);
+    lumpedRhs(t0 + h, ys, k6);
+    for (int i = 0; i < 2; ++i)
+      y5[i] = y0[i] + h * (kA71 * k1[i] + kA73 * k3[i] + kA74 * k4[i] + kA75 * k5[i] + kA76 * k6[i]);
+    lumpedRhs(t0 + h, y5, k7);
+
+    double errSq = 0.0;
+    for (int i = 0; i < 2; ++i) {
+      const double e = h * (kE1 * k1[i] + kE3 * k3[i] + kE4 * k4[i] +
+                            kE5 * k5[i] + kE6 * k6[i] + kE7 * k7[i]);
+      const double sc = cfg_.atol + cfg_.rtol * std::max(std::abs(y0[i]), std::abs(y5[i]));
+      errSq += (e / sc) * (e / sc);
+    }
+    const double err = std::sqrt(0.5 * errSq);
+
+    if (err > 1.0 && h > hMin) {
+      ++rkStats_.rejected;
+      rk_.h = h * std::max(0.2, 0.9 * std::pow(err, -0.2));
+      lastRejected = true;
+      continue;
+    }
+
+    ++rkStats_.accepted;
+    if (err > 1.0) ++rkStats_.forced;
+    for (int i = 0; i < 2; ++i) {
+      const double ydiff = y5[i] - y0[i];
+      const double bspl  = h * k1[i] - ydiff;
+      rk_.r[0][i] = y0[i];
+      rk_.r[1][i] = ydiff;
+      rk_.r[2][i] = bspl;
+      rk_.r[3][i] = ydiff - h * k7[i] - bspl;
+      rk_.r[4][i] = h * (kD1 * k1[i] + kD3 * k3[i] + kD4 * k4[i] +
+                         kD5 * k5[i] + kD6 * k6[i] + kD7 * k7[i]);
+    }
+    rk_.t0 = t0;
+    rk_.hLast = h;
+    rk_.t = land ? limit : t0 + h;
+
+    bool refreshK1 = land && limit >= bp;   // landed on a disturbance discontinuity
+    for (int i = 0; i < 2; ++i) {
+      const double yc = std::clamp(y5[i], 0.0, 200.0);
+      if (yc != y5[i]) refreshK1 = true;
+      rk_.y[i] = yc;
+      rk_.k1[i] = k7[i];
+    }
+    if (refreshK1) {
+      // Right-hand limit past a jump (or after clamping): re-evaluate stage 1.
+      lumpedRhs(std::nextafter(rk_.t, std::numeric_limits<double>::infinity()), rk_.y, rk_.k1);
+    }
+
+    double fac = (err > 0.0) ? 0.9 * std::pow(err, -0.2) : 5.0;
+    fac = std::clamp(fac, 0.2, lastRejected ? 1.0 : 5.0);
+    // A step shortened to hit the grid / a breakpoint says nothing about the
+    // natural step size, so do not let it shrink the next proposal.
+    rk_.h = land ? std::max(hWanted, h * fac) : h * fac;
+    lastRejected = false;
+  }
+
+  // Dense output at the caller's grid point.
+  double yOut[2];
+  if (std::abs(rk_.t - target) <= eps || rk_.hLast <= 0.0) {
+    yOut[0] = rk_.y[0];
+    yOut[1] = rk_.y[1];
+  } else {
+    const double s  = (target - rk_.t0) / rk_.hLast;
+    const double s1 = 1.0 - s;
+    for (int i = 0; i < 2; ++i) {
+      yOut[i] = rk_.r[0][i] + s * (rk_.r[1][i] + s1 * (rk_.r[2][i] +
+                s * (rk_.r[3][i] + s1 * rk_.r[4][i])));
+      yOut[i] = std::clamp(yOut[i], 0.0, 200.0);
+    }
+  }
+  rk_.tOut = target;
+
+  state_.Th_out = yOut[0];
+  state_.Tc_out = yOut[1];
+
+  double dydt[2];
+  double Qt = 0.0;
+  double Ut = 0.0;
+  lumpedRhs(target, yOut, dydt, &Qt, &Ut);
+  state_.U = Ut;
+  state_.Q = std::max(0.0, std::min(1e6, Qt));
 }
 
 // -----------------------------------------------------------------------------
@@ -346,7 +644,9 @@ void Simulator::stepLumped(double t, double dt) {
 // local heat-transfer source term (q_i = U·dA·(Th_i − Tc_i)·F).  Because the
 // fluid capacitance of one cell is Mh/N (N times smaller than the lumped
 // model), we CFL-substep inside the macro step to stay stable without
-// tightening the outer UI time step.
+// tightening the outer UI time step — unless an implicit integrator is
+// selected, in which case advanceAxialImplicit() takes the whole macro step
+// in one block-tridiagonal solve.
 // -----------------------------------------------------------------------------
 void Simulator::stepAxial(double tNow, double dtMacro) {
   const int N = static_cast<int>(Th_cell_.size());
@@ -366,36 +666,7 @@ void Simulator::stepAxial(double tNow, double dtMacro) {
     state_.Rf = 0.0;
   }
 
-  OperatingPoint dynamic_op = op_;
-  if (!steadyStateMode_) {
-    switch (cfg_.disturbanceType) {
-      case SimConfig::DisturbanceType::SineWave:
-        dynamic_op.Tin_hot += cfg_.dist_sine_amp_Tin * std::sin(2.0 * M_PI * tNow / cfg_.dist_sine_freq_Tin) +
-                              (cfg_.dist_sine_amp_Tin * 0.5) * std::sin(2.0 * M_PI * tNow / (cfg_.dist_sine_freq_Tin / 3.0));
-        dynamic_op.Tin_cold += (cfg_.dist_sine_amp_Tin * 0.66) * std::sin(2.0 * M_PI * tNow / (cfg_.dist_sine_freq_Tin * 1.33)) +
-                               (cfg_.dist_sine_amp_Tin * 0.33) * std::sin(2.0 * M_PI * tNow / (cfg_.dist_sine_freq_Tin * 0.5));
-        dynamic_op.m_dot_hot += op_.m_dot_hot * cfg_.dist_sine_amp_flow * std::sin(2.0 * M_PI * tNow / cfg_.dist_sine_freq_flow) +
-                                op_.m_dot_hot * (cfg_.dist_sine_amp_flow * 0.5) * std::sin(2.0 * M_PI * tNow / (cfg_.dist_sine_freq_flow * 0.4));
-        dynamic_op.m_dot_cold += op_.m_dot_cold * (cfg_.dist_sine_amp_flow * 0.8) * std::sin(2.0 * M_PI * tNow / (cfg_.dist_sine_freq_flow * 0.73)) +
-                                  op_.m_dot_cold * (cfg_.dist_sine_amp_flow * 0.4) * std::sin(2.0 * M_PI * tNow / (cfg_.dist_sine_freq_flow * 0.26));
-        break;
-      case SimConfig::DisturbanceType::StepChange:
-        if (tNow > cfg_.dist_step_time) {
-          dynamic_op.m_dot_hot *= (1.0 + cfg_.dist_step_mag_flow);
-          dynamic_op.Tin_hot += cfg_.dist_step_mag_Tin;
-        }
-        break;
-      case SimConfig::DisturbanceType::Ramp:
-        if (tNow > cfg_.dist_ramp_start) {
-          const double ramp = std::min(1.0, (tNow - cfg_.dist_ramp_start) / std::max(1.0, cfg_.dist_ramp_duration));
-          dynamic_op.m_dot_hot *= (1.0 + cfg_.dist_ramp_mag_flow * ramp);
-        }
-        break;
-      case SimConfig::DisturbanceType::None:
-      default:
-        break;
-    }
-  }
+  OperatingPoint dynamic_op = disturbedOperatingPoint(tNow);
 
   if (cfg_.pid.enabled && pid_) {
     const double u_fb = pid_->update(cfg_.pid.setpoint_Tc_out, state_.Tc_out, dtMacro);
@@ -422,7 +693,7 @@ void Simulator::stepAxial(double tNow, double dtMacro) {
                                                 : std::numeric_limits<double>::quiet_NaN();
   }
 
-  const double Ut = thermo_.U(dynamic_op.m_dot_hot, dynamic_op.m_dot_cold, Rf_shell, Rf_tube, k_deposit);
+  const double Ut = overallU(dynamic_op, Rf_shell, Rf_tube, k_deposit);
   const double Atot = thermo_.geometry().areaOuter();
   const double dA = Atot / N;
 
@@ -450,53 +721,62 @@ void Simulator::stepAxial(double tNow, double dtMacro) {
 
   const bool counter = (cfg_.arrangement != FlowArrangement::ParallelFlow);
 
-  // CFL-type sub-stepping: make the sub-step small enough that the fluid
-  // advances at most half a cell per step even at the faster side.
-  const double tau_h = (Ch > 1e-12) ? Cth_h_cell / Ch : dtMacro;
-  const double tau_c = (Cc > 1e-12) ? Cth_c_cell / Cc : dtMacro;
-  const double tau_min = std::max(1e-4, std::min(tau_h, tau_c));
-  const int nSub = std::max(1, static_cast<int>(std::ceil(dtMacro / (0.5 * tau_min))));
-  const double dtSub = dtMacro / nSub;
-
-  std::vector<double> dTh(static_cast<size_t>(N), 0.0);
-  std::vector<double> dTc(static_cast<size_t>(N), 0.0);
   double Q_total = 0.0;
 
-  for (int sub = 0; sub < nSub; ++sub) {
-    double Q_this = 0.0;
-
-    for (int i = 0; i < N; ++i) {
-      const double Th_i = Th_cell_[static_cast<size_t>(i)];
-      const double Tc_i = Tc_cell_[static_cast<size_t>(i)];
-      const double qi = Ut * dA * (Th_i - Tc_i) * F;
-      Q_this += qi;
-
-      // Upwind advection: hot fluid flows 0 → N-1.
-      const double Th_up = (i == 0) ? dynamic_op.Tin_hot
-                                    : Th_cell_[static_cast<size_t>(i - 1)];
-      double Tc_up;
-      if (counter) {
-        Tc_up = (i == N - 1) ? dynamic_op.Tin_cold
-                             : Tc_cell_[static_cast<size_t>(i + 1)];
-      } else {
-        Tc_up = (i == 0) ? dynamic_op.Tin_cold
-                         : Tc_cell_[static_cast<size_t>(i - 1)];
+  if (cfg_.axialIntegrator != AxialIntegrator::ExplicitSubstep) {
+    const double theta = (cfg_.axialIntegrator == AxialIntegrator::CrankNicolson) ? 0.5 : 1.0;
+    Q_total = advanceAxialImplicit(dtMacro, theta, Ut * dA * F, Ch, Cc,
+                                   Cth_h_cell, Cth_c_cell,
+                                   dynamic_op.Tin_hot, dynamic_op.Tin_cold, counter);
+  } else {
+    // CFL-type sub-stepping: make the sub-step small enough that the fluid
+    // advances at most half a cell per step even at the faster side.
+    const double tau_h = (Ch > 1e-12) ? Cth_h_cell / Ch : dtMacro;
+    const double tau_c = (Cc > 1e-12) ? Cth_c_cell / Cc : dtMacro;
+    const double tau_min = std::max(1e-4, std::min(tau_h, tau_c));
+    const int nSub = std::max(1, static_cast<int>(std::ceil(dtMacro / (0.5 * tau_min))));
+    const double dtSub = dtMacro / nSub;
+
+    // Cell rates live in the preallocated workspace (no per-step allocation).
+    double *dTh = axialWork_.data();
+    double *dTc = axialWork_.data() + N;
+
+    for (int sub = 0; sub < nSub; ++sub) {
+      double Q_this = 0.0;
+
+      for (int i = 0; i < N; ++i) {
+        const double Th_i = Th_cell_[static_cast<size_t>(i)];
+        const double Tc_i = Tc_cell_[static_cast<size_t>(i)];
+        const double qi = Ut * dA * (Th_i - Tc_i) * F;
+        Q_this += qi;
+
+        // Upwind advection: hot fluid flows 0 → N-1.
+        const double Th_up = (i == 0) ? dynamic_op.Tin_hot
+                                      : Th_cell_[static_cast<size_t>(i - 1)];
+        double Tc_up;
+        if (counter) {
+          Tc_up = (i == N - 1) ? dynamic_op.Tin_cold
+                               : Tc_cell_[static_cast<size_t>(i + 1)];
+        } else {
+          Tc_up = (i == 0) ? dynamic_op.Tin_cold
+                           : Tc_cell_[static_cast<size_t>(i - 1)];
+        }
+
+        dTh[static_cast<size_t>(i)] =
+            (Ch * (Th_up - Th_i) - qi) / std::max(Cth_h_cell, 1e-12);
+        dTc[static_cast<size_t>(i)] =
+            (Cc * (Tc_up - Tc_i) + qi) / std::max(Cth_c_cell, 1e-12);
       }
 
-      dTh[static_cast<size_t>(i)] =
-          (Ch * (Th_up - Th_i) - qi) / std::max(Cth_h_cell, 1e-12);
-      dTc[static_cast<size_t>(i)] =
-          (Cc * (Tc_up - Tc_i) + qi) / std::max(Cth_c_cell, 1e-12);
-    }
+      for (int i = 0; i < N; ++i) {
+        Th_cell_[static_cast<size_t>(i)] += dTh[static_cast<size_t>(i)] * dtSub;
+        Tc_cell_[static_cast<size_t>(i)] += dTc[static_cast<size_t>(i)] * dtSub;
+        Th_cell_[static_cast<size_t>(i)] = std::clamp(Th_cell_[static_cast<size_t>(i)], 0.0, 200.0);
+        Tc_cell_[static_cast<size_t>(i)] = std::clamp(Tc_cell_[static_cast<size_t>(i)], 0.0, 200.0);
+      }
 
-    for (int i = 0; i < N; ++i) {
-      Th_cell_[static_cast<size_t>(i)] += dTh[static_cast<size_t>(i)] * dtSub;
-      Tc_cell_[static_cast<size_t>(i)] += dTc[static_cast<size_t>(i)] * dtSub;
-      Th_cell_[static_cast<size_t>(i)] = std::clamp(Th_cell_[static_cast<size_t>(i)], 0.0, 200.0);
-      Tc_cell_[static_cast<size_t>(i)] = std::clamp(Tc_cell_[static_cast<size_t>(i)], 0.0, 200.0);
+      Q_total = Q_this;
     }
-
-    Q_total = Q_this;
   }
 
   // Outlet scalars: hot outlet is always on the N-1 side; cold outlet depends
@@ -507,11 +787,225 @@ void Simulator::stepAxial(double tNow, double dtMacro) {
   state_.U = Ut;
   state_.Q = std::max(0.0, std::min(1e6, Q_total));
 
-  state_.Th_axial = Th_cell_;
-  state_.Tc_axial = Tc_cell_;
-
   state_.dP_tube  = hydro_.dP_tube (dynamic_op.m_dot_hot,  Rf_tube,  k_deposit, thermo_.geometry().K_minor_tube);
-  state_.dP_shell = hydro_.dP_shell(dynamic_op.m_dot_cold, Rf_shell, k_deposit, thermo_.geometry().K_turns_shell);
+  state_.dP_shell = shellPressureDrop(dynamic_op.m_dot_cold, Rf_shell, k_deposit);
+}
+
+// -----------------------------------------------------------------------------
+// Direct steady solve.  Setting ∂T/∂t = 0 in the cell balances is the θ = 1
+// system with Cth/dt → 0, so the axial case reuses advanceAxialImplicit() with
+// dt = ∞ (the right-hand side then carries only the inlet terms).  The only
+// nonlinearities are the preset fluid properties and the Bowman F factor,
+// both functions of the outlet temperatures, which are resolved by Picard
+// iteration on (Th_out, Tc_out).
+// -----------------------------------------------------------------------------
+SteadySolveResult Simulator::solveSteadyAxial(double t, int maxIter, double tol) {
+  SteadySolveResult r;
+
+  double Rf_shell = 0.0;
+  double Rf_tube = 0.0;
+  const double k_deposit = foul_.params().k_deposit;
+  const double split_ratio = foul_.params().split_ratio;
+
+  if (foulingEnabled_) {
+    state_.Rf = foul_.Rf(t);
+    state_.Rf = std::max(0.0, std::min(state_.Rf, 0.01));
+    Rf_shell = state_.Rf * split_ratio;
+    Rf_tube = state_.Rf * (1.0 - split_ratio);
+  } else {
+    state_.Rf = 0.0;
+  }
+
+  const int N = std::max(1, cfg_.numAxialCells);
+  if (N > 1 && Th_cell_.size() != static_cast<size_t>(N)) initAxialProfile();
+  rk_.valid = false;
+
+  const bool counter   = (cfg_.arrangement != FlowArrangement::ParallelFlow);
+  const bool shellTube = (cfg_.arrangement == FlowArrangement::ShellTube_1_2 ||
+                          cfg_.arrangement == FlowArrangement::ShellTube_2_4);
+  const bool presets   = hotVariable_ || coldVariable_;
+  // The lumped parallel-flow path scales Q by an outlet-dependent factor too.
+  const bool nonlinear = presets || shellTube || (N <= 1 && !counter);
+
+  const double Atot = thermo_.geometry().areaOuter();
+  double Ut = 0.0;
+  double Q_total = 0.0;
+
+  for (int it = 0; it < std::max(1, maxIter); ++it) {
+    updateFluidProperties(0.5 * (op_.Tin_hot + state_.Th_out),
+                          0.5 * (op_.Tin_cold + state_.Tc_out));
+
+    const double Ch = op_.m_dot_hot  * thermo_.hot().cp;
+    const double Cc = op_.m_dot_cold * thermo_.cold().cp;
+    if (Ch <= 1e-12 || Cc <= 1e-12) {
+      r.status = SteadySolveResult::Status::NoFlow;
+      return r;
+    }
+
+    Ut = overallU(op_, Rf_shell, Rf_tube, k_deposit);
+
+    double F = 1.0;
+    if (shellTube) {
+      const double dT_in = op_.Tin_hot - op_.Tin_cold;
+      if (dT_in > 1e-3) {
+        const double dTc = std::max(state_.Tc_out - op_.Tin_cold, 1e-6);
+        const double R   = (op_.Tin_hot - state_.Th_out) / dTc;
+        const double P   = (state_.Tc_out - op_.Tin_cold) / dT_in;
+        F = Thermo::lmtdCorrectionF(cfg_.arrangement, R, P);
+      }
+    } else if (N <= 1 && !counter) {
+      const double dT_in = std::max(op_.Tin_hot - op_.Tin_cold, 1e-6);
+      F = std::clamp((state_.Th_out - state_.Tc_out) / dT_in, 0.0, 1.0);
+      F = std::max(F, 0.5);
+    }
+
+    double Th_out = 0.0;
+    double Tc_out = 0.0;
+    if (N > 1) {
+      Q_total = advanceAxialImplicit(std::numeric_limits<double>::infinity(), 1.0,
+                                     Ut * (Atot / N) * F, Ch, Cc, 0.0, 0.0,
+                                     op_.Tin_hot, op_.Tin_cold, counter);
+      Th_out = Th_cell_[static_cast<size_t>(N - 1)];
+      Tc_out = counter ? Tc_cell_[0] : Tc_cell_[static_cast<size_t>(N - 1)];
+    } else {
+      //  Ch (Tin_h − Th) = kA (Th − Tc) = Cc (Tc − Tin_c)
+      const double kA = Ut * Atot * F;
+      Eigen::Matrix2d M;
+      M << Ch + kA, -kA,
+           -kA,     Cc + kA;
+      const Eigen::Vector2d x = M.inverse() * Eigen::Vector2d(Ch * op_.Tin_hot, Cc * op_.Tin_cold);
+      Th_out = std::clamp(x(0), 0.0, 200.0);
+      Tc_out = std::clamp(x(1), 0.0, 200.0);
+      Q_total = kA * (Th_out - Tc_out);
+    }
+
+    r.residual = std::max(std::abs(Th_out - state_.Th_out), std::abs(Tc_out - state_.Tc_out));
+    r.iterations = it + 1;
+    state_.Th_out = Th_out;
+    state_.Tc_out = Tc_out;
+    if (!nonlinear || r.residual < tol) {
+      r.status = SteadySolveResult::Status::Converged;
+      r.ok = true;
+      break;
+    }
+  }
+
+  state_.U = Ut;
+  state_.Q = std::max(0.0, std::min(1e6, Q_total));
+  state_.dP_tube  = hydro_.dP_tube (op_.m_dot_hot,  Rf_tube,  k_deposit, thermo_.geometry().K_minor_tube);
+  state_.dP_shell = shellPressureDrop(op_.m_dot_cold, Rf_shell, k_deposit);
+
+  return r;
+}
+
+std::string steadySolveMessage(const SteadySolveResult &r) {
+  char buf[128] = "";
+  switch (r.status) {
+    case SteadySolveResult::Status::Converged:
+      std::snprintf(buf, sizeof(buf), "Converged in %d sweep(s), residual %.2e K",
+                    r.iterations, r.residual);
+      break;
+    case SteadySolveResult::Status::NotConverged:
+      std::snprintf(buf, sizeof(buf), "Not converged after %d sweeps, residual %.2e K",
+                    r.iterations, r.residual);
+      break;
+    case SteadySolveResult::Status::NoFlow:
+      return "Steady state undefined: both flow rates must be positive";
+  }
+  return buf;
+}
+
+// -----------------------------------------------------------------------------
+// θ-method for the axial cell system (θ = 1 backward Euler, θ = ½ Crank–
+// Nicolson).  With x_i = [Th_i, Tc_i] and k = U·dA·F every cell obeys
+//
+//   Cth_h/dt (Th_i' − Th_i) = θ·f_h(x') + (1−θ)·f_h(x),  f_h = Ch(Th_up − Th_i) − k(Th_i − Tc_i)
+//   Cth_c/dt (Tc_i' − Tc_i) = θ·f_c(x') + (1−θ)·f_c(x),  f_c = Cc(Tc_up − Tc_i) + k(Th_i − Tc_i)
+//
+// Hot upwind is always cell i−1; cold upwind is i+1 (counter) or i−1
+// (parallel), so the implicit operator is 2×2 block-tridiagonal:
+//   L_i x_{i−1} + D_i x_i + U_i x_{i+1} = b_i.
+// Every block row is diagonally dominant (Cth/dt > 0), so block-Thomas
+// elimination without pivoting is stable; solveSteadyAxial() passes dt = ∞,
+// where dominance is weak in the interior but strict at the inlet rows.
+//
+// The blocks are written out as scalars.  D_i = D is the same for every row
+// and the couplings are diagonal, L_i = diag(lh, lc) and U_i = diag(0, uc),
+// so the factor G_i = D'_i⁻¹ U_i has a zero first column: only its second
+// column (g_h, g_c) and the forward-sweep vector y_i are kept, and each
+// pivot block D'_i = D − L_i G_{i−1} is inverted by its cofactors.
+// Cost: O(N) per macro step for any dt / flow rate / holdup.  Returns the
+// total duty at the new time level.
+// -----------------------------------------------------------------------------
+double Simulator::advanceAxialImplicit(double dt, double theta, double kA,
+                                       double Ch, double Cc,
+                                       double Cth_h_cell, double Cth_c_cell,
+                                       double Tin_hot, double Tin_cold, bool counter) {
+  const int N = static_cast<int>(Th_cell_.size());
+  if (axialWork_.size() != static_cast<size_t>(4 * N)) {
+    axialWork_.assign(static_cast<size_t>(4 * N), 0.0);
+  }
+
+  const double mh = std::max(Cth_h_cell, 1e-12) / dt;
+  const double mc = std::max(Cth_c_cell, 1e-12) / dt;
+  const double ex = 1.0 - theta;
+  const double ah = theta * Ch;
+  const double ac = theta * Cc;
+  const double kk = theta * kA;
+  const double d00 = mh + ah + kk;
+  const double d11 = mc + ac + kk;
+
+  // Forward sweep: D'_i = D − L_i G_{i−1},  y_i = D'_i⁻¹ (b_i − L_i y_{i−1}),
+  //                G_i = D'_i⁻¹ U_i.
+  double ghPrev = 0.0, gcPrev = 0.0;
+  double yhPrev = 0.0, ycPrev = 0.0;
+  for (int i = 0; i < N; ++i) {
+    const size_t ui = static_cast<size_t>(i);
+    const double Th_i = Th_cell_[ui];
+    const double Tc_i = Tc_cell_[ui];
+    const double q_old = kA * (Th_i - Tc_i);
+
+    const bool hotInlet  = (i == 0);
+    const bool coldInlet = counter ? (i == N - 1) : (i == 0);
+    const double Th_up = hotInlet  ? Tin_hot  : Th_cell_[ui - 1];
+    const double Tc_up = coldInlet ? Tin_cold
+                                   : Tc_cell_[counter ? ui + 1 : ui - 1];
+
+    const double bh = mh * Th_i + ex * (Ch * (Th_up - Th_i) - q_old) + (hotInlet  ? ah * Tin_hot  : 0.0);
+    const double bc = mc * Tc_i + ex * (Cc * (Tc_up - Tc_i) + q_old) + (coldInlet ? ac * Tin_cold : 0.0);
+
+    // Coupling to the previous / next cell.
+    const double lh = hotInlet ? 0.0 : -ah;
+    const double lc = (coldInlet || counter) ? 0.0 : -ac;
+    const double uc = (coldInlet || !counter) ? 0.0 : -ac;
+
+    // D'_i = [d00  p01; −kk  p11]
+    const double p01 = -kk - lh * ghPrev;
+    const double p11 = d11 - lc * gcPrev;
+    const double invDet = 1.0 / (d00 * p11 + kk * p01);
+    const double rh = bh - lh * yhPrev;
+    const double rc = bc - lc * ycPrev;
+
+    double *w = axialWork_.data() + 4 * ui;
+    w[0] = ghPrev = -p01 * uc * invDet;
+    w[1] = gcPrev =  d00 * uc * invDet;
+    w[2] = yhPrev = (p11 * rh - p01 * rc) * invDet;
+    w[3] = ycPrev = (d00 * rc + kk * rh) * invDet;
+  }
+
+  // Back substitution: x_{N−1} = y_{N−1},  x_i = y_i − G_i x_{i+1}.  G_i only
+  // multiplies Tc_{i+1}; the clamped value is the one carried upstream.
+  double TcNext = 0.0;
+  double Q_total = 0.0;
+  for (int i = N - 1; i >= 0; --i) {
+    const size_t ui = static_cast<size_t>(i);
+    const double *w = axialWork_.data() + 4 * ui;
+    Th_cell_[ui] = std::clamp(w[2] - w[0] * TcNext, 0.0, 200.0);
+    Tc_cell_[ui] = std::clamp(w[3] - w[1] * TcNext, 0.0, 200.0);
+    TcNext = Tc_cell_[ui];
+    Q_total += kA * (Th_cell_[ui] - Tc_cell_[ui]);
+  }
+  return Q_total;
 }
 
 } // namespace hx
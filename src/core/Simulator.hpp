@@ -3,9 +3,13 @@
 #include "Model.hpp"
 #include "ControllerPID.hpp"
 #include "FluidLibrary.hpp"
+#include "FluidPropertyTable.hpp"
+#include "HeatTransferMemo.hpp"
 #include "Scenario.hpp"
 #include <limits>
 #include <memory>
+#include <optional>
+#include <string>
 
 namespace hx {
 
@@ -92,6 +96,13 @@ struct SimConfig {
   Fluid hotCustom{};   // fallback when hotPreset == Custom
   Fluid coldCustom{};  // fallback when coldPreset == Custom
 
+  // Presets are read from their shared FluidPropertyTable (interpolated,
+  // no pow/exp per step) unless tabulatedFluids is false.  A user table
+  // (e.g. loadFluidTableCsv) takes precedence over the preset on its side.
+  bool tabulatedFluids = true;
+  std::shared_ptr<const FluidPropertyTable> hotTable;
+  std::shared_ptr<const FluidPropertyTable> coldTable;
+
   FlowArrangement arrangement = FlowArrangement::CounterFlow;
 
   // Shell-side correlation: Kern (compact, fast) or Bell–Delaware (segmented,
@@ -105,12 +116,48 @@ struct SimConfig {
   //                          and per-cell heat transfer (plots a real T(x) profile).
   int numAxialCells = 20;
 
+  // Time integrator for the axial model (ignored in lumped mode).  The
+  // implicit options cost one O(N) block-tridiagonal solve per step,
+  // independent of flow rate / holdup, instead of N × CFL sub-steps.
+  AxialIntegrator axialIntegrator = AxialIntegrator::ExplicitSubstep;
+
+  // Time integrator for the lumped model (numAxialCells <= 1) and the error
+  // tolerances of the adaptive option: a step is accepted when every outlet
+  // temperature's local error is below atol + rtol·|T|.
+  LumpedIntegrator lumpedIntegrator = LumpedIntegrator::ExplicitEuler;
+  double rtol = 1e-6;
+  double atol = 1e-4;   // [K]
+
   // Scripted timeline: events whose `fired` flag is false and whose trigger
   // time has passed are applied (in declaration order) at the top of every
   // Simulator::step() call.  Leave empty for no scripting.
   Scenario scenario;
 };
 
+/** \brief Outcome of Simulator::solveSteadyAxial(); plain data, see steadySolveMessage(). */
+struct SteadySolveResult {
+  enum class Status {
+    Converged,      // linear system solved, or Picard sweeps within tol
+    NotConverged,   // maxIter sweeps without reaching tol
+    NoFlow,         // a flow rate is not positive: no steady state
+  };
+  Status status = Status::NotConverged;
+  bool   ok = false;         // status == Converged
+  int    iterations = 0;     // Picard sweeps performed (1 when the system is linear)
+  double residual = 0.0;     // [K] largest outlet change on the final sweep
+};
+
+/** Human-readable status of a steady solve, e.g. "Converged in 3 sweep(s), residual 4.1e-07 K". */
+std::string steadySolveMessage(const SteadySolveResult &r);
+
+/** \brief Work counters of the adaptive lumped integrator (since reset()). */
+struct IntegratorStats {
+  long long accepted = 0;    // internal steps accepted
+  long long rejected = 0;    // internal steps rejected by the error test
+  long long rhsEvals = 0;    // right-hand-side evaluations (each costs one U())
+  long long forced   = 0;    // steps accepted at the step-size floor despite failing the error test
+};
+
 /** \brief Simulator advances the model in time with simple first-order lags to emulate dynamics. */
 class Simulator {
 public:
@@ -118,10 +165,48 @@ public:
 
   void reset(const OperatingPoint &op0);
   [[nodiscard]] const State &step(double t);
-  void updateOperatingPoint(const OperatingPoint &newOp) { op_ = newOp; }
+  /** State after the last step() / solveSteadyAxial(). */
+  [[nodiscard]] const State &state() const { return state_; }
+
+  /**
+   * \brief Axial temperature profiles (finite-volume discretization) [C].
+   *  Cell indexing 0..N-1 runs from the HOT inlet (x = 0) to the HOT outlet
+   *  (x = L).  Empty in lumped mode (numAxialCells <= 1).  The views borrow
+   *  the simulator's cell arrays and are valid until its next step(),
+   *  reset() or solveSteadyAxial(); copy the values to keep them longer.
+   */
+  [[nodiscard]] ProfileView axialTh() const { return ProfileView(Th_cell_); }
+  [[nodiscard]] ProfileView axialTc() const { return ProfileView(Tc_cell_); }
+  void updateOperatingPoint(const OperatingPoint &newOp) { op_ = newOp; rk_.valid = false; }
   void setSteadyStateMode(bool enabled);
   void setFoulingEnabled(bool enabled);
 
+  /**
+   * \brief Jump straight to the steady state of the discretised model.
+   *
+   *  Solves the time-independent cell balances (the block-tridiagonal system
+   *  of the implicit integrator with zero holdup) at the nominal operating
+   *  point and fouling level Rf(t), and installs the result as the current
+   *  state, so a following step() continues from equilibrium.  With constant
+   *  properties and F = 1 one linear solve is exact; fluid presets and the
+   *  Bowman F factor depend on the outlet temperatures, so those cases run
+   *  Picard sweeps until the outlets move less than \p tol.  Lumped mode
+   *  (numAxialCells <= 1) solves the equivalent 2×2 balance.
+   *
+   *  Disturbances, the PID loop and scenario events are not applied.
+   */
+  SteadySolveResult solveSteadyAxial(double t = 0.0, int maxIter = 50, double tol = 1e-6);
+
+  /**
+   * \brief Work done by LumpedIntegrator::DormandPrince45 since the last reset().
+   *  A non-zero \c forced count means the error controller hit its step-size
+   *  floor (10⁻⁶ dt) and the result is not within rtol / atol there.
+   */
+  const IntegratorStats &integratorStats() const { return rkStats_; }
+
+  /** Film-coefficient reuse in U() since the last reset(). */
+  const HeatTransferMemoStats &heatTransferStats() const { return htMemo_.stats(); }
+
   template <class F>
   void run(const OperatingPoint & /*schedule*/, F onSample) {
     double t = 0.0;
@@ -143,7 +228,7 @@ private:
   State state_{};
   bool steadyStateMode_{false};  // true = no disturbances, false = dynamic with disturbances
   bool foulingEnabled_{true};
-  std::unique_ptr<ControllerPID> pid_;  // allocated on reset() when pid.enabled
+  std::optional<ControllerPID> pid_;  // engaged on reset() when pid.enabled (stored inline)
 
   // Cascade/actuator inner state (valve position): actual cold flow reaching
   // the exchanger after the first-order valve lag.  NaN  ⇒  actuator inactive.
@@ -155,6 +240,22 @@ private:
   double ff_Tin_hot_nom_eff_{0.0};
   double ff_m_dot_hot_nom_eff_{0.0};
 
+  // Property sources resolved at construction (nullptr = closed form / constant).
+  const FluidPropertyTable *hotTable_{nullptr};
+  const FluidPropertyTable *coldTable_{nullptr};
+  bool hotVariable_{false};
+  bool coldVariable_{false};
+  void updateFluidProperties(double ThMean, double TcMean);
+
+  // Every U goes through the memo, which re-evaluates only the film
+  // coefficients whose inputs changed.  In Bell–Delaware mode ΔP_shell is
+  // taken from the memo's shell-side evaluation when Thermo and Hydraulics
+  // see the same constant shell fluid (decided in reset()).
+  HeatTransferMemo htMemo_;
+  bool shareShellSide_{false};
+  double overallU(const OperatingPoint &op, double Rf_shell, double Rf_tube, double k_deposit);
+  double shellPressureDrop(double m_dot_cold, double Rf_shell, double k_deposit) const;
+
   void resolveFeedForwardGains();
   double computeFeedForward(double Tin_hot_meas, double m_dot_hot_meas) const;
 
@@ -166,9 +267,46 @@ private:
   std::vector<double> Th_cell_;
   std::vector<double> Tc_cell_;
 
+  // Axial workspace, sized 4·N in initAxialProfile() so step() never
+  // allocates.  The implicit integrators store per cell the non-zero column
+  // of the block-Thomas factor G_i (2 doubles) and the forward-sweep vector
+  // y_i (2); the explicit sub-stepper uses the first 2·N entries for dTh/dt
+  // and dTc/dt.
+  std::vector<double> axialWork_;
+
   void initAxialProfile();
   void stepAxial(double t, double dt);
+  double advanceAxialImplicit(double dt, double theta, double kA,
+                              double Ch, double Cc,
+                              double Cth_h_cell, double Cth_c_cell,
+                              double Tin_hot, double Tin_cold, bool counter);
   void stepLumped(double t, double dt);
+  OperatingPoint disturbedOperatingPoint(double t) const;
+
+  // Dormand–Prince 5(4) state for the lumped model.  The solver runs on its
+  // own time axis (t may run ahead of the caller's grid) and keeps the dense-
+  // output polynomial of its last accepted step over [t0, t0 + hLast] so
+  // step() can interpolate.  valid = false forces a restart from state_.
+  struct LumpedRK {
+    bool   valid = false;
+    double t = 0.0;          // end of last accepted step
+    double h = 0.0;          // proposed next step size
+    double tOut = 0.0;       // last time handed back by step()
+    double y[2] = {0.0, 0.0};   // [Th_out, Tc_out] at t
+    double k1[2] = {0.0, 0.0};  // f(t, y), reused as stage 1 (FSAL)
+    double t0 = 0.0;
+    double hLast = 0.0;
+    double r[5][2] = {};        // dense-output coefficients
+  } rk_;
+  IntegratorStats rkStats_;
+  // Cold flow held over the current macro step when the discrete PID loop
+  // drives it (NaN ⇒ follow the continuous disturbance profile).
+  double rkHeldColdFlow_{std::numeric_limits<double>::quiet_NaN()};
+
+  void advanceLumpedAdaptive(double t, double dt);
+  void lumpedRhs(double t, const double y[2], double dydt[2],
+                 double *Q = nullptr, double *U = nullptr);
+  double nextLumpedBreakpoint(double t) const;
   void applyScenarioEvents(double t);
 };
 
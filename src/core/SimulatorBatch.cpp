@@ -0,0 +1,290 @@
+#include "SimulatorBatch.hpp"
+
+#include "Correlations.hpp"
+#include "Thermo.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace hx {
+
+SimulatorBatch::SimulatorBatch(const Geometry &g, const SimConfig &cfg, bool foulingEnabled)
+    : g_(g), cfg_(cfg), foulingEnabled_(foulingEnabled), bellDelaware_(g) {}
+
+bool SimulatorBatch::supports(const SimConfig &cfg) {
+  return cfg.numAxialCells <= 1
+      && cfg.lumpedIntegrator == LumpedIntegrator::ExplicitEuler
+      && cfg.disturbanceType == SimConfig::DisturbanceType::None
+      && !cfg.pid.enabled
+      && cfg.scenario.empty()
+      && cfg.hotPreset == FluidPreset::Custom
+      && cfg.coldPreset == FluidPreset::Custom
+      && !cfg.hotTable && !cfg.coldTable;
+}
+
+void SimulatorBatch::reserve(size_t n) {
+  for (auto *v : {&mHot_, &mCold_, &TinHot_, &TinCold_, &rhoH_, &muH_, &cpH_, &kH_,
+                  &rhoC_, &muC_, &cpC_, &kC_, &Rf0_, &RfMax_, &tau_, &alpha_, &kDep_, &split_}) {
+    v->reserve(n);
+  }
+  asymptotic_.reserve(n);
+}
+
+size_t SimulatorBatch::addLane(const OperatingPoint &op, const Fluid &hot, const Fluid &cold,
+                               const FoulingParams &fp) {
+  mHot_.push_back(op.m_dot_hot);
+  mCold_.push_back(op.m_dot_cold);
+  TinHot_.push_back(op.Tin_hot);
+  TinCold_.push_back(op.Tin_cold);
+  rhoH_.push_back(hot.rho);  muH_.push_back(hot.mu);  cpH_.push_back(hot.cp);  kH_.push_back(hot.k);
+  rhoC_.push_back(cold.rho); muC_.push_back(cold.mu); cpC_.push_back(cold.cp); kC_.push_back(cold.k);
+  Rf0_.push_back(fp.Rf0);
+  RfMax_.push_back(fp.RfMax);
+  tau_.push_back(fp.tau);
+  alpha_.push_back(fp.alpha);
+  kDep_.push_back(fp.k_deposit);
+  split_.push_back(fp.split_ratio);
+  asymptotic_.push_back(fp.model == FoulingParams::Model::Asymptotic ? 1 : 0);
+  return mHot_.size() - 1;
+}
+
+size_t SimulatorBatch::activeCount() const {
+  return static_cast<size_t>(std::count(active_.begin(), active_.end(), std::uint8_t{1}));
+}
+
+// -----------------------------------------------------------------------------
+// Per-lane invariants.  Uses the scalar Thermo entry points so the cached
+// values are exactly what Simulator would compute on every step.
+// -----------------------------------------------------------------------------
+void SimulatorBatch::reset() {
+  const size_t n = size();
+  for (auto *v : {&invHtTerm_, &hsClean_, &Ch_, &Cc_, &CthH_, &CthC_,
+                  &Th_, &Tc_, &Q_, &U_, &Rf_, &rate_, &hs_, &F_}) {
+    v->assign(n, 0.0);
+  }
+  active_.assign(n, 1);
+
+  Rw_ = wallResistanceOf<double>(g_);
+  A_ = g_.areaOuter();
+
+  // One Thermo (and so one set of Bell–Delaware geometry terms) for the batch.
+  Thermo thermo(g_, Fluid{}, Fluid{});
+  thermo.setShellMethod(cfg_.shellMethod);
+
+  sharedTau_ = true;
+  for (size_t i = 0; i < n; ++i) {
+    if (tau_[i] != tau_[0]) sharedTau_ = false;
+
+    const Fluid hot{rhoH_[i], muH_[i], cpH_[i], kH_[i]};
+    const Fluid cold{rhoC_[i], muC_[i], cpC_[i], kC_[i]};
+    thermo.setHot(hot);
+    thermo.setCold(cold);
+
+    const double ht = std::max(thermo.h_tube(mHot_[i]), 1.0);
+    invHtTerm_[i] = (1.0 / ht) * (g_.Di / g_.Do);
+    hsClean_[i]   = std::max(thermo.h_shell(mCold_[i]), 1.0);
+
+    Ch_[i]   = mHot_[i]  * hot.cp;
+    Cc_[i]   = mCold_[i] * cold.cp;
+    CthH_[i] = std::max(cfg_.Mh * hot.cp, 1e-12);
+    CthC_[i] = std::max(cfg_.Mc * cold.cp, 1e-12);
+
+    // Same seed as Simulator::reset(): clean ε-NTU steady state ± 0.1 K.
+    const OperatingPoint op{mHot_[i], mCold_[i], TinHot_[i], TinCold_[i]};
+    const State s0 = thermo.steady(op, 0.0, 0.0, kDep_[i], cfg_.arrangement);
+    Tc_[i] = s0.Tc_out + 0.1;
+    Th_[i] = s0.Th_out - 0.1;
+    Q_[i]  = s0.Q;
+    U_[i]  = s0.U;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Passes shared by step() and solveSteady().
+// -----------------------------------------------------------------------------
+
+// Fouling resistance at t.  With a common τ the exponential is shared.
+void SimulatorBatch::updateFouling(double t) {
+  const size_t n = size();
+  if (foulingEnabled_) {
+    const double tc = std::max(0.0, t);
+    const double sharedDecay = (sharedTau_ && n > 0) ? std::exp(-tc / std::max(1e-9, tau_[0])) : 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      const double decay = sharedTau_ ? sharedDecay : std::exp(-tc / std::max(1e-9, tau_[i]));
+      double rf = Rf0_[i] + (asymptotic_[i] ? RfMax_[i] * (1.0 - decay) : alpha_[i] * tc);
+      rf = std::max(0.0, rf);
+      Rf_[i] = std::max(0.0, std::min(rf, 0.01));
+    }
+  } else {
+    std::fill(Rf_.begin(), Rf_.end(), 0.0);
+  }
+}
+
+// Shell-side coefficient.  Only fouled lanes need the correlation, the same
+// templates Thermo::h_shell_with_fouling() evaluates.
+void SimulatorBatch::updateShellCoefficient() {
+  const size_t n = size();
+  if (cfg_.shellMethod == ShellSideMethod::BellDelaware) {
+    for (size_t i = 0; i < n; ++i) {
+      const double RfS = Rf_[i] * split_[i];
+      if (RfS > 1e-9) {
+        const Fluid cold{rhoC_[i], muC_[i], cpC_[i], kC_[i]};
+        hs_[i] = std::max(bellDelaware_.evaluate(cold, mCold_[i], RfS, kDep_[i]).h_shell, 1.0);
+      } else {
+        hs_[i] = hsClean_[i];
+      }
+    }
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      const double RfS = Rf_[i] * split_[i];
+      if (RfS > 1e-9) {
+        const Fluid cold{rhoC_[i], muC_[i], cpC_[i], kC_[i]};
+        const double De = kernEquivalentDiameter(g_, RfS, kDep_[i]);
+        hs_[i] = std::max(kernShellCoefficient(g_, cold, mCold_[i], De), 1.0);
+      } else {
+        hs_[i] = hsClean_[i];
+      }
+    }
+  }
+}
+
+// Arrangement correction F at the current outlets.
+void SimulatorBatch::updateCorrectionF() {
+  const size_t n = size();
+  switch (cfg_.arrangement) {
+    case FlowArrangement::ShellTube_1_2:
+    case FlowArrangement::ShellTube_2_4:
+      for (size_t i = 0; i < n; ++i) {
+        double F = 1.0;
+        const double dT_in = TinHot_[i] - TinCold_[i];
+        if (dT_in > 1e-3) {
+          const double dTc = std::max(Tc_[i] - TinCold_[i], 1e-6);
+          const double R   = (TinHot_[i] - Th_[i]) / dTc;
+          const double P   = (Tc_[i] - TinCold_[i]) / dT_in;
+          F = Thermo::lmtdCorrectionF(cfg_.arrangement, R, P);
+        }
+        F_[i] = F;
+      }
+      break;
+    case FlowArrangement::ParallelFlow:
+      for (size_t i = 0; i < n; ++i) {
+        const double dT_in = std::max(TinHot_[i] - TinCold_[i], 1e-6);
+        const double F = std::clamp((Th_[i] - Tc_[i]) / dT_in, 0.0, 1.0);
+        F_[i] = std::max(F, 0.5);
+      }
+      break;
+    default:
+      std::fill(F_.begin(), F_.end(), 1.0);
+      break;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// One explicit-Euler step for every lane (see Simulator::stepLumped()).
+// -----------------------------------------------------------------------------
+void SimulatorBatch::step(double t) {
+  const size_t n = size();
+  const double dt = cfg_.dt;
+
+  updateFouling(t);          // pass 1
+  updateShellCoefficient();  // pass 2
+  updateCorrectionF();       // pass 3 — uses the start-of-step outlets
+
+  // Pass 4 — U, duty and energy balance.  Branch-free; masked lanes select
+  // their previous values.
+  double       *Th = Th_.data();
+  double       *Tc = Tc_.data();
+  double       *Qo = Q_.data();
+  double       *Uo = U_.data();
+  double       *rt = rate_.data();
+  std::uint8_t *act = active_.data();
+  for (size_t i = 0; i < n; ++i) {
+    const double RfS  = Rf_[i] * split_[i];
+    const double RfT  = Rf_[i] * (1.0 - split_[i]);
+    const double invU = (1.0 / hs_[i]) + Rw_ + invHtTerm_[i] + RfS + RfT;
+    const double Ut   = 1.0 / std::max(invU, 1e-9);
+    const double Qt   = Ut * A_ * (Th[i] - Tc[i]) * F_[i];
+
+    const double dTh = (Ch_[i] * (TinHot_[i]  - Th[i]) - Qt) / CthH_[i];
+    const double dTc = (Cc_[i] * (TinCold_[i] - Tc[i]) + Qt) / CthC_[i];
+    const double ThN = std::max(0.0, std::min(200.0, Th[i] + dTh * dt));
+    const double TcN = std::max(0.0, std::min(200.0, Tc[i] + dTc * dt));
+
+    const bool on = act[i] != 0 && std::isfinite(Qt);
+    act[i] = on ? 1 : 0;
+    Th[i] = on ? ThN : Th[i];
+    Tc[i] = on ? TcN : Tc[i];
+    Uo[i] = on ? Ut : Uo[i];
+    Qo[i] = on ? std::max(0.0, std::min(1e6, Qt)) : Qo[i];
+    rt[i] = on ? std::max(std::fabs(dTh), std::fabs(dTc)) : 0.0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Direct steady solve (see Simulator::solveSteadyAxial()).  U does not depend
+// on the outlets, so only F is iterated; with F ≡ 1 one sweep is exact.
+// -----------------------------------------------------------------------------
+int SimulatorBatch::solveSteady(double t, int maxIter, double tol) {
+  const size_t n = size();
+  updateFouling(t);
+  updateShellCoefficient();
+  for (size_t i = 0; i < n; ++i) {
+    const double RfS  = Rf_[i] * split_[i];
+    const double RfT  = Rf_[i] * (1.0 - split_[i]);
+    const double invU = (1.0 / hs_[i]) + Rw_ + invHtTerm_[i] + RfS + RfT;
+    U_[i] = 1.0 / std::max(invU, 1e-9);
+  }
+  std::fill(rate_.begin(), rate_.end(), 0.0);
+
+  const bool nonlinear = cfg_.arrangement != FlowArrangement::CounterFlow;
+  int sweeps = 0;
+  for (int it = 0; it < std::max(1, maxIter); ++it) {
+    updateCorrectionF();
+    double residual = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      if (!active_[i]) continue;
+      //  Ch (Tin_h − Th) = kA (Th − Tc) = Cc (Tc − Tin_c)
+      const double kA  = U_[i] * A_ * F_[i];
+      const double Ch  = Ch_[i];
+      const double Cc  = Cc_[i];
+      const double det = Ch * Cc + kA * (Ch + Cc);
+      if (!(det > 1e-12)) {
+        active_[i] = 0;
+        continue;
+      }
+      const double bh = Ch * TinHot_[i];
+      const double bc = Cc * TinCold_[i];
+      const double Th = std::clamp(((Cc + kA) * bh + kA * bc) / det, 0.0, 200.0);
+      const double Tc = std::clamp((kA * bh + (Ch + kA) * bc) / det, 0.0, 200.0);
+      residual = std::max({residual, std::fabs(Th - Th_[i]), std::fabs(Tc - Tc_[i])});
+      Th_[i] = Th;
+      Tc_[i] = Tc;
+      Q_[i]  = std::max(0.0, std::min(1e6, kA * (Th - Tc)));
+    }
+    sweeps = it + 1;
+    if (!nonlinear || residual < tol) break;
+  }
+  return sweeps;
+}
+
+State SimulatorBatch::state(size_t lane) const {
+  State s{};
+  s.Th_out = Th_[lane];
+  s.Tc_out = Tc_[lane];
+  s.Q      = Q_[lane];
+  s.U      = U_[lane];
+  s.Rf     = Rf_[lane];
+
+  // The Hydraulics correlations on the lane's fluids, with no shared scratch,
+  // so concurrent state() calls are safe.
+  const Fluid hot{rhoH_[lane], muH_[lane], cpH_[lane], kH_[lane]};
+  const Fluid cold{rhoC_[lane], muC_[lane], cpC_[lane], kC_[lane]};
+  const double RfS = Rf_[lane] * split_[lane];
+  const double RfT = Rf_[lane] * (1.0 - split_[lane]);
+  s.dP_tube  = tubePressureDrop(g_, hot, mHot_[lane], RfT, kDep_[lane], g_.K_minor_tube);
+  s.dP_shell = shellPressureDrop(g_, bellDelaware_, cfg_.shellMethod, cold, mCold_[lane], RfS,
+                                 kDep_[lane], g_.K_turns_shell);
+  return s;
+}
+
+} // namespace hx
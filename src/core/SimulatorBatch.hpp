@@ -0,0 +1,114 @@
+#pragma once
+
+#include "BellDelaware.hpp"
+#include "Simulator.hpp"
+#include "Types.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace hx {
+
+/**
+ * \brief Lock-step ensemble of lumped exchangers in structure-of-arrays form.
+ *
+ *  Every lane is one exchanger sharing the geometry, shell-side method,
+ *  arrangement and time step of the batch but carrying its own operating
+ *  point, fluid properties and fouling parameters — the shape of a
+ *  Monte-Carlo ensemble.  step() advances all lanes through the same
+ *  explicit-Euler energy balance as Simulator::stepLumped(), organised as a
+ *  few passes over contiguous arrays (fouling → shell-side h → U and energy
+ *  balance).  The gain over one Simulator per trial comes from sharing the
+ *  geometry terms and skipping the per-step bookkeeping, not from SIMD: the
+ *  shell-side pass evaluates the same scalar correlations as Thermo for
+ *  every fouled lane.  Quantities that
+ *  are constant over a run — tube-side h, clean shell-side h, capacity
+ *  rates, wall resistance — are evaluated once per lane in reset().
+ *  solveSteady() skips the transient and solves the same balance at
+ *  dT/dt = 0.
+ *
+ *  The supported regime is the Monte-Carlo trial regime: lumped model,
+ *  explicit Euler, no disturbances, no PID, no scenario and constant
+ *  (Custom, no user table) fluid properties.  supports() checks a SimConfig against it;
+ *  inside that regime every lane reproduces a standalone Simulator.
+ *
+ *  A lane whose heat duty turns non-finite is masked off automatically and
+ *  callers may retire lanes with deactivate().  Masked lanes keep their last
+ *  state; the passes still visit them but discard the result.
+ */
+class SimulatorBatch {
+public:
+  SimulatorBatch(const Geometry &g, const SimConfig &cfg, bool foulingEnabled);
+
+  /** True when \p cfg is inside the regime the batch kernels implement. */
+  static bool supports(const SimConfig &cfg);
+
+  void reserve(size_t n);
+  /** Append one exchanger; returns its lane index.  Call reset() afterwards. */
+  size_t addLane(const OperatingPoint &op, const Fluid &hot, const Fluid &cold,
+                 const FoulingParams &fp);
+  [[nodiscard]] size_t size() const { return mHot_.size(); }
+
+  /** Precompute per-lane invariants and seed every lane like Simulator::reset(). */
+  void reset();
+  /** Advance every active lane from t to t + cfg.dt. */
+  void step(double t);
+  /**
+   * \brief Put every active lane at the steady state of the lumped balance.
+   *
+   *  The batch counterpart of Simulator::solveSteadyAxial() in lumped mode:
+   *  with fouling at Rf(t), each lane solves the 2×2 balance
+   *  Ch (Tin_h − Th) = U·A·F (Th − Tc) = Cc (Tc − Tin_c) in closed form, and
+   *  the outlet-dependent F factor (shell-and-tube, parallel flow) is
+   *  resolved by Picard sweeps until no outlet moves more than \p tol.
+   *  Returns the number of sweeps.
+   */
+  int solveSteady(double t, int maxIter = 50, double tol = 1e-6);
+
+  [[nodiscard]] bool active(size_t lane) const { return active_[lane] != 0; }
+  void deactivate(size_t lane) { active_[lane] = 0; }
+  [[nodiscard]] size_t activeCount() const;
+
+  // Per-lane outputs of the last step (SoA views).
+  [[nodiscard]] const std::vector<double> &Th_out() const { return Th_; }
+  [[nodiscard]] const std::vector<double> &Tc_out() const { return Tc_; }
+  [[nodiscard]] const std::vector<double> &Q() const { return Q_; }
+  [[nodiscard]] const std::vector<double> &U() const { return U_; }
+  /** max(|dTh/dt|, |dTc/dt|) of the last step [K/s]; 0 on masked lanes. */
+  [[nodiscard]] const std::vector<double> &rate() const { return rate_; }
+
+  /** Full State of one lane, pressure drops included (evaluated on demand). */
+  [[nodiscard]] State state(size_t lane) const;
+
+private:
+  void updateFouling(double t);
+  void updateShellCoefficient();
+  void updateCorrectionF();
+
+  Geometry g_;
+  SimConfig cfg_;
+  bool foulingEnabled_;
+  BellDelawarePrecomputed bellDelaware_;
+
+  // --- Inputs (one entry per lane) -----------------------------------------
+  std::vector<double> mHot_, mCold_, TinHot_, TinCold_;
+  std::vector<double> rhoH_, muH_, cpH_, kH_;
+  std::vector<double> rhoC_, muC_, cpC_, kC_;
+  std::vector<double> Rf0_, RfMax_, tau_, alpha_, kDep_, split_;
+  std::vector<std::uint8_t> asymptotic_;
+
+  // --- Invariants resolved in reset() --------------------------------------
+  std::vector<double> invHtTerm_;   // (1/h_tube)·(Di/Do)
+  std::vector<double> hsClean_;     // clean shell-side h
+  std::vector<double> Ch_, Cc_, CthH_, CthC_;   // capacity rates, holdup capacities
+  double Rw_ = 0.0;
+  double A_ = 0.0;
+  bool sharedTau_ = false;
+
+  // --- State ---------------------------------------------------------------
+  std::vector<double> Th_, Tc_, Q_, U_, Rf_, rate_;
+  std::vector<double> hs_;          // scratch: shell-side h of this step
+  std::vector<double> F_;           // scratch: arrangement correction
+  std::vector<std::uint8_t> active_;
+};
+
+} // namespace hx
@@ -0,0 +1,233 @@
+#include "StreamingStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace hx {
+
+// --- RunningMoments ----------------------------------------------------------
+
+void RunningMoments::add(double x) {
+  if (n_ == 0) {
+    min_ = max_ = x;
+  } else {
+    min_ = std::min(min_, x);
+    max_ = std::max(max_, x);
+  }
+  ++n_;
+  const double delta = x - mean_;
+  mean_ += delta / static_cast<double>(n_);
+  m2_ += delta * (x - mean_);
+}
+
+void RunningMoments::merge(const RunningMoments &other) {
+  if (other.n_ == 0) return;
+  if (n_ == 0) {
+    *this = other;
+    return;
+  }
+  const double na = static_cast<double>(n_);
+  const double nb = static_cast<double>(other.n_);
+  const double n = na + nb;
+  const double delta = other.mean_ - mean_;
+  mean_ += delta * nb / n;
+  m2_ += other.m2_ + delta * delta * na * nb / n;
+  n_ += other.n_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+double RunningMoments::variance() const {
+  return n_ > 1 ? m2_ / static_cast<double>(n_ - 1) : 0.0;
+}
+
+double RunningMoments::stddev() const { return std::sqrt(variance()); }
+
+// --- QuantileSketch ----------------------------------------------------------
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+/** Arrivals buffered per unit of compression before a merge pass. */
+constexpr double kBufferFactor = 5.0;
+
+/** k₁ scale function and its inverse for compression δ. */
+double scaleK(double q, double delta) {
+  return delta / (2.0 * kPi) * std::asin(2.0 * std::clamp(q, 0.0, 1.0) - 1.0);
+}
+double scaleQ(double k, double delta) {
+  if (k >= delta / 4.0) return 1.0;
+  return 0.5 * (std::sin(k * 2.0 * kPi / delta) + 1.0);
+}
+
+} // anonymous namespace
+
+QuantileSketch::QuantileSketch(double compression)
+    : compression_(std::max(10.0, compression)) {}
+
+void QuantileSketch::add(double x) {
+  if (!std::isfinite(x)) return;
+  if (count() == 0.0) {
+    min_ = max_ = x;
+  } else {
+    min_ = std::min(min_, x);
+    max_ = std::max(max_, x);
+  }
+  buffer_.push_back({x, 1.0});
+  if (static_cast<double>(buffer_.size()) >= kBufferFactor * compression_) compress();
+}
+
+void QuantileSketch::merge(const QuantileSketch &other) {
+  if (other.count() == 0.0) return;
+  if (count() == 0.0) {
+    min_ = other.min_;
+    max_ = other.max_;
+  } else {
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+  }
+  buffer_.insert(buffer_.end(), other.centroids_.begin(), other.centroids_.end());
+  buffer_.insert(buffer_.end(), other.buffer_.begin(), other.buffer_.end());
+  if (static_cast<double>(buffer_.size()) >= kBufferFactor * compression_) compress();
+}
+
+void QuantileSketch::compress() {
+  if (buffer_.empty()) return;
+  // centroids_ is already sorted: sort only the arrivals and merge.
+  const auto byMean = [](const Centroid &a, const Centroid &b) {
+    return a.mean < b.mean || (a.mean == b.mean && a.weight < b.weight);
+  };
+  std::sort(buffer_.begin(), buffer_.end(), byMean);
+  const auto mid = static_cast<std::ptrdiff_t>(buffer_.size());
+  buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+  std::inplace_merge(buffer_.begin(), buffer_.begin() + mid, buffer_.end(), byMean);
+
+  double total = 0.0;
+  for (const Centroid &c : buffer_) total += c.weight;
+
+  // Greedy merge: a centroid may grow while its right edge stays within one
+  // unit of k from its left edge.
+  centroids_.clear();
+  double before = 0.0;
+  double limit = total * scaleQ(scaleK(0.0, compression_) + 1.0, compression_);
+  Centroid cur = buffer_.front();
+  for (size_t i = 1; i < buffer_.size(); ++i) {
+    const Centroid &c = buffer_[i];
+    if (before + cur.weight + c.weight <= limit) {
+      cur.weight += c.weight;
+      cur.mean += (c.mean - cur.mean) * c.weight / cur.weight;
+    } else {
+      before += cur.weight;
+      centroids_.push_back(cur);
+      limit = total * scaleQ(scaleK(before / total, compression_) + 1.0, compression_);
+      cur = c;
+    }
+  }
+  centroids_.push_back(cur);
+  total_ = total;
+  buffer_.clear();
+}
+
+double QuantileSketch::quantile(double q) const {
+  if (!buffer_.empty()) {
+    QuantileSketch flushed = *this;
+    flushed.compress();
+    return flushed.quantile(q);
+  }
+  if (centroids_.empty()) return std::numeric_limits<double>::quiet_NaN();
+  if (centroids_.size() == 1) return centroids_.front().mean;
+
+  const double idx = std::clamp(q, 0.0, 1.0) * total_;
+  const Centroid &first = centroids_.front();
+  const Centroid &last  = centroids_.back();
+  if (idx < 0.5 * first.weight) {
+    return min_ + (first.mean - min_) * idx / (0.5 * first.weight);
+  }
+  double cum = 0.0;
+  for (size_t i = 0; i + 1 < centroids_.size(); ++i) {
+    const Centroid &a = centroids_[i];
+    const Centroid &b = centroids_[i + 1];
+    const double left  = cum + 0.5 * a.weight;
+    const double right = cum + a.weight + 0.5 * b.weight;
+    if (idx < right) return a.mean + (b.mean - a.mean) * (idx - left) / (right - left);
+    cum += a.weight;
+  }
+  const double center = total_ - 0.5 * last.weight;
+  return last.mean + (max_ - last.mean) * std::min(1.0, (idx - center) / (0.5 * last.weight));
+}
+
+// --- StreamingHistogram ------------------------------------------------------
+
+namespace {
+
+constexpr double kInitialWidth = 0x1p-20;
+
+std::int64_t floorHalve(std::int64_t i) { return i >= 0 ? i / 2 : -((1 - i) / 2); }
+
+} // anonymous namespace
+
+StreamingHistogram::StreamingHistogram(size_t maxBins)
+    : maxBins_(std::max<size_t>(2, maxBins)), width_(kInitialWidth) {}
+
+std::int64_t StreamingHistogram::binIndex(double x) const {
+  return static_cast<std::int64_t>(std::floor(x / width_));
+}
+
+void StreamingHistogram::widen() {
+  if (counts_.empty()) {
+    width_ *= 2.0;
+    return;
+  }
+  const std::int64_t newBase = floorHalve(base_);
+  const std::int64_t top = base_ + static_cast<std::int64_t>(counts_.size()) - 1;
+  std::vector<std::uint64_t> merged(static_cast<size_t>(floorHalve(top) - newBase + 1), 0);
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    merged[static_cast<size_t>(floorHalve(base_ + static_cast<std::int64_t>(i)) - newBase)] += counts_[i];
+  }
+  counts_.swap(merged);
+  base_ = newBase;
+  width_ *= 2.0;
+}
+
+void StreamingHistogram::place(std::int64_t idx, std::uint64_t count) {
+  if (counts_.empty()) {
+    base_ = idx;
+    counts_.assign(1, count);
+    return;
+  }
+  for (;;) {
+    const std::int64_t top = base_ + static_cast<std::int64_t>(counts_.size()) - 1;
+    const std::int64_t lo = std::min(base_, idx);
+    const std::int64_t hi = std::max(top, idx);
+    if (static_cast<std::uint64_t>(hi - lo) < maxBins_) break;
+    widen();
+    idx = floorHalve(idx);
+  }
+  if (idx < base_) {
+    counts_.insert(counts_.begin(), static_cast<size_t>(base_ - idx), 0);
+    base_ = idx;
+  } else if (idx >= base_ + static_cast<std::int64_t>(counts_.size())) {
+    counts_.resize(static_cast<size_t>(idx - base_ + 1), 0);
+  }
+  counts_[static_cast<size_t>(idx - base_)] += count;
+}
+
+void StreamingHistogram::add(double x) {
+  if (!std::isfinite(x)) return;
+  while (std::fabs(x) / width_ > 0x1p52) widen();  // keep the index exact
+  place(binIndex(x), 1);
+}
+
+void StreamingHistogram::merge(const StreamingHistogram &other) {
+  if (other.counts_.empty()) return;
+  while (width_ < other.width_) widen();
+  for (size_t i = 0; i < other.counts_.size(); ++i) {
+    if (other.counts_[i] == 0) continue;
+    std::int64_t idx = other.base_ + static_cast<std::int64_t>(i);
+    for (double w = other.width_; w < width_; w *= 2.0) idx = floorHalve(idx);
+    place(idx, other.counts_[i]);
+  }
+}
+
+} // namespace hx
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hx {
+
+/**
+ * \brief Count, mean, variance, min and max in O(1) memory (Welford).
+ *
+ *  merge() combines two accumulators with Chan et al.'s pairwise update,
+ *  so per-thread partial results can be reduced at the end.  The result is
+ *  deterministic for a fixed add / merge order.
+ */
+class RunningMoments {
+public:
+  void add(double x);
+  void merge(const RunningMoments &other);
+
+  [[nodiscard]] std::uint64_t count() const { return n_; }
+  [[nodiscard]] double mean() const { return mean_; }
+  /** Sample variance (n − 1 denominator); 0 below two samples. */
+  [[nodiscard]] double variance() const;
+  [[nodiscard]] double stddev() const;
+  [[nodiscard]] double min() const { return min_; }
+  [[nodiscard]] double max() const { return max_; }
+
+private:
+  std::uint64_t n_ = 0;
+  double mean_ = 0.0;
+  double m2_   = 0.0;
+  double min_  = 0.0;
+  double max_  = 0.0;
+};
+
+/**
+ * \brief Mergeable t-digest quantile sketch (Dunning & Ertl, merging variant).
+ *
+ *  Keeps at most about \c compression centroids, sized by the k₁ (arcsine)
+ *  scale function so the tails stay resolved: p5 / p95 come out to a
+ *  fraction of a percent of rank error in a few kilobytes, regardless of
+ *  how many values were added.
+ */
+class QuantileSketch {
+public:
+  explicit QuantileSketch(double compression = 100.0);
+
+  void add(double x);
+  void merge(const QuantileSketch &other);
+
+  [[nodiscard]] double count() const { return total_ + static_cast<double>(buffer_.size()); }
+  /** Estimated q-quantile, q in [0, 1]; NaN when empty. */
+  [[nodiscard]] double quantile(double q) const;
+  /** Centroids currently held (after compression). */
+  [[nodiscard]] size_t centroidCount() const { return centroids_.size(); }
+
+private:
+  struct Centroid {
+    double mean;
+    double weight;
+  };
+  void compress();
+
+  double compression_;
+  std::vector<Centroid> centroids_;  // sorted by mean
+  std::vector<Centroid> buffer_;     // unmerged arrivals
+  double total_ = 0.0;               // weight in centroids_
+  double min_ = 0.0;
+  double max_ = 0.0;
+};
+
+/**
+ * \brief Fixed-bin-count histogram whose bin width adapts by doubling.
+ *
+ *  Bins are [i·w, (i+1)·w) for power-of-two widths w anchored at zero; when
+ *  the data stop fitting in \c maxBins bins, neighbouring pairs merge and w
+ *  doubles.  Counts are exact, and the final state depends only on the
+ *  values added — not on how partial histograms were merged.
+ */
+class StreamingHistogram {
+public:
+  explicit StreamingHistogram(size_t maxBins = 64);
+
+  void add(double x);
+  void merge(const StreamingHistogram &other);
+
+  [[nodiscard]] bool empty() const { return counts_.empty(); }
+  [[nodiscard]] double binWidth() const { return width_; }
+  /** Lower edge of bin 0. */
+  [[nodiscard]] double lowerEdge() const { return static_cast<double>(base_) * width_; }
+  [[nodiscard]] const std::vector<std::uint64_t> &counts() const { return counts_; }
+
+private:
+  std::int64_t binIndex(double x) const;
+  void widen();
+  void place(std::int64_t idx, std::uint64_t count);
+
+  size_t maxBins_;
+  double width_;
+  std::int64_t base_ = 0;              // bin index of counts_[0]
+  std::vector<std::uint64_t> counts_;
+};
+
+} // namespace hx
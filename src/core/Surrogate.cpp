@@ -0,0 +1,383 @@
+#include "Surrogate.hpp"
+#include "QuasiRandom.hpp"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace hx {
+
+namespace {
+
+/** Outputs fitted, in Surrogate::outputs order. */
+constexpr size_t kOutputs = 6;
+const char *const kOutputNames[kOutputs] = {"Q", "U", "Tc_out", "Th_out", "dP_tube", "dP_shell"};
+
+double outputValue(const State &s, size_t o) {
+  switch (o) {
+    case 0:  return s.Q;
+    case 1:  return s.U;
+    case 2:  return s.Tc_out;
+    case 3:  return s.Th_out;
+    case 4:  return s.dP_tube;
+    default: return s.dP_shell;
+  }
+}
+
+/** Highest polynomial degree built or loaded; bounds the Hermite table of predict(). */
+constexpr int kMaxDegree = 10;
+constexpr size_t kMaxInputs = SobolSampler::kMaxDims;
+
+/**
+ * Multi-indices (row-major, \p dims per term) of the Hermite basis with total
+ * degree ≤ \p degree and q-norm ≤ \p degree, graded by total degree so the
+ * constant comes first.
+ */
+std::vector<std::uint8_t> hyperbolicBasis(size_t dims, int degree, double q) {
+  std::vector<std::uint8_t> out;
+  std::vector<std::uint8_t> alpha(dims, 0);
+  const double limit = std::pow(static_cast<double>(degree), q) * (1.0 + 1e-9);
+  std::function<void(size_t, int, double)> fill = [&](size_t d, int remaining, double qSum) {
+    if (d + 1 == dims) {
+      const double last = remaining > 0 ? std::pow(static_cast<double>(remaining), q) : 0.0;
+      if (qSum + last > limit) return;
+      alpha[d] = static_cast<std::uint8_t>(remaining);
+      out.insert(out.end(), alpha.begin(), alpha.end());
+      return;
+    }
+    for (int a = remaining; a >= 0; --a) {
+      const double term = a > 0 ? std::pow(static_cast<double>(a), q) : 0.0;
+      if (qSum + term > limit) continue;
+      alpha[d] = static_cast<std::uint8_t>(a);
+      fill(d + 1, remaining - a, qSum + term);
+    }
+    alpha[d] = 0;
+  };
+  for (int total = 0; total <= degree; ++total) fill(0, total, 0.0);
+  return out;
+}
+
+/**
+ * Orthonormal Hermite polynomials ψ_0 .. ψ_degree of every input:
+ * psi[d·(degree + 1) + k] = He_k(z_d)/√k!, from
+ * ψ_{k+1} = (z·ψ_k − √k·ψ_{k−1}) / √(k + 1).
+ */
+void hermiteTable(const double *z, size_t dims, int degree, double *psi) {
+  const size_t stride = static_cast<size_t>(degree) + 1;
+  for (size_t d = 0; d < dims; ++d) {
+    double *p = &psi[d * stride];
+    p[0] = 1.0;
+    if (degree >= 1) p[1] = z[d];
+    for (int k = 1; k < degree; ++k) {
+      const auto kk = static_cast<size_t>(k);
+      p[kk + 1] = (z[d] * p[kk] - std::sqrt(static_cast<double>(k)) * p[kk - 1]) /
+                  std::sqrt(static_cast<double>(k + 1));
+    }
+  }
+}
+
+/** ψ_α(z) of the term at \p alpha from a hermiteTable() of the given \p degree. */
+double basisTerm(const std::uint8_t *alpha, size_t dims, int degree, const double *psi) {
+  const size_t stride = static_cast<size_t>(degree) + 1;
+  double v = 1.0;
+  for (size_t d = 0; d < dims; ++d) {
+    if (alpha[d] != 0) v *= psi[d * stride + alpha[d]];
+  }
+  return v;
+}
+
+} // anonymous namespace
+
+double PolynomialChaos::variance() const {
+  double v = 0.0;
+  for (size_t t = 1; t < coefficients.size(); ++t) v += coefficients[t] * coefficients[t];
+  return v;
+}
+
+void Surrogate::predict(const double *z, double *y) const {
+  const size_t dims = inputCount();
+  int degree = 0;
+  for (const PolynomialChaos &pc : outputs) degree = std::max(degree, pc.degree);
+  double psi[kMaxInputs * (kMaxDegree + 1)];
+  hermiteTable(z, dims, degree, psi);
+  for (size_t o = 0; o < outputs.size(); ++o) {
+    const PolynomialChaos &pc = outputs[o];
+    double sum = 0.0;
+    for (size_t t = 0; t < pc.coefficients.size(); ++t) {
+      sum += pc.coefficients[t] * basisTerm(&pc.indices[t * dims], dims, degree, psi);
+    }
+    y[o] = sum;
+  }
+}
+
+std::vector<double> Surrogate::whatIf(const std::vector<double> &change) const {
+  std::vector<double> z(inputCount(), 0.0);
+  for (size_t i = 0; i < z.size() && i < change.size(); ++i) {
+    z[i] = inputSigma[i] > 0.0 ? change[i] / inputSigma[i] : 0.0;
+  }
+  std::vector<double> y(outputs.size());
+  predict(z.data(), y.data());
+  return y;
+}
+
+SobolIndices Surrogate::sobol(size_t o) const {
+  const PolynomialChaos &pc = outputs[o];
+  const size_t dims = inputCount();
+  SobolIndices si;
+  si.output   = pc.output;
+  si.variance = pc.variance();
+  si.index.assign(dims, SobolIndex{});
+  if (si.variance <= 0.0) return si;
+  for (size_t t = 1; t < pc.coefficients.size(); ++t) {
+    const std::uint8_t *alpha = &pc.indices[t * dims];
+    const double share = pc.coefficients[t] * pc.coefficients[t] / si.variance;
+    size_t active = 0;
+    for (size_t d = 0; d < dims; ++d) active += alpha[d] != 0 ? 1 : 0;
+    for (size_t d = 0; d < dims; ++d) {
+      if (alpha[d] == 0) continue;
+      si.index[d].total += share;
+      if (active == 1) si.index[d].first += share;
+    }
+  }
+  for (SobolIndex &x : si.index) {
+    x.firstLo = x.firstHi = x.first;
+    x.totalLo = x.totalHi = x.total;
+  }
+  return si;
+}
+
+SurrogateResult buildSurrogate(const OperatingPoint &op0,
+                               const Geometry       &geom,
+                               const Fluid          &hot,
+                               const Fluid          &cold,
+                               const FoulingParams  &fp,
+                               const SimConfig      &baseCfg,
+                               const MonteCarloSettings &mc,
+                               const SurrogateSettings  &ss,
+                               MonteCarloControl    *control) {
+  SurrogateResult r;
+  const size_t dims = perturbedInputCount(mc);
+  const size_t n = static_cast<size_t>(std::max(ss.trials, 16));
+  const int maxDegree = std::clamp(ss.maxDegree, 1, kMaxDegree);
+  const double q = std::clamp(ss.qNorm, 0.1, 1.0);
+
+  // === Design of experiments: scrambled Sobol' points mapped to normals ===
+  const SobolSampler sampler(dims, mc.seed);
+  std::vector<double> z(n * dims);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t d = 0; d < dims; ++d) {
+      z[i * dims + d] = inverseNormalCdf(sampler.at(static_cast<std::uint32_t>(i), d));
+    }
+  }
+  MonteCarloControl localControl;
+  MonteCarloControl &ctl = control ? *control : localControl;
+  ctl.done.store(0);
+  ctl.total.store(static_cast<int>(n));
+  const std::vector<State> states =
+      evaluatePerturbations(op0, geom, hot, cold, fp, baseCfg, mc, z, &ctl);
+  if (states.empty()) {
+    r.message = "Cancelled.";
+    return r;
+  }
+  const auto rows = static_cast<Eigen::Index>(n);
+  Eigen::MatrixXd Y(rows, static_cast<Eigen::Index>(kOutputs));
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t o = 0; o < kOutputs; ++o) {
+      Y(static_cast<Eigen::Index>(i), static_cast<Eigen::Index>(o)) = outputValue(states[i], o);
+    }
+  }
+
+  Surrogate &model = r.model;
+  model.trainingTrials = static_cast<int>(n);
+  for (size_t i = 0; i < dims; ++i) {
+    model.inputNames.emplace_back(perturbedInputName(i));
+    model.inputSigma.push_back(perturbedInputSigma(mc, i));
+  }
+  model.outputs.resize(kOutputs);
+  std::vector<double> variance(kOutputs);
+  for (size_t o = 0; o < kOutputs; ++o) {
+    model.outputs[o].output   = kOutputNames[o];
+    model.outputs[o].looError = std::numeric_limits<double>::infinity();
+    const auto col = Y.col(static_cast<Eigen::Index>(o));
+    variance[o] = (col.array() - col.mean()).square().sum() / static_cast<double>(n - 1);
+  }
+
+  // === Least squares and leave-one-out error per candidate degree ===
+  std::vector<double> psi(kMaxInputs * (kMaxDegree + 1));
+  for (int degree = 1; degree <= maxDegree; ++degree) {
+    const std::vector<std::uint8_t> basis = hyperbolicBasis(dims, degree, q);
+    const size_t terms = basis.size() / dims;
+    if (2 * terms > n) break;   // too few trials to fit (and cross-check) this basis
+    const auto cols = static_cast<Eigen::Index>(terms);
+    Eigen::MatrixXd A(rows, cols);
+    for (size_t i = 0; i < n; ++i) {
+      hermiteTable(&z[i * dims], dims, degree, psi.data());
+      for (size_t t = 0; t < terms; ++t) {
+        A(static_cast<Eigen::Index>(i), static_cast<Eigen::Index>(t)) =
+            basisTerm(&basis[t * dims], dims, degree, psi.data());
+      }
+    }
+    const Eigen::HouseholderQR<Eigen::MatrixXd> qr(A);
+    const Eigen::MatrixXd C = qr.solve(Y);
+    const Eigen::MatrixXd Qthin = qr.householderQ() * Eigen::MatrixXd::Identity(rows, cols);
+    const Eigen::VectorXd leverage = Qthin.rowwise().squaredNorm();
+    const Eigen::MatrixXd residual = Y - A * C;
+    for (size_t o = 0; o < kOutputs; ++o) {
+      const auto oo = static_cast<Eigen::Index>(o);
+      double loo = 0.0;
+      for (Eigen::Index i = 0; i < rows; ++i) {
+        const double e = residual(i, oo) / std::max(1.0 - leverage(i), 1e-12);
+        loo += e * e;
+      }
+      loo /= static_cast<double>(n);
+      const double err = variance[o] > 0.0 ? loo / variance[o] : 0.0;
+      PolynomialChaos &pc = model.outputs[o];
+      if (err < pc.looError) {
+        pc.degree   = degree;
+        pc.indices  = basis;
+        pc.looError = err;
+        pc.coefficients.assign(C.col(oo).data(), C.col(oo).data() + terms);
+      }
+    }
+  }
+  if (model.outputs[0].coefficients.empty()) {
+    r.model = Surrogate{};
+    r.message = "Too few trials for even a linear surrogate.";
+    return r;
+  }
+
+  size_t worst = 0;
+  for (size_t o = 1; o < kOutputs; ++o) {
+    if (model.outputs[o].looError > model.outputs[worst].looError) worst = o;
+  }
+  const PolynomialChaos &w = model.outputs[worst];
+  r.ok = true;
+  char buf[256];
+  std::snprintf(buf, sizeof(buf),
+                "Polynomial-chaos surrogate from %d trials. Leave-one-out error is at most "
+                "%.2g %% of the variance (%s, degree %d, %zu terms).",
+                model.trainingTrials, 100.0 * w.looError, w.output.c_str(), w.degree,
+                w.coefficients.size());
+  r.message = buf;
+  return r;
+}
+
+bool saveSurrogate(const Surrogate &model, const std::string &path, std::string *message) {
+  std::ofstream out(path);
+  if (!out) {
+    if (message) *message = "Cannot write " + path;
+    return false;
+  }
+  const size_t dims = model.inputCount();
+  out << "# HX polynomial-chaos surrogate\n"
+      << "hxsurrogate 1 " << model.trainingTrials << '\n'
+      << std::setprecision(17);
+  for (size_t i = 0; i < dims; ++i) {
+    out << "input " << model.inputSigma[i] << ' ' << model.inputNames[i] << '\n';
+  }
+  for (const PolynomialChaos &pc : model.outputs) {
+    out << "output " << pc.output << ' ' << pc.degree << ' ' << pc.coefficients.size() << ' '
+        << pc.looError << '\n';
+    for (size_t t = 0; t < pc.coefficients.size(); ++t) {
+      for (size_t d = 0; d < dims; ++d) out << static_cast<int>(pc.indices[t * dims + d]) << ' ';
+      out << pc.coefficients[t] << '\n';
+    }
+  }
+  out.flush();
+  if (!out) {
+    if (message) *message = "Error writing " + path;
+    return false;
+  }
+  if (message) *message = "Saved surrogate to " + path;
+  return true;
+}
+
+SurrogateResult loadSurrogate(const std::string &path) {
+  SurrogateResult r;
+  std::ifstream in(path);
+  if (!in) {
+    r.message = "Cannot open " + path;
+    return r;
+  }
+
+  Surrogate &model = r.model;
+  std::string line;
+  int lineNo = 0;
+  bool headerSeen = false;
+  size_t pendingTerms = 0;   // rows still due for the last output
+  auto fail = [&](const std::string &why) {
+    r.model = Surrogate{};
+    r.message = path + ":" + std::to_string(lineNo) + ": " + why;
+    return r;
+  };
+  while (std::getline(in, line)) {
+    ++lineNo;
+    const size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#') continue;
+    std::istringstream row(line);
+
+    if (pendingTerms > 0) {
+      PolynomialChaos &pc = model.outputs.back();
+      const size_t dims = model.inputCount();
+      int total = 0;
+      for (size_t d = 0; d < dims; ++d) {
+        int a = -1;
+        if (!(row >> a) || a < 0 || a > pc.degree) return fail("bad multi-index");
+        total += a;
+        pc.indices.push_back(static_cast<std::uint8_t>(a));
+      }
+      double c = 0.0;
+      if (total > pc.degree || !(row >> c) || !std::isfinite(c)) return fail("bad term");
+      pc.coefficients.push_back(c);
+      --pendingTerms;
+      continue;
+    }
+
+    std::string key;
+    row >> key;
+    if (!headerSeen) {
+      int version = 0;
+      if (key != "hxsurrogate" || !(row >> version >> model.trainingTrials) || version != 1) {
+        return fail("not a version-1 surrogate file");
+      }
+      headerSeen = true;
+    } else if (key == "input") {
+      double sigma = 0.0;
+      std::string name;
+      if (!model.outputs.empty() || !(row >> sigma) || !(row >> std::ws) || !std::getline(row, name)) {
+        return fail("bad input line");
+      }
+      if (name.size() > 0 && name.back() == '\r') name.pop_back();
+      if (model.inputCount() == kMaxInputs) return fail("too many inputs");
+      model.inputSigma.push_back(sigma);
+      model.inputNames.push_back(name);
+    } else if (key == "output") {
+      PolynomialChaos pc;
+      size_t terms = 0;
+      if (!(row >> pc.output >> pc.degree >> terms >> pc.looError) || pc.degree < 0 ||
+          pc.degree > kMaxDegree || terms == 0 || model.inputNames.empty()) {
+        return fail("bad output line");
+      }
+      model.outputs.push_back(std::move(pc));
+      pendingTerms = terms;
+    } else {
+      return fail("unknown record '" + key + "'");
+    }
+  }
+  if (pendingTerms > 0) return fail("file ends inside an expansion");
+  if (model.outputs.empty()) return fail("no outputs");
+
+  r.ok = true;
+  r.message = "Loaded surrogate (" + std::to_string(model.outputs.size()) + " outputs, " +
+              std::to_string(model.inputCount()) + " inputs) from " + path;
+  return r;
+}
+
+} // namespace hx
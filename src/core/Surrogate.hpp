@@ -0,0 +1,107 @@
+#pragma once
+
+#include "MonteCarlo.hpp"
+#include "Types.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hx {
+
+/** \brief Polynomial-chaos build settings.
+ *
+ *  Candidate bases hold the Hermite terms ψ_α(z) = Π He_αi(z_i)/√(αi!) with
+ *  total degree ≤ p and hyperbolic q-norm (Σ αi^q)^(1/q) ≤ p, for p = 1 ..
+ *  \c maxDegree.  q < 1 drops most high-order interactions, keeping the
+ *  basis sparse (287 terms at p = 4 over 13 inputs instead of 2380); each
+ *  output keeps the degree with the smallest leave-one-out error.
+ */
+struct SurrogateSettings {
+  int    trials    = 1024;   // design of experiments; a power of two balances the Sobol' design
+  int    maxDegree = 4;
+  double qNorm     = 0.75;   // 1 = full total-degree basis
+};
+
+/** \brief Polynomial-chaos expansion of one output in the standard-normal inputs. */
+struct PolynomialChaos {
+  std::string               output;        // "Q", "U", "Tc_out", "Th_out", "dP_tube", "dP_shell"
+  int                       degree = 0;
+  std::vector<std::uint8_t> indices;       // multi-index α of term t at [t·dims, (t+1)·dims)
+  std::vector<double>       coefficients;  // one per term; term 0 is the constant
+  double                    looError = 0.0;   // leave-one-out error relative to the output variance
+
+  [[nodiscard]] double mean() const { return coefficients.empty() ? 0.0 : coefficients[0]; }
+  /** Variance of the output: the sum of the squared non-constant coefficients. */
+  [[nodiscard]] double variance() const;
+};
+
+/**
+ * \brief Surrogate of the Monte-Carlo trial model around one nominal case.
+ *
+ *  Input i is standard normal z_i; the trial perturbs its plant input by
+ *  z_i·inputSigma[i] (see MonteCarloSettings).  Outputs are those of the
+ *  trial State: Q, U, Tc_out, Th_out, dP_tube, dP_shell.
+ */
+struct Surrogate {
+  std::vector<std::string>     inputNames;
+  std::vector<double>          inputSigma;   // fraction of nominal, or K for inlet temperatures
+  std::vector<PolynomialChaos> outputs;
+  int                          trainingTrials = 0;
+
+  [[nodiscard]] bool empty() const { return outputs.empty(); }
+  [[nodiscard]] size_t inputCount() const { return inputNames.size(); }
+
+  /** Outputs at the standard-normal inputs \p z (inputCount() of them) into \p y (outputs.size()). */
+  void predict(const double *z, double *y) const;
+
+  /**
+   * Outputs for a what-if: input i changed by \p change[i], a fraction of
+   * nominal (−0.08: 8 % less flow) or kelvin for the inlet temperatures.
+   * Missing trailing entries mean no change.
+   */
+  [[nodiscard]] std::vector<double> whatIf(const std::vector<double> &change) const;
+
+  /** Sobol' indices of output \p o straight from its coefficients (no CIs). */
+  [[nodiscard]] SobolIndices sobol(size_t o) const;
+};
+
+/** \brief Result of buildSurrogate() / loadSurrogate(). */
+struct SurrogateResult {
+  bool        ok = false;
+  std::string message;
+  Surrogate   model;
+};
+
+/**
+ * \brief Fit a polynomial-chaos surrogate of the runMonteCarlo() trial model.
+ *
+ *  The design of experiments is an Owen-scrambled Sobol' sample of
+ *  \p ss.trials points (keyed by mc.seed) mapped through Φ⁻¹ and run through
+ *  evaluatePerturbations(), so it uses the solver, horizon, σ's and worker
+ *  count of \p mc.  Every candidate basis is fitted by least squares (Eigen
+ *  Householder QR, all outputs at once); the leave-one-out residuals come
+ *  from the diagonal of the hat matrix without refitting.  \p control
+ *  reports trials done and may cancel.
+ */
+SurrogateResult buildSurrogate(const OperatingPoint &op0,
+                               const Geometry       &geom,
+                               const Fluid          &hot,
+                               const Fluid          &cold,
+                               const FoulingParams  &fp,
+                               const SimConfig      &baseCfg,
+                               const MonteCarloSettings &mc,
+                               const SurrogateSettings  &ss,
+                               MonteCarloControl    *control = nullptr);
+
+/**
+ * \brief Write \p model as text: a header, one line per input and, per
+ *  output, its terms as "α_1 … α_dims coefficient" rows.  Coefficients are
+ *  printed round-trip exact.  Returns false (and a reason in \p message)
+ *  when the file cannot be written.
+ */
+bool saveSurrogate(const Surrogate &model, const std::string &path, std::string *message = nullptr);
+
+/** Read a model written by saveSurrogate(). */
+SurrogateResult loadSurrogate(const std::string &path);
+
+} // namespace hx
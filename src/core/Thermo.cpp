@@ -1,194 +1,78 @@
 #include "Thermo.hpp"
-#include "BellDelaware.hpp"
+
+#include "Correlations.hpp"
 
 #include <algorithm>
 #include <cmath>
 
 namespace hx {
 
-static constexpr double PI = 3.14159265358979323846;
-
-Thermo::Thermo(const Geometry &g, const Fluid &hot, const Fluid &cold) : g_(g), hot_(hot), cold_(cold) {}
-
-static double tube_cross_section(double Di) { return PI * (Di * Di) / 4.0; }
-
-static double reynolds(double m_dot, double rho, double mu, double D, int nTubes) {
-  const double A = tube_cross_section(D) * std::max(1, nTubes);
-  const double v = (m_dot / rho) / A; // bulk velocity per tube if single tube; approximate per bundle
-  return rho * v * D / mu;
+Thermo::Thermo(const Geometry &g, const Fluid &hot, const Fluid &cold) :
+    g_(g), hot_(hot), cold_(cold), bellDelaware_(g) {
+  // Cylindrical wall resistance: R_wall = ln(Do/Di) / (2*pi*k_wall*L*N_tubes)
+  // Per unit outer area: R_wall = ln(Do/Di) * Do / (2*k_wall)
+  // CORRECTED FORMULA: Removed erroneous division by Di
+  // Note: wall_thickness is implicitly used via Do and Di (Do = Di + 2*wall_thickness)
+  Rw_ = wallResistanceOf<double>(g_);
 }
 
-static double prandtl(double cp, double mu, double k) { return cp * mu / k; }
+// The correlations themselves are templated on the scalar type
+// (Correlations.hpp); the members below are their double instances.
 
 double Thermo::h_tube(double m_dot_hot) const {
   // Use Dittus–Boelter for turbulent, laminar fallback Nu=4.36
   // Tube side now carries HOT fluid per report (Section 3.4, 6.1.1)
-  const double Re = reynolds(m_dot_hot, hot_.rho, hot_.mu, g_.Di, g_.nTubes);
-  const double Pr = prandtl(hot_.cp, hot_.mu, hot_.k);
-  double Nu;
-  if (Re < 2300.0) {
-    Nu = 4.36; // constant wall temperature
-  } else {
-    // Dittus-Boelter: n=0.4 for heating (fluid being heated), n=0.3 for cooling
-    // Report Section 3.5.1 states: "In this work, the heating case is assumed on the tube side, so n=0.4."
-    // Although physically the hot fluid is being cooled (n=0.3), we follow the report text strictly.
-    const double n = 0.4;
-    Nu = 0.023 * std::pow(Re, 0.8) * std::pow(Pr, n);
-  }
-  return Nu * hot_.k / g_.Di;
+  // Dittus-Boelter: n=0.4 for heating (fluid being heated), n=0.3 for cooling
+  // Report Section 3.5.1 states: "In this work, the heating case is assumed on the tube side, so n=0.4."
+  // Although physically the hot fluid is being cooled (n=0.3), we follow the report text strictly.
+  return tubeCoefficient(g_, hot_, m_dot_hot);
 }
 
 double Thermo::h_shell(double m_dot_cold) const {
-  if (shellMethod_ == ShellSideMethod::BellDelaware) {
-    // Bell–Delaware: ideal crossflow modified by Jc (baffle-cut),
-    // Jl (leakage), Jb (bypass), Js (spacing), Jr (laminar).
-    return computeBellDelaware(g_, cold_, m_dot_cold, 0.0, 0.5).h_shell;
-  }
-  // --- Legacy Kern-style (Zhukauskas) correlation --------------------------
-  // Zhukauskas tube-bank correlation for shell-side cross-flow
-  // Shell side now carries COLD fluid per report
-  // Note: For dynamic simulation with fouling, effective diameter should be passed
-  // Here we use the clean geometry; fouling effects handled in overall U calculation
-  const double De = g_.shellID - g_.Do; // crude gap estimate (clean)
-  // Correct Shell-Side Area Calculation (Kern Method)
-  // As = (Ds / Pt) * (Pt - Do) * B
-  const double As = (g_.shellID / std::max(g_.pitch, 1e-6)) * (g_.pitch - g_.Do) * g_.baffleSpacing;
-  
-  const double v = (m_dot_cold / cold_.rho) / std::max(As, 1e-6);
-  const double Re = cold_.rho * v * std::max(De, 1e-6) / cold_.mu;
-  const double Pr = prandtl(cold_.cp, cold_.mu, cold_.k);
-  
-  // Zhukauskas correlation: Nu = C * Re^m * Pr^n * (Pr/Pr_w)^0.25
-  // For typical range, using C=0.27, m=0.63, n=0.37 (upper range value)
-  const double C = 0.27;
-  const double m = 0.63;
-  const double n = 0.37; // Using 0.37 per document (n ≈ 0.36-0.37)
-  
-  // Viscosity-ratio correction term: (Pr/Pr_w)^0.25
-  // Document: "The Zhukauskas correlation includes (Pr/Pr_w)^0.25. The code approximates
-  // this term as 1.0, which is acceptable for moderate temperature differences but could
-  // be refined if necessary."
-  //
-  // To refine: evaluate hot fluid properties at wall temperature T_w, compute Pr_w,
-  // then use: Pr_ratio = std::pow(Pr / Pr_w, 0.25)
+  // Bell–Delaware: ideal crossflow modified by Jc (baffle-cut), Jl (leakage),
+  // Jb (bypass), Js (spacing), Jr (laminar).  Kern: Zhukauskas tube-bank
+  // correlation on the clean equivalent diameter; fouling effects are handled
+  // in the overall U calculation.
   //
-  // Current approximation: Pr/Pr_w ≈ 1.0 (valid for ΔT < 30-40°C)
-  const double Pr_ratio = 1.0; // (Pr/Pr_w)^0.25, approximated as 1.0
-  
-  const double Nu = C * std::pow(std::max(Re, 1.0), m) * std::pow(Pr, n) * Pr_ratio;
-  // Use effective diameter for heat transfer coefficient calculation if provided
-  // Note: h is based on the diameter used in Re
-  return Nu * cold_.k / std::max(De, 1e-6);
+  // The Zhukauskas (Pr/Pr_w)^0.25 term is approximated as 1.0, which is
+  // acceptable for moderate temperature differences (ΔT < 30-40°C).  To
+  // refine: evaluate properties at the wall temperature T_w, compute Pr_w and
+  // use std::pow(Pr / Pr_w, 0.25).
+  return shellCoefficient(g_, bellDelaware_, shellMethod_, cold_, m_dot_cold, 0.0, 0.5);
 }
 
 // Helper function to compute effective shell-side equivalent diameter with fouling
 double Thermo::De_effective(double Rf_shell, double k_deposit) const {
-  // Convert fouling resistance to deposit thickness: δ = R_f * k_deposit
-  // Use the provided k_deposit (configurable)
-  const double delta_shell = Rf_shell * k_deposit;
-  
-  // Adjust equivalent diameter: De_eff = (shellID - 2*delta_shell) - Do
-  // Fouling on tube exterior reduces the effective gap
-  const double De_clean = g_.shellID - g_.Do;
-  const double De_eff = std::max(1e-6, De_clean - 2.0 * delta_shell);
-  return De_eff;
+  // Convert fouling resistance to deposit thickness: δ = R_f * k_deposit and
+  // adjust equivalent diameter: De_eff = (shellID - 2*delta_shell) - Do
+  // (fouling on tube exterior reduces the effective gap).
+  return kernEquivalentDiameter(g_, Rf_shell, k_deposit);
 }
 
 double Thermo::h_shell_with_fouling(double m_dot_cold, double Rf_shell, double k_deposit) const {
-  if (shellMethod_ == ShellSideMethod::BellDelaware) {
-    return computeBellDelaware(g_, cold_, m_dot_cold, Rf_shell, k_deposit).h_shell;
-  }
-  // --- Legacy Kern-style (Zhukauskas) correlation with fouling -------------
-  // Zhukauskas tube-bank correlation with effective diameter for fouling
-  const double De_eff = De_effective(Rf_shell, k_deposit);
-  // Correct Shell-Side Area Calculation (Kern Method)
-  // As = (Ds / Pt) * (Pt - Do) * B
-  // This replaces the simplified PI*Ds*B formula which was incorrect
-  const double As = (g_.shellID / std::max(g_.pitch, 1e-6)) * (g_.pitch - g_.Do) * g_.baffleSpacing;
-  
-  const double v = (m_dot_cold / cold_.rho) / std::max(As, 1e-6);
-  const double Re = cold_.rho * v * De_eff / cold_.mu;
-  const double Pr = prandtl(cold_.cp, cold_.mu, cold_.k);
-  
-  const double C = 0.27;
-  const double m = 0.63;
-  const double n = 0.37;
-  
-  // Viscosity-ratio correction: (Pr/Pr_w)^0.25 ≈ 1.0 for moderate ΔT
-  // See h_shell() for detailed refinement notes
-  const double Pr_ratio = std::pow(1.0, 0.25);
-  
-  const double Nu = C * std::pow(std::max(Re, 1.0), m) * std::pow(Pr, n) * Pr_ratio;
-  return Nu * cold_.k / De_eff;
+  // Kern: Zhukauskas tube-bank correlation on the effective diameter.
+  return shellCoefficient(g_, bellDelaware_, shellMethod_, cold_, m_dot_cold, Rf_shell, k_deposit);
 }
 
 double Thermo::U(double m_dot_hot, double m_dot_cold, double Rf_shell, double Rf_tube, double k_deposit) const {
-  // Tube side is HOT fluid
-  const double ht = std::max(h_tube(m_dot_hot), 1.0);
-  
   // Shell side is COLD fluid
   // Use fouling-aware shell-side coefficient if fouling is present
   const double hs = (Rf_shell > 1e-9) ? std::max(h_shell_with_fouling(m_dot_cold, Rf_shell, k_deposit), 1.0) 
                                        : std::max(h_shell(m_dot_cold), 1.0);
-  
-  // Cylindrical wall resistance: R_wall = ln(Do/Di) / (2*pi*k_wall*L*N_tubes)
-  // Per unit outer area: R_wall = ln(Do/Di) * Do / (2*k_wall)
-  // CORRECTED FORMULA: Removed erroneous division by Di
-  // Note: wall_thickness is implicitly used via Do and Di (Do = Di + 2*wall_thickness)
-  const double Rw = std::log(g_.Do / std::max(g_.Di, 1e-9)) * g_.Do / (2.0 * std::max(g_.wall_k, 1e-9));
-  
-  // Standard series resistance network (no empirical correction factor)
-  // 1/U = 1/h_shell + R_wall + (1/h_tube)*(Di/Do) + Rf_shell + Rf_tube
-  const double invU = (1.0 / hs) + Rw + (1.0 / ht) * (g_.Di / g_.Do) + Rf_shell + Rf_tube;
-  
-  return 1.0 / std::max(invU, 1e-9);
+  return U_withShell(m_dot_hot, hs, Rf_shell, Rf_tube);
 }
 
-namespace {
-
-// ε for counter-flow (Kays & London, Table 11-2).
-double eps_counter(double NTU, double Cr) {
-  if (std::abs(1.0 - Cr) < 1e-12) return NTU / (1.0 + NTU);
-  const double e = std::exp(-NTU * (1.0 - Cr));
-  return (1.0 - e) / (1.0 - Cr * e);
-}
-
-// ε for parallel-flow.
-double eps_parallel(double NTU, double Cr) {
-  return (1.0 - std::exp(-NTU * (1.0 + Cr))) / (1.0 + Cr);
-}
-
-// ε for 1-shell-pass, 2-tube-pass heat exchanger.
-double eps_shellTube_1_2(double NTU, double Cr) {
-  const double s = std::sqrt(1.0 + Cr * Cr);
-  const double e = std::exp(-NTU * s);
-  const double bracket = (1.0 + Cr) + s * (1.0 + e) / (1.0 - e);
-  return 2.0 / std::max(bracket, 1e-12);
-}
-
-// ε for n-shell-pass, 2n-tube-pass (via Kays–London recursion on ε₁).
-double eps_shellTube_nShells(int n, double NTU, double Cr) {
-  const double eps1 = eps_shellTube_1_2(NTU / n, Cr);
-  if (std::abs(1.0 - Cr) < 1e-12) {
-    return n * eps1 / (1.0 + (n - 1) * eps1);
-  }
-  const double ratio = (1.0 - eps1 * Cr) / std::max(1.0 - eps1, 1e-12);
-  const double E = std::pow(ratio, n);
-  return (E - 1.0) / std::max(E - Cr, 1e-12);
+double Thermo::U_withShell(double m_dot_hot, double h_s, double Rf_shell, double Rf_tube) const {
+  // Tube side is HOT fluid
+  return U_fromCoefficients(h_tube(m_dot_hot), h_s, Rf_shell, Rf_tube);
 }
 
-double effectiveness(FlowArrangement a, double NTU, double Cr) {
-  switch (a) {
-    case FlowArrangement::ParallelFlow:   return eps_parallel(NTU, Cr);
-    case FlowArrangement::ShellTube_1_2:  return eps_shellTube_1_2(NTU, Cr);
-    case FlowArrangement::ShellTube_2_4:  return eps_shellTube_nShells(2, NTU, Cr);
-    case FlowArrangement::CounterFlow:
-    default:                               return eps_counter(NTU, Cr);
-  }
+double Thermo::U_fromCoefficients(double h_t, double h_s, double Rf_shell, double Rf_tube) const {
+  // Standard series resistance network (no empirical correction factor)
+  // 1/U = 1/h_shell + R_wall + (1/h_tube)*(Di/Do) + Rf_shell + Rf_tube
+  return overallCoefficient(g_, Rw_, h_t, h_s, Rf_shell, Rf_tube);
 }
 
-}  // namespace
-
 double Thermo::lmtdCorrectionF(FlowArrangement arrangement, double R, double P) {
   // Counter/parallel idealisations have F ≡ 1 by convention.
   if (arrangement == FlowArrangement::CounterFlow ||
@@ -243,27 +127,14 @@ State Thermo::steady(const OperatingPoint &op, double Rf_shell, double Rf_tube,
   const double Uo = U(op.m_dot_hot, op.m_dot_cold, Rf_shell, Rf_tube, k_deposit);
   const double A = g_.areaOuter();
 
-  // Heat capacity rates
+  // Heat capacity rates; NTU and effectiveness for the requested arrangement
   const double Ch = op.m_dot_hot * hot_.cp;
   const double Cc = op.m_dot_cold * cold_.cp;
-  const double Cmin = std::min(Ch, Cc);
-  const double Cmax = std::max(Ch, Cc);
-  const double Cr = Cmin / std::max(Cmax, 1e-12);
-
-  // NTU and effectiveness for the requested arrangement
-  const double NTU = (Uo * A) / std::max(Cmin, 1e-12);
-  const double eps = effectiveness(arrangement, NTU, Cr);
-
-  const double Th_in = op.Tin_hot;
-  const double Tc_in = op.Tin_cold;
-  const double Q = eps * Cmin * (Th_in - Tc_in);
-
-  const double Tc_out = Tc_in + Q / std::max(Cc, 1e-12);
-  const double Th_out = Th_in - Q / std::max(Ch, 1e-12);
+  const SteadyOutlets<double> o = epsNtuOutlets(arrangement, Uo * A, Ch, Cc, op.Tin_hot, op.Tin_cold);
 
-  s.Tc_out = Tc_out;
-  s.Th_out = Th_out;
-  s.Q = Q;
+  s.Tc_out = o.Tc_out;
+  s.Th_out = o.Th_out;
+  s.Q = o.Q;
   s.U = Uo;
   s.Rf = Rf_shell + Rf_tube;
   s.dP_tube = 0.0;  // filled by Hydraulics component in integration
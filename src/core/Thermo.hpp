@@ -1,5 +1,6 @@
 #pragma once
 
+#include "BellDelaware.hpp"
 #include "Types.hpp"
 
 namespace hx {
@@ -43,6 +44,22 @@ public:
    */
   [[nodiscard]] double U(double m_dot_hot, double m_dot_cold, double Rf_shell, double Rf_tube, double k_deposit) const;
 
+  /** Overall U for an already evaluated shell-side coefficient \p h_s (same network as U()). */
+  [[nodiscard]] double U_withShell(double m_dot_hot, double h_s, double Rf_shell, double Rf_tube) const;
+
+  /** Overall U from both film coefficients: only the series network of U(). */
+  [[nodiscard]] double U_fromCoefficients(double h_t, double h_s, double Rf_shell, double Rf_tube) const;
+
+  /** Wall conduction resistance per unit outer area [m²K/W] (geometry only). */
+  [[nodiscard]] double wallResistance() const { return Rw_; }
+
+  /** Bell–Delaware shell side at the current cold-fluid properties: h_s and
+   *  ΔP_s from one evaluation of the precomputed geometry (whatever the
+   *  selected shell method). */
+  [[nodiscard]] BellDelawareResult bellDelawareShell(double m_dot_cold, double Rf_shell, double k_deposit) const {
+    return bellDelaware_.evaluate(cold_, m_dot_cold, Rf_shell, k_deposit);
+  }
+
   /** Steady-state mapping from inlets and flows to outlets and heat duty via ε–NTU.
    *  \param arrangement Selects counter/parallel/shell-&-tube effectiveness formula.
    */
@@ -76,6 +93,8 @@ private:
   Fluid hot_;
   Fluid cold_;
   ShellSideMethod shellMethod_ = ShellSideMethod::Kern;
+  BellDelawarePrecomputed bellDelaware_;   // geometry terms, built once
+  double Rw_ = 0.0;                        // wall resistance, from g_ at construction
 };
 
 } // namespace hx
@@ -0,0 +1,430 @@
+#include "TraceRecorder.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace hx {
+
+// -----------------------------------------------------------------------------
+//  Spill file: append-only writes, read back through one read-only mapping of
+//  the whole file that is re-established when a read reaches past it.  The
+//  file is scratch space — it is deleted when closed (or, on POSIX, unlinked
+//  straight after creation).
+// -----------------------------------------------------------------------------
+class TraceRecorder::SpillFile {
+public:
+  static std::unique_ptr<SpillFile> open(const std::string &path, std::string &err);
+  ~SpillFile();
+
+  SpillFile(const SpillFile &) = delete;
+  SpillFile &operator=(const SpillFile &) = delete;
+
+  /** Append \p n bytes; sets \p offset to where they landed. */
+  bool append(const void *p, size_t n, size_t &offset, std::string &err);
+  /** Base of a mapping that covers at least [0, end); null on failure. */
+  const char *map(size_t end) const;
+  /** Copy \p n bytes at \p offset into \p dst without a mapping. */
+  bool read(size_t offset, void *dst, size_t n) const;
+  /** Discard the contents (the file stays open for reuse). */
+  void truncate();
+
+private:
+  SpillFile() = default;
+  void unmap() const;
+
+  size_t size_ = 0;
+  mutable const char *base_ = nullptr;
+  mutable size_t mapped_ = 0;
+#ifdef _WIN32
+  HANDLE file_ = INVALID_HANDLE_VALUE;
+  mutable HANDLE mapping_ = nullptr;
+#else
+  int fd_ = -1;
+#endif
+};
+
+#ifdef _WIN32
+
+std::unique_ptr<TraceRecorder::SpillFile> TraceRecorder::SpillFile::open(const std::string &path,
+                                                                         std::string &err) {
+  std::unique_ptr<SpillFile> f(new SpillFile());
+  f->file_ = CreateFileW(std::filesystem::path(path).wstring().c_str(), GENERIC_READ | GENERIC_WRITE,
+                         0, nullptr, CREATE_ALWAYS,
+                         FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+  if (f->file_ == INVALID_HANDLE_VALUE) {
+    err = "cannot create spill file " + path + " (error " + std::to_string(GetLastError()) + ")";
+    return nullptr;
+  }
+  return f;
+}
+
+TraceRecorder::SpillFile::~SpillFile() {
+  unmap();
+  if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+}
+
+void TraceRecorder::SpillFile::unmap() const {
+  if (base_) UnmapViewOfFile(base_);
+  if (mapping_) CloseHandle(mapping_);
+  base_ = nullptr;
+  mapping_ = nullptr;
+  mapped_ = 0;
+}
+
+bool TraceRecorder::SpillFile::append(const void *p, size_t n, size_t &offset, std::string &err) {
+  offset = size_;
+  const char *src = static_cast<const char *>(p);
+  size_t done = 0;
+  while (done < n) {
+    OVERLAPPED ov{};
+    const unsigned long long at = size_ + done;
+    ov.Offset = static_cast<DWORD>(at & 0xFFFFFFFFull);
+    ov.OffsetHigh = static_cast<DWORD>(at >> 32);
+    const DWORD want = static_cast<DWORD>(std::min<size_t>(n - done, 1u << 30));
+    DWORD wrote = 0;
+    if (!WriteFile(file_, src + done, want, &wrote, &ov) || wrote == 0) {
+      err = "spill write failed (error " + std::to_string(GetLastError()) + ")";
+      return false;
+    }
+    done += wrote;
+  }
+  size_ += n;
+  return true;
+}
+
+const char *TraceRecorder::SpillFile::map(size_t end) const {
+  if (end <= mapped_) return base_;
+  unmap();
+  mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping_) return nullptr;
+  base_ = static_cast<const char *>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+  if (!base_) {
+    unmap();
+    return nullptr;
+  }
+  mapped_ = size_;
+  return base_;
+}
+
+bool TraceRecorder::SpillFile::read(size_t offset, void *dst, size_t n) const {
+  char *out = static_cast<char *>(dst);
+  size_t done = 0;
+  while (done < n) {
+    OVERLAPPED ov{};
+    const unsigned long long at = offset + done;
+    ov.Offset = static_cast<DWORD>(at & 0xFFFFFFFFull);
+    ov.OffsetHigh = static_cast<DWORD>(at >> 32);
+    const DWORD want = static_cast<DWORD>(std::min<size_t>(n - done, 1u << 30));
+    DWORD got = 0;
+    if (!ReadFile(file_, out + done, want, &got, &ov) || got == 0) return false;
+    done += got;
+  }
+  return true;
+}
+
+void TraceRecorder::SpillFile::truncate() {
+  unmap();
+  LARGE_INTEGER zero{};
+  SetFilePointerEx(file_, zero, nullptr, FILE_BEGIN);
+  SetEndOfFile(file_);
+  size_ = 0;
+}
+
+#else
+
+std::unique_ptr<TraceRecorder::SpillFile> TraceRecorder::SpillFile::open(const std::string &path,
+                                                                         std::string &err) {
+  std::unique_ptr<SpillFile> f(new SpillFile());
+  f->fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (f->fd_ < 0) {
+    err = "cannot create spill file " + path + ": " + std::strerror(errno);
+    return nullptr;
+  }
+  ::unlink(path.c_str());
+  return f;
+}
+
+TraceRecorder::SpillFile::~SpillFile() {
+  unmap();
+  if (fd_ >= 0) ::close(fd_);
+}
+
+void TraceRecorder::SpillFile::unmap() const {
+  if (base_) ::munmap(const_cast<char *>(base_), mapped_);
+  base_ = nullptr;
+  mapped_ = 0;
+}
+
+bool TraceRecorder::SpillFile::append(const void *p, size_t n, size_t &offset, std::string &err) {
+  offset = size_;
+  const char *src = static_cast<const char *>(p);
+  size_t done = 0;
+  while (done < n) {
+    const ssize_t wrote = ::pwrite(fd_, src + done, n - done, static_cast<off_t>(size_ + done));
+    if (wrote < 0 && errno == EINTR) continue;
+    if (wrote <= 0) {
+      err = std::string("spill write failed: ") + std::strerror(errno);
+      return false;
+    }
+    done += static_cast<size_t>(wrote);
+  }
+  size_ += n;
+  return true;
+}
+
+const char *TraceRecorder::SpillFile::map(size_t end) const {
+  if (end <= mapped_) return base_;
+  unmap();
+  void *p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+  if (p == MAP_FAILED) return nullptr;
+  base_ = static_cast<const char *>(p);
+  mapped_ = size_;
+  return base_;
+}
+
+bool TraceRecorder::SpillFile::read(size_t offset, void *dst, size_t n) const {
+  char *out = static_cast<char *>(dst);
+  size_t done = 0;
+  while (done < n) {
+    const ssize_t got = ::pread(fd_, out + done, n - done, static_cast<off_t>(offset + done));
+    if (got < 0 && errno == EINTR) continue;
+    if (got <= 0) return false;
+    done += static_cast<size_t>(got);
+  }
+  return true;
+}
+
+void TraceRecorder::SpillFile::truncate() {
+  unmap();
+  if (::ftruncate(fd_, 0) != 0) {
+    // Nothing to recover: the old bytes are simply overwritten.
+  }
+  size_ = 0;
+}
+
+#endif
+
+namespace {
+
+std::string defaultSpillPath() {
+  static std::atomic<unsigned> serial{0};
+  std::error_code ec;
+  std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+  if (ec) dir = ".";
+  const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+  return (dir / ("heatxtwin-trace-" + std::to_string(stamp) + "-" +
+                 std::to_string(serial.fetch_add(1)) + ".bin"))
+      .string();
+}
+
+} // anonymous namespace
+
+// -----------------------------------------------------------------------------
+//  TraceRecorder
+// -----------------------------------------------------------------------------
+TraceRecorder::TraceRecorder(TraceRecorderConfig cfg) : cfg_(std::move(cfg)) {
+  cfg_.chunkSamples = std::max<size_t>(cfg_.chunkSamples, 64);
+  profileStride_ = std::max<size_t>(cfg_.profileStride, 1);
+}
+
+TraceRecorder::~TraceRecorder() = default;
+
+void TraceRecorder::clear() {
+  chunks_.clear();
+  size_ = 0;
+  residentChunks_ = 0;
+  spilledChunks_ = 0;
+  lastT_ = 0.0;
+  last_ = State{};
+  if (spill_) spill_->truncate();
+  spillError_.clear();
+  readBackChunk_ = static_cast<size_t>(-1);
+
+  profileStride_ = std::max<size_t>(cfg_.profileStride, 1);
+  profileOffered_ = 0;
+  profileCells_ = 0;
+  profileT_.clear();
+  profileData_.clear();
+}
+
+void TraceRecorder::append(double t, const State &s) {
+  const size_t n = cfg_.chunkSamples;
+  const size_t j = size_ % n;
+  if (j == 0) {
+    Chunk c;
+    // Reuse the buffer of a chunk that has just been spilled, if any.
+    c.data = std::move(spare_);
+    if (!c.data) c.data.reset(new double[n * (kChannels + 1)]);
+    chunks_.push_back(std::move(c));
+    ++residentChunks_;
+    if (residentChunks_ * chunkBytes() > cfg_.ramBudgetBytes) spillOldest();
+  }
+
+  double *col = chunks_.back().data.get();
+  col[j] = t;
+  col += n;
+  col[0 * n + j] = s.Tc_out;
+  col[1 * n + j] = s.Th_out;
+  col[2 * n + j] = s.Q;
+  col[3 * n + j] = s.U;
+  col[4 * n + j] = s.Rf;
+  col[5 * n + j] = s.dP_tube;
+  col[6 * n + j] = s.dP_shell;
+  col[7 * n + j] = s.pidSetpoint;
+  col[8 * n + j] = s.pidColdFlow;
+  col[9 * n + j] = s.pidFFterm;
+  col[10 * n + j] = s.pidFBterm;
+  col[11 * n + j] = s.pidColdFlowActual;
+
+  ++size_;
+  lastT_ = t;
+  last_ = s;
+}
+
+void TraceRecorder::unpack(const double *chunk, size_t j, State &s) const {
+  const size_t n = cfg_.chunkSamples;
+  const double *col = chunk + n;
+  s.Tc_out = col[0 * n + j];
+  s.Th_out = col[1 * n + j];
+  s.Q = col[2 * n + j];
+  s.U = col[3 * n + j];
+  s.Rf = col[4 * n + j];
+  s.dP_tube = col[5 * n + j];
+  s.dP_shell = col[6 * n + j];
+  s.pidSetpoint = col[7 * n + j];
+  s.pidColdFlow = col[8 * n + j];
+  s.pidFFterm = col[9 * n + j];
+  s.pidFBterm = col[10 * n + j];
+  s.pidColdFlowActual = col[11 * n + j];
+}
+
+void TraceRecorder::spillOldest() {
+  // Every chunk but the one being filled is complete and may go to disk.
+  while (residentChunks_ * chunkBytes() > cfg_.ramBudgetBytes &&
+         spilledChunks_ + 1 < chunks_.size()) {
+    // After a failure everything from here on stays resident.
+    if (!spillError_.empty()) return;
+    if (!spill_) {
+      spill_ = SpillFile::open(cfg_.spillPath.empty() ? defaultSpillPath() : cfg_.spillPath,
+                               spillError_);
+      if (!spill_) return;
+    }
+    Chunk &c = chunks_[spilledChunks_];
+    if (!spill_->append(c.data.get(), chunkBytes(), c.fileOffset, spillError_)) return;
+    if (!spare_) spare_ = std::move(c.data);
+    c.data.reset();
+    ++spilledChunks_;
+    --residentChunks_;
+  }
+}
+
+const double *TraceRecorder::chunkData(size_t k) const {
+  const Chunk &c = chunks_[k];
+  if (c.data) return c.data.get();
+  if (const char *base = spill_->map(c.fileOffset + chunkBytes())) {
+    return reinterpret_cast<const double *>(base + c.fileOffset);
+  }
+
+  // No mapping (address space or handle exhausted): read the chunk back into
+  // a scratch buffer and stop spilling.  If even the read fails the samples
+  // come back as NaN rather than from a dangling pointer.
+  if (spillError_.empty()) spillError_ = "cannot map the spill file; spilled chunks are read back instead";
+  if (readBackChunk_ != k) {
+    const size_t n = chunkBytes() / sizeof(double);
+    if (!readBack_) readBack_.reset(new double[n]);
+    if (spill_->read(c.fileOffset, readBack_.get(), chunkBytes())) {
+      readBackChunk_ = k;
+    } else {
+      std::fill(readBack_.get(), readBack_.get() + n, std::numeric_limits<double>::quiet_NaN());
+      readBackChunk_ = static_cast<size_t>(-1);
+      spillError_ = "cannot map or read the spill file";
+    }
+  }
+  return readBack_.get();
+}
+
+double TraceRecorder::time(size_t i) const {
+  const size_t n = cfg_.chunkSamples;
+  return chunkData(i / n)[i % n];
+}
+
+double TraceRecorder::value(TraceChannel c, size_t i) const {
+  const size_t n = cfg_.chunkSamples;
+  return chunkData(i / n)[(static_cast<size_t>(c) + 1) * n + i % n];
+}
+
+State TraceRecorder::state(size_t i) const {
+  State s{};
+  unpack(chunkData(i / cfg_.chunkSamples), i % cfg_.chunkSamples, s);
+  return s;
+}
+
+// --- Axial profiles ----------------------------------------------------------
+
+void TraceRecorder::appendProfile(double t, ProfileView Th, ProfileView Tc) {
+  if (Th.empty() || Tc.size() != Th.size()) return;
+  if (Th.size() != profileCells_) {
+    // New discretisation: the store only holds profiles of one size.
+    profileT_.clear();
+    profileData_.clear();
+    profileCells_ = Th.size();
+    profileOffered_ = 0;
+    profileStride_ = std::max<size_t>(cfg_.profileStride, 1);
+  }
+  if (profileOffered_++ % profileStride_ != 0) return;
+
+  profileT_.push_back(t);
+  profileData_.insert(profileData_.end(), Th.begin(), Th.end());
+  profileData_.insert(profileData_.end(), Tc.begin(), Tc.end());
+  if ((profileT_.size() + profileData_.size()) * sizeof(double) > cfg_.profileBudgetBytes) {
+    thinProfiles();
+  }
+}
+
+void TraceRecorder::thinProfiles() {
+  // Keep profiles 0, 2, 4, … — exactly the ones on the doubled stride.
+  const size_t w = 2 * profileCells_;
+  size_t kept = 0;
+  for (size_t k = 0; k < profileT_.size(); k += 2, ++kept) {
+    profileT_[kept] = profileT_[k];
+    std::copy_n(profileData_.begin() + static_cast<std::ptrdiff_t>(k * w), w,
+                profileData_.begin() + static_cast<std::ptrdiff_t>(kept * w));
+  }
+  profileT_.resize(kept);
+  profileData_.resize(kept * w);
+  profileStride_ *= 2;
+}
+
+ProfileView TraceRecorder::profileTh(size_t k) const {
+  return {profileData_.data() + k * 2 * profileCells_, profileCells_};
+}
+
+ProfileView TraceRecorder::profileTc(size_t k) const {
+  return {profileData_.data() + (k * 2 + 1) * profileCells_, profileCells_};
+}
+
+size_t TraceRecorder::residentBytes() const {
+  return (residentChunks_ + (spare_ ? 1 : 0)) * chunkBytes() +
+         (profileT_.capacity() + profileData_.capacity()) * sizeof(double);
+}
+
+} // namespace hx
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Types.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hx {
+
+/** \brief Scalar channels of State kept by TraceRecorder (column order of a chunk after t). */
+enum class TraceChannel : int {
+  Tc_out = 0,
+  Th_out,
+  Q,
+  U,
+  Rf,
+  dP_tube,
+  dP_shell,
+  pidSetpoint,
+  pidColdFlow,
+  pidFFterm,
+  pidFBterm,
+  pidColdFlowActual,
+  Count
+};
+
+/** \brief Sizing of a TraceRecorder. */
+struct TraceRecorderConfig {
+  size_t chunkSamples = 4096;              // samples per chunk (each channel one contiguous column)
+  size_t ramBudgetBytes = 64u << 20;       // resident chunk bytes before the oldest spill to disk
+  std::string spillPath;                   // spill file; empty = a fresh file in the temp directory
+  size_t profileBudgetBytes = 16u << 20;   // axial profile store; its stride doubles when exceeded
+  size_t profileStride = 1;                // keep every Nth profile offered to appendProfile()
+};
+
+/**
+ * \brief Columnar, chunked recording of a simulation run with a disk spill.
+ *
+ *  Samples are packed into fixed-size chunks, one contiguous column per
+ *  channel (time first, then the TraceChannel order), i.e. 13 doubles per
+ *  sample and no per-sample allocation.  Once the resident chunks exceed
+ *  \c ramBudgetBytes the oldest complete chunks are written to a spill file
+ *  and released; they are read back through a read-only memory mapping of
+ *  that file, so a week-long run keeps a flat resident footprint while
+ *  every sample stays addressable.  If the spill file cannot be created the
+ *  recorder keeps everything in RAM and reports it through spillError().
+ *
+ *  Axial profiles are optional and live in a separate store: each kept
+ *  profile is Th and Tc back to back.  Whenever that store outgrows
+ *  \c profileBudgetBytes every other profile is discarded and the stride
+ *  doubles, so its size stays bounded too, at a coarser time resolution.
+ *
+ *  Export and archiving stream with forEach(), chunk by chunk.
+ *  Not thread-safe; record and read from one thread.
+ */
+class TraceRecorder {
+public:
+  static constexpr size_t kChannels = static_cast<size_t>(TraceChannel::Count);
+
+  explicit TraceRecorder(TraceRecorderConfig cfg = {});
+  ~TraceRecorder();
+
+  TraceRecorder(const TraceRecorder &) = delete;
+  TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+  /** Drop every sample and profile; the spill file is truncated and reused. */
+  void clear();
+
+  /** Record one sample (profiles are recorded separately; see appendProfile()). */
+  void append(double t, const State &s);
+
+  [[nodiscard]] size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  [[nodiscard]] double time(size_t i) const;
+  [[nodiscard]] double value(TraceChannel c, size_t i) const;
+  /** Sample \p i as a State. */
+  [[nodiscard]] State state(size_t i) const;
+  /** Most recent sample; size() must be non-zero. */
+  [[nodiscard]] double lastTime() const { return lastT_; }
+  [[nodiscard]] const State &lastState() const { return last_; }
+
+  /**
+   * \brief Stream samples [first, last) to \p fn(double t, const State &s) in order.
+   *  Each chunk is fetched once (resident or mapped), so this is a sequential
+   *  scan however much of the run has been spilled.
+   */
+  template <class F>
+  void forEach(F &&fn, size_t first = 0, size_t last = static_cast<size_t>(-1)) const {
+    last = last < size_ ? last : size_;
+    State s{};
+    for (size_t i = first; i < last;) {
+      const size_t k = i / cfg_.chunkSamples;
+      const double *chunk = chunkData(k);
+      const size_t end = (k + 1) * cfg_.chunkSamples < last ? (k + 1) * cfg_.chunkSamples : last;
+      for (; i < end; ++i) {
+        const size_t j = i % cfg_.chunkSamples;
+        unpack(chunk, j, s);
+        fn(chunk[j], static_cast<const State &>(s));
+      }
+    }
+  }
+
+  // --- Axial profiles ------------------------------------------------------------
+  /** Offer one axial profile; kept if it falls on the current stride. */
+  void appendProfile(double t, ProfileView Th, ProfileView Tc);
+  [[nodiscard]] size_t profileCount() const { return profileT_.size(); }
+  [[nodiscard]] size_t profileStride() const { return profileStride_; }
+  [[nodiscard]] double profileTime(size_t k) const { return profileT_[k]; }
+  /** Views into the store; valid until the next appendProfile() / clear(). */
+  [[nodiscard]] ProfileView profileTh(size_t k) const;
+  [[nodiscard]] ProfileView profileTc(size_t k) const;
+
+  // --- Memory accounting ---------------------------------------------------------
+  [[nodiscard]] size_t residentBytes() const;
+  [[nodiscard]] size_t spilledBytes() const { return spilledChunks_ * chunkBytes(); }
+  [[nodiscard]] size_t spilledChunks() const { return spilledChunks_; }
+  /** Empty unless spilling or mapping the spill file failed (the recorder then stays in RAM). */
+  [[nodiscard]] const std::string &spillError() const { return spillError_; }
+
+private:
+  class SpillFile;
+
+  struct Chunk {
+    std::unique_ptr<double[]> data;  // resident columns, or null once spilled
+    size_t fileOffset = 0;           // byte offset in the spill file when spilled
+  };
+
+  [[nodiscard]] size_t chunkBytes() const { return cfg_.chunkSamples * (kChannels + 1) * sizeof(double); }
+  [[nodiscard]] const double *chunkData(size_t k) const;
+  void unpack(const double *chunk, size_t j, State &s) const;
+  void spillOldest();
+  void thinProfiles();
+
+  TraceRecorderConfig cfg_;
+  std::vector<Chunk> chunks_;
+  std::unique_ptr<double[]> spare_;  // buffer of the last spilled chunk, reused for the next
+  size_t size_ = 0;
+  size_t residentChunks_ = 0;
+  size_t spilledChunks_ = 0;  // chunks_[0, spilledChunks_) live in the spill file
+  double lastT_ = 0.0;
+  State last_{};
+
+  std::unique_ptr<SpillFile> spill_;
+  mutable std::string spillError_;   // also set by a read that cannot map the file
+
+  // Spilled chunk copied back when the file cannot be mapped.
+  mutable std::unique_ptr<double[]> readBack_;
+  mutable size_t readBackChunk_ = static_cast<size_t>(-1);
+
+  // --- Profile store -------------------------------------------------------------
+  size_t profileStride_ = 1;
+  size_t profileOffered_ = 0;
+  size_t profileCells_ = 0;
+  std::vector<double> profileT_;
+  std::vector<double> profileData_;  // per kept profile: Th[0..n), Tc[0..n)
+};
+
+} // namespace hx
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <vector>
@@ -29,6 +30,32 @@ enum class ShellSideMethod : int {
   BellDelaware = 1,
 };
 
+/** \brief Time integrator for the finite-volume axial model.
+ *  ExplicitSubstep is the legacy forward-Euler scheme with CFL sub-stepping
+ *  (cost grows with flow rate and cell count).  BackwardEuler and
+ *  CrankNicolson solve the coupled hot/cold cell system once per macro step
+ *  with a 2×2 block-tridiagonal solver and are stable for any dt; backward
+ *  Euler is L-stable (no ringing on stiff steps), Crank–Nicolson is
+ *  second-order accurate in time.
+ */
+enum class AxialIntegrator : int {
+  ExplicitSubstep = 0,
+  BackwardEuler   = 1,
+  CrankNicolson   = 2,
+};
+
+/** \brief Time integrator for the lumped (two-ODE) model.
+ *  ExplicitEuler is the legacy fixed-step scheme at SimConfig::dt.
+ *  DormandPrince45 is an embedded 5(4) Runge–Kutta pair with rtol/atol error
+ *  control and 4th-order dense output: it picks its own internal step (large
+ *  through quiet periods, small around disturbance steps) and interpolates
+ *  the outlet temperatures onto the caller's dt grid.
+ */
+enum class LumpedIntegrator : int {
+  ExplicitEuler   = 0,
+  DormandPrince45 = 1,
+};
+
 struct Fluid {
   double rho; // density [kg/m^3]
   double mu;  // dynamic viscosity [Pa*s]
@@ -80,6 +107,26 @@ struct Limits {
   double m_dot_cold_max;
 };
 
+/** \brief Read-only, non-owning view of a contiguous run of doubles.
+ *
+ *  Stand-in for C++20 std::span<const double>.  Copying a view never
+ *  allocates; the viewed storage belongs to whoever produced it.
+ */
+struct ProfileView {
+  const double *ptr = nullptr;
+  size_t        len = 0;
+
+  ProfileView() = default;
+  ProfileView(const double *p, size_t n) : ptr(p), len(n) {}
+  explicit ProfileView(const std::vector<double> &v) : ptr(v.data()), len(v.size()) {}
+
+  [[nodiscard]] size_t size() const { return len; }
+  [[nodiscard]] bool   empty() const { return len == 0; }
+  const double &operator[](size_t i) const { return ptr[i]; }
+  [[nodiscard]] const double *begin() const { return ptr; }
+  [[nodiscard]] const double *end() const { return ptr + len; }
+};
+
 struct State {
   double Tc_out;    // [C]
   double Th_out;    // [C]
@@ -100,13 +147,6 @@ struct State {
   double pidFFterm         = std::numeric_limits<double>::quiet_NaN();
   double pidFBterm         = std::numeric_limits<double>::quiet_NaN();
   double pidColdFlowActual = std::numeric_limits<double>::quiet_NaN();
-
-  // Axial temperature profile (finite-volume discretization).
-  // Both vectors share cell indexing 0..N-1 where x=0 is the HOT inlet side
-  // and x=L is the HOT outlet side (i.e. the flow direction of the hot fluid).
-  // Empty when the simulator runs in lumped mode (numAxialCells <= 1).
-  std::vector<double> Th_axial;   // hot-side temperature at each cell [C]
-  std::vector<double> Tc_axial;   // cold-side temperature at each cell [C]
 };
 
 } // namespace hx
@@ -1,6 +1,8 @@
 #include "Config.hpp"
 
+#include <filesystem>
 #include <fstream>
+#include <memory>
 #include <stdexcept>
 
 #include <toml++/toml.h>
@@ -12,6 +14,55 @@ static hx::FoulingParams::Model parseModel(const std::string &s) {
   return hx::FoulingParams::Model::Linear;
 }
 
+static hx::FlowArrangement parseArrangement(const std::string &s) {
+  if (s == "ParallelFlow")  return hx::FlowArrangement::ParallelFlow;
+  if (s == "ShellTube_1_2") return hx::FlowArrangement::ShellTube_1_2;
+  if (s == "ShellTube_2_4") return hx::FlowArrangement::ShellTube_2_4;
+  return hx::FlowArrangement::CounterFlow;
+}
+
+static hx::ShellSideMethod parseShellMethod(const std::string &s) {
+  if (s == "BellDelaware") return hx::ShellSideMethod::BellDelaware;
+  return hx::ShellSideMethod::Kern;
+}
+
+static hx::AxialIntegrator parseIntegrator(const std::string &s) {
+  if (s == "BackwardEuler") return hx::AxialIntegrator::BackwardEuler;
+  if (s == "CrankNicolson") return hx::AxialIntegrator::CrankNicolson;
+  return hx::AxialIntegrator::ExplicitSubstep;
+}
+
+static hx::LumpedIntegrator parseLumpedIntegrator(const std::string &s) {
+  if (s == "DormandPrince45") return hx::LumpedIntegrator::DormandPrince45;
+  return hx::LumpedIntegrator::ExplicitEuler;
+}
+
+static std::shared_ptr<const hx::FluidPropertyTable> loadTable(const std::string &configPath,
+                                                               const std::string &file) {
+  if (file.empty()) return nullptr;
+  std::filesystem::path p(file);
+  if (p.is_relative()) p = std::filesystem::path(configPath).parent_path() / p;
+  hx::FluidTableLoadResult r = hx::loadFluidTableCsv(p.string());
+  if (!r.ok) throw std::runtime_error(r.message);
+  return std::make_shared<const hx::FluidPropertyTable>(std::move(r.table));
+}
+
+static hx::SimConfig::DisturbanceType parseDisturbance(const std::string &s) {
+  if (s == "None")       return hx::SimConfig::DisturbanceType::None;
+  if (s == "StepChange") return hx::SimConfig::DisturbanceType::StepChange;
+  if (s == "Ramp")       return hx::SimConfig::DisturbanceType::Ramp;
+  return hx::SimConfig::DisturbanceType::SineWave;
+}
+
+static hx::FluidPreset parsePreset(const std::string &s) {
+  if (s == "Water")            return hx::FluidPreset::Water;
+  if (s == "EthyleneGlycol30") return hx::FluidPreset::EthyleneGlycol30;
+  if (s == "EthyleneGlycol50") return hx::FluidPreset::EthyleneGlycol50;
+  if (s == "EngineOilSAE30")   return hx::FluidPreset::EngineOilSAE30;
+  if (s == "AirSTP")           return hx::FluidPreset::AirSTP;
+  return hx::FluidPreset::Custom;
+}
+
 AppConfig Config::fromToml(const std::string &path) {
   auto tbl = toml::parse_file(path);
 
@@ -53,6 +104,8 @@ AppConfig Config::fromToml(const std::string &path) {
   c.fouling.tau = f["tau"].value_or(2e6);
   c.fouling.alpha = f["alpha"].value_or(0.0);
   c.fouling.model = parseModel(f["model"].value_or(std::string("Asymptotic")));
+  c.fouling.k_deposit = f["k_deposit"].value_or(0.5);
+  c.fouling.split_ratio = f["split_ratio"].value_or(0.5);
 
   const auto &lim = *tbl["limits"].as_table();
   c.limits.dP_tube_max = lim["dP_tube_max"].value_or(1e5);
@@ -60,6 +113,36 @@ AppConfig Config::fromToml(const std::string &path) {
   c.limits.m_dot_cold_min = lim["m_dot_cold_min"].value_or(0.1);
   c.limits.m_dot_cold_max = lim["m_dot_cold_max"].value_or(5.0);
 
+  // [simulation] is optional: older configs only describe the plant.
+  c.sim.dt = 0.1;
+  c.sim.tEnd = 3600.0;
+  c.sim.Mh = 10.0;
+  c.sim.Mc = 12.0;
+  if (const auto *sim = tbl["simulation"].as_table()) {
+    const auto &s = *sim;
+    c.sim.dt = s["dt"].value_or(c.sim.dt);
+    c.sim.tEnd = s["tEnd"].value_or(c.sim.tEnd);
+    c.sim.Mh = s["Mh"].value_or(c.sim.Mh);
+    c.sim.Mc = s["Mc"].value_or(c.sim.Mc);
+    c.sim.numAxialCells = (int)s["numAxialCells"].value_or(c.sim.numAxialCells);
+    c.sim.arrangement = parseArrangement(s["arrangement"].value_or(std::string("CounterFlow")));
+    c.sim.shellMethod = parseShellMethod(s["shellMethod"].value_or(std::string("Kern")));
+    c.sim.axialIntegrator = parseIntegrator(s["axialIntegrator"].value_or(std::string("ExplicitSubstep")));
+    c.sim.lumpedIntegrator = parseLumpedIntegrator(s["lumpedIntegrator"].value_or(std::string("ExplicitEuler")));
+    c.sim.rtol = s["rtol"].value_or(c.sim.rtol);
+    c.sim.atol = s["atol"].value_or(c.sim.atol);
+    c.sim.disturbanceType = parseDisturbance(s["disturbance"].value_or(std::string("SineWave")));
+    c.sim.hotPreset = parsePreset(s["hotPreset"].value_or(std::string("Custom")));
+    c.sim.coldPreset = parsePreset(s["coldPreset"].value_or(std::string("Custom")));
+    c.sim.tabulatedFluids = s["tabulatedFluids"].value_or(c.sim.tabulatedFluids);
+    // User fluid tables (CSV), resolved relative to the config file.
+    c.sim.hotTable  = loadTable(path, s["hotTable"].value_or(std::string()));
+    c.sim.coldTable = loadTable(path, s["coldTable"].value_or(std::string()));
+  }
+  c.sim.limits = c.limits;
+  c.sim.hotCustom = c.hot;
+  c.sim.coldCustom = c.cold;
+
   return c;
 }
 
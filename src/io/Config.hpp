@@ -2,6 +2,7 @@
 
 #include <string>
 
+#include "core/Simulator.hpp"
 #include "core/Types.hpp"
 
 namespace io {
@@ -13,6 +14,10 @@ struct AppConfig {
   hx::OperatingPoint op;
   hx::FoulingParams fouling;
   hx::Limits limits;
+
+  // Optional [simulation] table.  Defaults mirror the GUI start-up values so a
+  // config without the table behaves exactly like a fresh MainWindow run.
+  hx::SimConfig sim{};
 };
 
 class Config {